@@ -159,7 +159,18 @@ enum DcoHeurStrategy {
 
 enum DcoHeurType {
   DcoHeurTypeNotSet = -1,
-  DcoHeurTypeRounding
+  DcoHeurTypeRounding,
+  DcoHeurTypeFeasibilityPump,
+  DcoHeurTypeDivingFractional,
+  DcoHeurTypeDivingPseudocost,
+  DcoHeurTypeDivingVectorLength,
+  DcoHeurTypeDivingGuided,
+  DcoHeurTypeRins,
+  DcoHeurTypeRens,
+  DcoHeurTypeConicRepair,
+  DcoHeurTypeCrossover,
+  DcoHeurTypeLocalBranching,
+  DcoHeurTypeStartSolution
 };
 
 enum DcoHotStartStrategy{
@@ -188,7 +199,8 @@ enum DcoBranchingObjectType {
   DcoBranchingObjectTypeNone = 0,
   DcoBranchingObjectTypeInt,
   DcoBranchingObjectTypeSos,
-  DcoBranchingObjectTypeBilevel
+  DcoBranchingObjectTypeBilevel,
+  DcoBranchingObjectTypeDisjunction
 };
 
 /** Node branch direction, is it a left node or right */
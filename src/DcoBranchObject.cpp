@@ -5,6 +5,8 @@ DcoBranchObject::DcoBranchObject(int index, double score, double value)
   : BcpsBranchObject(DcoBranchingObjectTypeInt, index, score, value) {
   ubDownBranch_ = floor(value);
   lbUpBranch_ = ceil(value);
+  downEstimate_ = 0.0;
+  upEstimate_ = 0.0;
 }
 
 /// Copy constructor.
@@ -12,6 +14,8 @@ DcoBranchObject::DcoBranchObject(DcoBranchObject const & other)
   : BcpsBranchObject(other) {
   ubDownBranch_ = other.ubDownBranch();
   lbUpBranch_ = other.lbUpBranch();
+  downEstimate_ = other.downEstimate();
+  upEstimate_ = other.upEstimate();
 }
 
 /// Helpful Copy constructor.
@@ -25,6 +29,8 @@ DcoBranchObject::DcoBranchObject(BcpsBranchObject const * other)
   }
   ubDownBranch_ = dco_other->ubDownBranch();
   lbUpBranch_ = dco_other->lbUpBranch();
+  downEstimate_ = dco_other->downEstimate();
+  upEstimate_ = dco_other->upEstimate();
 }
 
 /// Copy assignment operator
@@ -32,6 +38,8 @@ DcoBranchObject & DcoBranchObject::operator=(DcoBranchObject const & rhs) {
   BcpsBranchObject::operator=(rhs);
   ubDownBranch_ = rhs.ubDownBranch();
   lbUpBranch_ = rhs.lbUpBranch();
+  downEstimate_ = rhs.downEstimate();
+  upEstimate_ = rhs.upEstimate();
   return *this;
 }
 
@@ -113,6 +121,8 @@ AlpsReturnStatus DcoBranchObject::encode(AlpsEncoded * encoded) const {
   assert(status==AlpsReturnStatusOk);
   encoded->writeRep(ubDownBranch_);
   encoded->writeRep(lbUpBranch_);
+  encoded->writeRep(downEstimate_);
+  encoded->writeRep(upEstimate_);
   return status;
 }
 
@@ -143,5 +153,7 @@ AlpsReturnStatus DcoBranchObject::decodeToSelf(AlpsEncoded & encoded) {
   // decode fields of DcoBranchObject
   encoded.readRep(ubDownBranch_);
   encoded.readRep(lbUpBranch_);
+  encoded.readRep(downEstimate_);
+  encoded.readRep(upEstimate_);
   return status;
 }
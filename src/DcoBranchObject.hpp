@@ -12,7 +12,11 @@
   DcoBranchObject represents a branch object for a simple branch on an
   integral variable.
 
-  Has two fields, ubDownBranch_ and lbUpBranch_.
+  Has two fields, ubDownBranch_ and lbUpBranch_. It also carries the
+  estimated objective change of the down and up branches (downEstimate_ and
+  upEstimate_). These are set by branching strategies that keep branching
+  history (pseudocost) and are used to estimate the solution values
+  of the children. They are 0.0 when no estimate is available.
 
  */
 
@@ -21,6 +25,10 @@ class DcoBranchObject: virtual public BcpsBranchObject {
   double ubDownBranch_;
   /// lower bound of the up branch
   double lbUpBranch_;
+  /// estimated objective change in the down branch
+  double downEstimate_;
+  /// estimated objective change in the up branch
+  double upEstimate_;
 public:
   ///@name Constructor and Destructors.
   //@{
@@ -59,6 +67,19 @@ public:
   double lbUpBranch() const { return lbUpBranch_; }
   //@}
 
+  ///@name Child estimates
+  //@{
+  /// Get estimated objective change of the down branch.
+  double downEstimate() const { return downEstimate_; }
+  /// Get estimated objective change of the up branch.
+  double upEstimate() const { return upEstimate_; }
+  /// Set estimated objective changes of the down and up branches.
+  void setEstimates(double down, double up) {
+    downEstimate_ = down;
+    upEstimate_ = up;
+  }
+  //@}
+
   ///@name Encode and Decode functions
   ///@{
   using AlpsKnowledge::encode;
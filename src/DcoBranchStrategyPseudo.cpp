@@ -4,6 +4,14 @@
 #include "DcoTreeNode.hpp"
 #include "DcoBranchObject.hpp"
 
+// CoinUtils headers
+#include <CoinHelperFunctions.hpp>
+
+// STL headers
+#include <fstream>
+#include <sstream>
+#include <limits>
+
 DcoBranchStrategyPseudo::DcoBranchStrategyPseudo(DcoModel * model):
   BcpsBranchStrategy(model) {
   setType(DcoBranchingStrategyPseudoCost);
@@ -15,10 +23,14 @@ DcoBranchStrategyPseudo::DcoBranchStrategyPseudo(DcoModel * model):
   down_derivative_ = new double[num_relaxed]();
   up_derivative_ = new double[num_relaxed]();
   // fill reverse map
+  int num_cols = model->getNumCoreVariables();
+  rev_relaxed_ = new int[num_cols];
+  CoinFillN(rev_relaxed_, num_cols, -1);
   int const * relaxed_cols = model->relaxedCols();
   for (int i=0; i<num_relaxed; ++i) {
     rev_relaxed_[relaxed_cols[i]] = i;
   }
+  frac_ = new double[num_relaxed];
 }
 
 DcoBranchStrategyPseudo::~DcoBranchStrategyPseudo() {
@@ -38,6 +50,14 @@ DcoBranchStrategyPseudo::~DcoBranchStrategyPseudo() {
     delete[] up_derivative_;
     up_derivative_ = NULL;
   }
+  if (rev_relaxed_) {
+    delete[] rev_relaxed_;
+    rev_relaxed_ = NULL;
+  }
+  if (frac_) {
+    delete[] frac_;
+    frac_ = NULL;
+  }
 }
 
 int DcoBranchStrategyPseudo::createCandBranchObjects(BcpsTreeNode * node) {
@@ -54,41 +74,65 @@ int DcoBranchStrategyPseudo::createCandBranchObjects(BcpsTreeNode * node) {
   int num_relaxed = dco_model->numRelaxedCols();
   // get indices of relaxed object
   int const * relaxed = dco_model->relaxedCols();
-  // store branch objects in bobjects
-  std::vector<BcpsBranchObject*> bobjects;
-  // iterate over relaxed columns and populate bobjects
+  // compute fractionality of all relaxed columns
+  double const * sol = dco_model->solver()->getColSolution();
+  dco_model->fractionality(sol, frac_);
+  // averages are used for variables not branched on yet
+  double ave_down;
+  double ave_up;
+  average_derivatives(ave_down, ave_up);
+  // sum of estimated objective changes, used for the solution estimate
+  double sum_change = 0.0;
+  // best candidate so far, position in relaxed columns array
+  int best = -1;
+  double best_score = 0.0;
+  double best_down_change = 0.0;
+  double best_up_change = 0.0;
+  // iterate over relaxed columns and score fractional ones
   for (int i=0; i<num_relaxed; ++i) {
-    int preferredDir;
-    BcpsObject * curr_object = dco_model->getVariables()[relaxed[i]];
-    double infeasibility = curr_object->infeasibility(dco_model, preferredDir);
     // check the amount of infeasibility
-    if (infeasibility != 0.0) {
-      double min = std::min(down_derivative_[i], up_derivative_[i]);
-      double max = std::max(down_derivative_[i], up_derivative_[i]);
-      // compute score
-      double score = score_factor_*max + (1.0-score_factor_)*min;
-      // create a branch object for this
-      BcpsBranchObject * cb =
-        curr_object->createBranchObject(dco_model, preferredDir);
-      // set score
-      cb->setScore(score);
-      bobjects.push_back(cb);
-
-      // debug stuff
-      message_handler->message(DISCO_PSEUDO_REPORT, *messages)
-        << dco_model->broker()->getProcRank()
-        << relaxed[i]
-        << score
-        << CoinMessageEol;
+    if (frac_[i] == 0.0) {
+      continue;
     }
+    double min = std::min(down_derivative_[i], up_derivative_[i]);
+    double max = std::max(down_derivative_[i], up_derivative_[i]);
+    // compute score
+    double score = score_factor_*max + (1.0-score_factor_)*min;
+    // estimate objective change of the children
+    double value = sol[relaxed[i]];
+    double down_deriv = down_num_[i] ? down_derivative_[i] : ave_down;
+    double up_deriv = up_num_[i] ? up_derivative_[i] : ave_up;
+    double down_change = std::max(0.0, down_deriv*(value-floor(value)));
+    double up_change = std::max(0.0, up_deriv*(ceil(value)-value));
+    sum_change += std::min(down_change, up_change);
+    // keep the first one in case of ties, as betterBranchObject() does.
+    if (best==-1 or score>best_score) {
+      best = i;
+      best_score = score;
+      best_down_change = down_change;
+      best_up_change = up_change;
+    }
+
+    // debug stuff
+    message_handler->message(DISCO_PSEUDO_REPORT, *messages)
+      << dco_model->broker()->getProcRank()
+      << relaxed[i]
+      << score
+      << CoinMessageEol;
+  }
+  // update solution estimate of the node
+  dco_node->setSolEstimate(dco_node->getQuality() + sum_change);
+  if (best==-1) {
+    return 0;
   }
-  // add branch objects to branchObjects_
-  setBranchObjects(bobjects);
-  // bobjects are now owned by BcpsBranchStrategy, do not free them.
-  bobjects.clear();
+  // create branch object of the best candidate only, it is owned by the node.
+  BcpsObject * best_object = dco_model->getVariables()[relaxed[best]];
+  BcpsBranchObject * cb = best_object->createBranchObject(dco_model, 0);
+  cb->setScore(best_score);
+  dynamic_cast<DcoBranchObject*>(cb)->setEstimates(best_down_change,
+                                                   best_up_change);
   // set the branch object member of the node
-  dco_node->setBranchObject(new DcoBranchObject(bestBranchObject()));
-  // compare branch objects and keep the best one at bestBranchObject_
+  dco_node->setBranchObject(cb);
   return 0;
 }
 
@@ -109,11 +153,53 @@ DcoBranchStrategyPseudo::betterBranchObject(BcpsBranchObject const * current,
   return res;
 }
 
+void DcoBranchStrategyPseudo::pseudocosts(double * down, double * up) {
+  DcoModel * dco_model = dynamic_cast<DcoModel*>(model());
+  int num_relaxed = dco_model->numRelaxedCols();
+  double ave_down;
+  double ave_up;
+  average_derivatives(ave_down, ave_up);
+  for (int i=0; i<num_relaxed; ++i) {
+    down[i] = down_num_[i] ? down_derivative_[i] : ave_down;
+    up[i] = up_num_[i] ? up_derivative_[i] : ave_up;
+  }
+}
+
+void DcoBranchStrategyPseudo::average_derivatives(double & down,
+                                                  double & up) const {
+  DcoModel * dco_model = dynamic_cast<DcoModel*>(model());
+  int num_relaxed = dco_model->numRelaxedCols();
+  int num_down = 0;
+  int num_up = 0;
+  down = 0.0;
+  up = 0.0;
+  for (int i=0; i<num_relaxed; ++i) {
+    if (down_num_[i]) {
+      down += down_derivative_[i];
+      num_down++;
+    }
+    if (up_num_[i]) {
+      up += up_derivative_[i];
+      num_up++;
+    }
+  }
+  if (num_down) {
+    down = down/num_down;
+  }
+  if (num_up) {
+    up = up/num_up;
+  }
+}
+
 void DcoBranchStrategyPseudo::update_statistics(DcoTreeNode * node) {
   // return if this is the root node
   if (node->getParent()==NULL) {
     return;
   }
+  // return if the parent did not branch on a variable
+  if (node->getDesc()->getBranchedInd()<0) {
+    return;
+  }
   // get dco model and message stuff
   DcoModel * dco_model = dynamic_cast<DcoModel*>(model());
   CoinMessageHandler * message_handler = dco_model->dcoMessageHandler_;
@@ -170,3 +256,126 @@ void DcoBranchStrategyPseudo::update_statistics(DcoTreeNode * node) {
       << CoinMessageEol;
   }
 }
+
+int DcoBranchStrategyPseudo::readHistory(char const * file_name,
+                                         double decay) {
+  std::ifstream in(file_name);
+  if (!in.is_open()) {
+    return -1;
+  }
+  DcoModel * dco_model = dynamic_cast<DcoModel*>(model());
+  std::vector<std::string> const & names = dco_model->colNames();
+  if (names.empty()) {
+    return 0;
+  }
+  // map names of relaxed columns to their position in relaxed array
+  std::map<std::string, int> name_map;
+  int num_relaxed = dco_model->numRelaxedCols();
+  int const * relaxed_cols = dco_model->relaxedCols();
+  for (int i=0; i<num_relaxed; ++i) {
+    name_map[names[relaxed_cols[i]]] = i;
+  }
+  int num_matched = 0;
+  std::string line;
+  while (std::getline(in, line)) {
+    // skip comments and empty lines
+    if (line.empty() or line[0]=='#') {
+      continue;
+    }
+    std::istringstream ls(line);
+    std::string name;
+    int down_num, up_num;
+    double down_deriv, up_deriv;
+    if (!(ls >> name >> down_num >> down_deriv >> up_num >> up_deriv)) {
+      continue;
+    }
+    std::map<std::string, int>::const_iterator it = name_map.find(name);
+    if (it==name_map.end()) {
+      continue;
+    }
+    int i = it->second;
+    // keep at least one observation if there is any, decay only reduces the
+    // weight of the history against the new observations.
+    if (down_num>0 and decay>0.0) {
+      down_num_[i] = std::max(1, static_cast<int>(decay*down_num + 0.5));
+      down_derivative_[i] = down_deriv;
+    }
+    if (up_num>0 and decay>0.0) {
+      up_num_[i] = std::max(1, static_cast<int>(decay*up_num + 0.5));
+      up_derivative_[i] = up_deriv;
+    }
+    num_matched++;
+  }
+  in.close();
+  return num_matched;
+}
+
+int DcoBranchStrategyPseudo::writeHistory(char const * file_name) {
+  DcoModel * dco_model = dynamic_cast<DcoModel*>(model());
+  std::vector<std::string> const & names = dco_model->colNames();
+  std::ofstream out(file_name);
+  if (!out.is_open()) {
+    return -1;
+  }
+  out.precision(std::numeric_limits<double>::digits10+2);
+  out << "# name down_num down_derivative up_num up_derivative" << std::endl;
+  int num_written = 0;
+  int num_relaxed = dco_model->numRelaxedCols();
+  int const * relaxed_cols = dco_model->relaxedCols();
+  for (int i=0; i<num_relaxed; ++i) {
+    if (down_num_[i]==0 and up_num_[i]==0) {
+      continue;
+    }
+    if (names.empty()) {
+      out << "C" << relaxed_cols[i];
+    }
+    else {
+      out << names[relaxed_cols[i]];
+    }
+    out << " " << down_num_[i]
+        << " " << down_derivative_[i]
+        << " " << up_num_[i]
+        << " " << up_derivative_[i]
+        << std::endl;
+    num_written++;
+  }
+  out.close();
+  return num_written;
+}
+
+void DcoBranchStrategyPseudo::encodeHistory(AlpsEncoded * encoded) const {
+  DcoModel * dco_model = dynamic_cast<DcoModel*>(model());
+  int num_relaxed = dco_model->numRelaxedCols();
+  encoded->writeRep(num_relaxed);
+  encoded->writeRep(down_num_, num_relaxed);
+  encoded->writeRep(down_derivative_, num_relaxed);
+  encoded->writeRep(up_num_, num_relaxed);
+  encoded->writeRep(up_derivative_, num_relaxed);
+}
+
+bool DcoBranchStrategyPseudo::decodeHistory(AlpsEncoded & encoded) {
+  DcoModel * dco_model = dynamic_cast<DcoModel*>(model());
+  int num_relaxed;
+  encoded.readRep(num_relaxed);
+  int * down_num = NULL;
+  double * down_deriv = NULL;
+  int * up_num = NULL;
+  double * up_deriv = NULL;
+  int size;
+  encoded.readRep(down_num, size);
+  encoded.readRep(down_deriv, size);
+  encoded.readRep(up_num, size);
+  encoded.readRep(up_deriv, size);
+  bool valid = num_relaxed==dco_model->numRelaxedCols();
+  if (valid) {
+    std::copy(down_num, down_num+num_relaxed, down_num_);
+    std::copy(down_deriv, down_deriv+num_relaxed, down_derivative_);
+    std::copy(up_num, up_num+num_relaxed, up_num_);
+    std::copy(up_deriv, up_deriv+num_relaxed, up_derivative_);
+  }
+  delete[] down_num;
+  delete[] down_deriv;
+  delete[] up_num;
+  delete[] up_deriv;
+  return valid;
+}
@@ -2,6 +2,7 @@
 #define DcoBranchStrategyPseudo_hpp_
 
 #include <BcpsBranchStrategy.h>
+#include <AlpsEncoded.h>
 
 #include <map>
 
@@ -47,6 +48,39 @@ class DcoTreeNode;
   // a tighter estimate of the problem. If it leads a tighter estimate with the
   // help of cuts let it be.
 
+  # Candidates
+
+  Fractionality of all relaxed columns is computed in a single pass with
+  DcoModel::fractionality() into a buffer that is reused at every node.
+  Candidates are scored from this buffer and only the branch object of the
+  best candidate is created and given to the node. Branch objects of the
+  other candidates are not stored, numBranchObjects() is 0 for this
+  strategy.
+
+  # Child estimates
+
+  For every candidate we estimate the objective change in the down and up
+  branches as \f$ \varphi _j ^- f_j ^- \f$ and \f$ \varphi _j ^+ f_j ^+
+  \f$. If a variable is not branched in a direction yet, the average of the
+  observed \f$ \varphi \f$ values in that direction is used. The estimates of
+  the chosen variable are stored in the branch object. The solution estimate
+  of the node is
+
+  \f[ quality + \sum _j min(\varphi _j ^- f_j ^-, \varphi _j ^+ f_j ^+), \f]
+
+  where the sum is over all fractional variables. DcoTreeNode::branch() uses
+  these to estimate solution values of the children. Estimates are not valid
+  bounds, children get the quality of the parent.
+
+  # Branching history
+
+  Statistics can be written to a file at the end of a run and read back at
+  the beginning of the next one (see DcoParams::branchHistoryFile). Each line
+  of the file has a column name followed by the number of down observations,
+  down derivative, number of up observations and up derivative. Columns are
+  matched by name, so the file can be used for a different instance of the
+  same model. Number of observations read are scaled with a decay weight,
+  derivatives read are kept as they are.
 
  */
 
@@ -64,10 +98,20 @@ class DcoBranchStrategyPseudo: virtual public BcpsBranchStrategy {
   double * down_derivative_;
   double * up_derivative_;
   /// reverse map of relaxed columns, rev_relaxed_[index] gives the index of
-  /// the varaible in relaxed columns array.
-  std::map<int,int> rev_relaxed_;
+  /// the varaible in relaxed columns array, -1 if the variable is not
+  /// relaxed. Size is number of columns.
+  int * rev_relaxed_;
+  //@}
+  ///@name Candidate buffer
+  //@{
+  /// fractionality of relaxed columns at the current node, see
+  /// DcoModel::fractionality(). Allocated once and reused at every node.
+  double * frac_;
+  //@}
   /// update scores of the stored branch objects.
   void update_statistics(DcoTreeNode * node);
+  /// compute average of the observed derivatives in both directions.
+  void average_derivatives(double & down, double & up) const;
 public:
   DcoBranchStrategyPseudo(DcoModel * model);
   virtual ~DcoBranchStrategyPseudo();
@@ -75,6 +119,27 @@ public:
   /// Compare current to other, return 1 if current is better, 0 otherwise
   virtual int betterBranchObject(BcpsBranchObject const * current,
                                  BcpsBranchObject const * other);
+  ///@name Branching history
+  //@{
+  /// Read statistics from the given file. Number of observations are
+  /// multiplied with decay. Returns the number of columns matched, -1 if the
+  /// file can not be opened.
+  int readHistory(char const * file_name, double decay);
+  /// Write statistics of the columns with at least one observation to the
+  /// given file. Returns the number of columns written, -1 if the file can
+  /// not be opened.
+  int writeHistory(char const * file_name);
+  /// Write statistics of all relaxed columns to encoded, used by checkpoints
+  /// (see DcoCheckpoint).
+  void encodeHistory(AlpsEncoded * encoded) const;
+  /// Read statistics written by encodeHistory(). Returns false if they are
+  /// written for a different number of relaxed columns.
+  bool decodeHistory(AlpsEncoded & encoded);
+  /// Fill pseudocosts of relaxed columns, down[i] and up[i] are the
+  /// pseudocosts of column relaxedCols()[i]. Averages are used for the
+  /// directions with no observations. Used by pseudocost diving.
+  void pseudocosts(double * down, double * up);
+  //@}
 private:
   /// Disable default constructor.
   DcoBranchStrategyPseudo();
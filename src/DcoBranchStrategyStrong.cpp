@@ -19,50 +19,52 @@ void DcoBranchStrategyStrong::updateScore(BcpsBranchObject * bobject,
   // CoinMessageHandler * message_handler = dco_model->dcoMessageHandler_;
   // CoinMessages * messages = dco_model->dcoMessages_;
   DcoBranchObject * dco_bobject = dynamic_cast<DcoBranchObject*>(bobject);
+  // LP used to evaluate candidates, see DcoModel::lpSolver().
+  OsiSolverInterface * lp_solver = dco_model->lpSolver();
   // solve subproblem for the down branch
-  dco_model->solver()->setColUpper(bobject->index(), dco_bobject->ubDownBranch());
-  dco_model->solver()->solveFromHotStart();
+  lp_solver->setColUpper(bobject->index(), dco_bobject->ubDownBranch());
+  lp_solver->solveFromHotStart();
   //double down_obj = 0.5*ALPS_INFINITY;
   double down_obj = 1.0;
-  // std::cout << "abandoned " << dco_model->solver()->isAbandoned()<< std::endl;
-  // std::cout << "optimal " << dco_model->solver()->isProvenOptimal()<< std::endl;
-  // std::cout << "primal inf" << dco_model->solver()->isProvenPrimalInfeasible()<< std::endl;
-  // std::cout << "dual inf" << dco_model->solver()->isProvenDualInfeasible()<< std::endl;
-  // std::cout << "primal obj limit" << dco_model->solver()->isPrimalObjectiveLimitReached()<< std::endl;
-  // std::cout << "dual obj limit" << dco_model->solver()->isDualObjectiveLimitReached()<< std::endl;
-  // std::cout << "iter limit" << dco_model->solver()->isIterationLimitReached()<< std::endl;
-  if (dco_model->solver()->isProvenOptimal()
-      or dco_model->solver()->isIterationLimitReached()
-      or dco_model->solver()->isDualObjectiveLimitReached()) {
-    down_obj = dco_model->solver()->getObjValue();
+  // std::cout << "abandoned " << lp_solver->isAbandoned()<< std::endl;
+  // std::cout << "optimal " << lp_solver->isProvenOptimal()<< std::endl;
+  // std::cout << "primal inf" << lp_solver->isProvenPrimalInfeasible()<< std::endl;
+  // std::cout << "dual inf" << lp_solver->isProvenDualInfeasible()<< std::endl;
+  // std::cout << "primal obj limit" << lp_solver->isPrimalObjectiveLimitReached()<< std::endl;
+  // std::cout << "dual obj limit" << lp_solver->isDualObjectiveLimitReached()<< std::endl;
+  // std::cout << "iter limit" << lp_solver->isIterationLimitReached()<< std::endl;
+  if (lp_solver->isProvenOptimal()
+      or lp_solver->isIterationLimitReached()
+      or lp_solver->isDualObjectiveLimitReached()) {
+    down_obj = lp_solver->getObjValue();
   }
   else {
     std::cout << "prob not opt." << std::endl;
   }
   // restore bound
-  dco_model->solver()->setColUpper(bobject->index(), orig_ub);
+  lp_solver->setColUpper(bobject->index(), orig_ub);
   // solve subproblem for the up branch
-  dco_model->solver()->setColLower(bobject->index(), dco_bobject->lbUpBranch());
-  dco_model->solver()->solveFromHotStart();
+  lp_solver->setColLower(bobject->index(), dco_bobject->lbUpBranch());
+  lp_solver->solveFromHotStart();
   //double up_obj = 0.5*ALPS_INFINITY;
   double up_obj = 1.0;
-  // std::cout << "abandoned " << dco_model->solver()->isAbandoned()<< std::endl;
-  // std::cout << "optimal " << dco_model->solver()->isProvenOptimal()<< std::endl;
-  // std::cout << "primal inf" << dco_model->solver()->isProvenPrimalInfeasible()<< std::endl;
-  // std::cout << "dual inf" << dco_model->solver()->isProvenDualInfeasible()<< std::endl;
-  // std::cout << "primal obj limit" << dco_model->solver()->isPrimalObjectiveLimitReached()<< std::endl;
-  // std::cout << "dual obj limit" << dco_model->solver()->isDualObjectiveLimitReached()<< std::endl;
-  // std::cout << "iter limit" << dco_model->solver()->isIterationLimitReached()<< std::endl;
-  if (dco_model->solver()->isProvenOptimal()
-      or dco_model->solver()->isIterationLimitReached()
-      or dco_model->solver()->isDualObjectiveLimitReached()) {
-    up_obj = dco_model->solver()->getObjValue();
+  // std::cout << "abandoned " << lp_solver->isAbandoned()<< std::endl;
+  // std::cout << "optimal " << lp_solver->isProvenOptimal()<< std::endl;
+  // std::cout << "primal inf" << lp_solver->isProvenPrimalInfeasible()<< std::endl;
+  // std::cout << "dual inf" << lp_solver->isProvenDualInfeasible()<< std::endl;
+  // std::cout << "primal obj limit" << lp_solver->isPrimalObjectiveLimitReached()<< std::endl;
+  // std::cout << "dual obj limit" << lp_solver->isDualObjectiveLimitReached()<< std::endl;
+  // std::cout << "iter limit" << lp_solver->isIterationLimitReached()<< std::endl;
+  if (lp_solver->isProvenOptimal()
+      or lp_solver->isIterationLimitReached()
+      or lp_solver->isDualObjectiveLimitReached()) {
+    up_obj = lp_solver->getObjValue();
   }
   else {
     std::cout << "prob not opt." << std::endl;
   }
   // restore bound
-  dco_model->solver()->setColLower(bobject->index(), orig_lb);
+  lp_solver->setColLower(bobject->index(), orig_lb);
   // set score
   double down_diff = fabs(orig_obj-down_obj);
   double up_diff = fabs(orig_obj-up_obj);
@@ -126,14 +128,25 @@ int DcoBranchStrategyStrong::createCandBranchObjects(BcpsTreeNode * node) {
   int min_pos = -1;
   double min_score = ALPS_INFINITY;
 
-  dco_model->solver()->markHotStart();
-  dco_model->solver()->setIntParam(OsiMaxNumIterationHotStart, 50);
-
-  double const obj_val = dco_model->solver()->getObjValue();
+  // Candidates are evaluated with an LP. In conic builds this is the OA LP of
+  // the node relaxation, since conic solvers (interior point ones in
+  // particular) can not hot start.
+  dco_model->updateOaSolver();
+  OsiSolverInterface * lp_solver = dco_model->lpSolver();
+  // LP solution, restored after each candidate
+  double * lp_sol = new double[lp_solver->getNumCols()];
+  std::copy(lp_solver->getColSolution(),
+            lp_solver->getColSolution()+lp_solver->getNumCols(),
+            lp_sol);
+
+  lp_solver->markHotStart();
+  lp_solver->setIntParam(OsiMaxNumIterationHotStart, 50);
+
+  double const obj_val = lp_solver->getObjValue();
   //double const * collb = dco_model->colLB();
   //double const * colub = dco_model->colUB();
-  double const * collb = dco_model->solver()->getColLower();
-  double const * colub = dco_model->solver()->getColUpper();
+  double const * collb = lp_solver->getColLower();
+  double const * colub = lp_solver->getColUpper();
 
   // iterate over integer cols, create branch objects, solve corresponding
   // relaxed problems and set scores.
@@ -150,7 +163,7 @@ int DcoBranchStrategyStrong::createCandBranchObjects(BcpsTreeNode * node) {
     updateScore(curr_branch_object, collb[var_index],
                 colub[var_index], obj_val);
     double curr_score = curr_branch_object->score();
-    dco_model->solver()->setColSolution(sol);
+    lp_solver->setColSolution(lp_sol);
 
     // if we have capacity add branch object
     // else check whether current performs better than the worst candidate
@@ -180,11 +193,12 @@ int DcoBranchStrategyStrong::createCandBranchObjects(BcpsTreeNode * node) {
     }
   }
   delete[] sol;
+  delete[] lp_sol;
   if (num_bobjects==0) {
     std::cout << "All columns are feasible." << std::endl;
     throw std::exception();
   }
-  dco_model->solver()->unmarkHotStart();
+  lp_solver->unmarkHotStart();
 
   // debug stuff
   for (int i=0; i<num_bobjects; ++i) {
@@ -13,6 +13,11 @@
 
 /*!
   Implements strong branching.
+
+  Candidates are evaluated with hot starts on DcoModel::lpSolver(). In conic
+  solver builds this is an LP keeping the outer approximation of the node
+  relaxation (see DcoParams::strongBranchOa), the conic solver is used for
+  the node bound only.
 */
 
 class DcoBranchStrategyStrong : virtual public BcpsBranchStrategy {
@@ -0,0 +1,264 @@
+#include <cstdio>
+#include <algorithm>
+#include <fstream>
+#include <string>
+
+#include <CoinMessageHandler.hpp>
+#include <CoinTime.hpp>
+
+#include <AlpsEncoded.h>
+
+#include "DcoCheckpoint.hpp"
+#include "DcoModel.hpp"
+#include "DcoMessage.hpp"
+#include "DcoSolution.hpp"
+#include "DcoTreeNode.hpp"
+#include "DcoNodeDesc.hpp"
+#include "DcoBranchStrategyPseudo.hpp"
+
+// Format version of checkpoint files, increase when the format changes.
+#define DISCO_CHECKPOINT_VERSION 1
+
+DcoCheckpoint::DcoCheckpoint(DcoModel * model) {
+  model_ = model;
+  lastWriteTime_ = CoinWallclockTime();
+}
+
+DcoCheckpoint::~DcoCheckpoint() {
+  for (std::vector<DcoNodeDesc*>::iterator it=restartDescs_.begin();
+       it!=restartDescs_.end(); ++it) {
+    delete *it;
+  }
+  restartDescs_.clear();
+}
+
+void DcoCheckpoint::periodicWrite(DcoTreeNode * active) {
+  double interval = model_->dcoPar()->entry(DcoParams::checkpointInterval);
+  // do not overwrite the checkpoint being restarted from before its nodes
+  // are in the tree.
+  if (interval<=0.0 or !restartDescs_.empty()) {
+    return;
+  }
+  if (model_->broker()->getProcType()!=AlpsProcessTypeSerial) {
+    return;
+  }
+  double now = CoinWallclockTime();
+  if (now-lastWriteTime_ < interval) {
+    return;
+  }
+  lastWriteTime_ = now;
+  write(active);
+}
+
+// Layout: version, instance hash, number of columns, incumbent flag, quality
+// and values, pseudocost flag and statistics, number of nodes, then quality,
+// solution estimate and description of each node.
+bool DcoCheckpoint::write(DcoTreeNode * active) {
+  std::string file_name = model_->dcoPar()->entry(DcoParams::checkpointFile);
+  AlpsKnowledgeBroker * broker = model_->broker();
+  // collect open nodes
+  std::vector<AlpsTreeNode*> nodes;
+  if (active) {
+    nodes.push_back(active);
+  }
+  model_->getPoolNodes(nodes);
+  AlpsEncoded encoded(AlpsKnowledgeTypeModel);
+  int version = DISCO_CHECKPOINT_VERSION;
+  encoded.writeRep(version);
+  encoded.writeRep(model_->instanceHash());
+  int num_cols = model_->getNumCoreVariables();
+  encoded.writeRep(num_cols);
+  // incumbent
+  DcoSolution * sol = NULL;
+  if (broker->hasKnowledge(AlpsKnowledgeTypeSolution)) {
+    sol = dynamic_cast<DcoSolution*>
+      (broker->getBestKnowledge(AlpsKnowledgeTypeSolution).first);
+  }
+  char has_sol = sol ? 1 : 0;
+  encoded.writeRep(has_sol);
+  if (sol) {
+    encoded.writeRep(sol->getQuality());
+    encoded.writeRep(sol->getValues(), num_cols);
+  }
+  // pseudocosts
+  DcoBranchStrategyPseudo * pseudo =
+    dynamic_cast<DcoBranchStrategyPseudo*>(model_->branchStrategy());
+  char has_pseudo = pseudo ? 1 : 0;
+  encoded.writeRep(has_pseudo);
+  if (pseudo) {
+    pseudo->encodeHistory(&encoded);
+  }
+  // open nodes
+  int num_nodes = static_cast<int>(nodes.size());
+  encoded.writeRep(num_nodes);
+  for (int i=0; i<num_nodes; ++i) {
+    DcoNodeDesc * desc =
+      dynamic_cast<DcoTreeNode*>(nodes[i])->createCheckpointDesc();
+    encoded.writeRep(nodes[i]->getQuality());
+    encoded.writeRep(nodes[i]->getSolEstimate());
+    desc->encode(&encoded);
+    delete desc;
+  }
+
+  // write to a temporary file, keep the previous checkpoint until this one
+  // is complete.
+  std::string tmp_name = file_name + ".tmp";
+  std::ofstream out(tmp_name.c_str(), std::ios::binary);
+  bool written = out.is_open();
+  if (written) {
+    int size = encoded.size();
+    out.write(reinterpret_cast<char const *>(&size), sizeof(size));
+    out.write(encoded.data(), size);
+    out.close();
+    written = !out.fail() and
+      std::rename(tmp_name.c_str(), file_name.c_str())==0;
+  }
+  if (!written) {
+    model_->dcoMessageHandler_->message(DISCO_CHECKPOINT_FAILED,
+                                        *model_->dcoMessages_)
+      << file_name.c_str()
+      << CoinMessageEol;
+    return false;
+  }
+  model_->dcoMessageHandler_->message(DISCO_CHECKPOINT_WRITE,
+                                      *model_->dcoMessages_)
+    << num_nodes
+    << file_name.c_str()
+    << CoinMessageEol;
+  return true;
+}
+
+bool DcoCheckpoint::read() {
+  std::string file_name = model_->dcoPar()->entry(DcoParams::checkpointFile);
+  AlpsKnowledgeBroker * broker = model_->broker();
+  // descriptions of the open nodes are relative to the root, the root of a
+  // parallel search is split in ramp-up with full descriptions.
+  if (broker->getProcType()!=AlpsProcessTypeSerial) {
+    model_->dcoMessageHandler_->message(0, "Dco",
+                                        "Restart from a checkpoint is "
+                                        "supported in serial mode only.",
+                                        'G', DISCO_DLOG_MPI)
+      << CoinMessageEol;
+    return false;
+  }
+  std::ifstream in(file_name.c_str(), std::ios::binary);
+  int size = 0;
+  char * buffer = NULL;
+  if (in.is_open()) {
+    in.read(reinterpret_cast<char*>(&size), sizeof(size));
+    if (in and size>0) {
+      buffer = new char[size];
+      in.read(buffer, size);
+      if (!in) {
+        delete[] buffer;
+        buffer = NULL;
+      }
+    }
+    in.close();
+  }
+  if (buffer==NULL) {
+    model_->dcoMessageHandler_->message(DISCO_CHECKPOINT_READ_FAILED,
+                                        *model_->dcoMessages_)
+      << file_name.c_str()
+      << CoinMessageEol;
+    return false;
+  }
+  // buffer is owned by the encoded object.
+  AlpsEncoded encoded(AlpsKnowledgeTypeModel, size, buffer);
+  int version;
+  unsigned long long instance_hash;
+  int num_cols;
+  encoded.readRep(version);
+  encoded.readRep(instance_hash);
+  encoded.readRep(num_cols);
+  if (version!=DISCO_CHECKPOINT_VERSION or
+      instance_hash!=model_->instanceHash() or
+      num_cols!=model_->getNumCoreVariables()) {
+    model_->dcoMessageHandler_->message(DISCO_CHECKPOINT_READ_FAILED,
+                                        *model_->dcoMessages_)
+      << file_name.c_str()
+      << CoinMessageEol;
+    return false;
+  }
+  // incumbent
+  char has_sol;
+  encoded.readRep(has_sol);
+  if (has_sol) {
+    double quality;
+    double * values = NULL;
+    int num_values;
+    encoded.readRep(quality);
+    encoded.readRep(values, num_values);
+    DcoSolution * sol = new DcoSolution(num_cols, values, quality);
+    sol->setBroker(broker);
+    broker->addKnowledge(AlpsKnowledgeTypeSolution, sol,
+                         model_->objSense()*quality);
+    delete[] values;
+  }
+  // pseudocosts
+  char has_pseudo;
+  encoded.readRep(has_pseudo);
+  if (has_pseudo) {
+    DcoBranchStrategyPseudo * pseudo =
+      dynamic_cast<DcoBranchStrategyPseudo*>(model_->branchStrategy());
+    if (pseudo) {
+      pseudo->decodeHistory(encoded);
+    }
+    else {
+      // branching strategy changed, skip statistics.
+      int num_relaxed;
+      int * num = NULL;
+      double * deriv = NULL;
+      int length;
+      encoded.readRep(num_relaxed);
+      for (int k=0; k<2; ++k) {
+        encoded.readRep(num, length);
+        encoded.readRep(deriv, length);
+        delete[] num;
+        delete[] deriv;
+        num = NULL;
+        deriv = NULL;
+      }
+    }
+  }
+  // open nodes
+  int num_nodes;
+  encoded.readRep(num_nodes);
+  for (int i=0; i<num_nodes; ++i) {
+    double quality;
+    double estimate;
+    encoded.readRep(quality);
+    encoded.readRep(estimate);
+    DcoNodeDesc * desc = new DcoNodeDesc(model_);
+    desc->setBroker(broker);
+    if (desc->decodeToSelf(encoded)!=AlpsReturnStatusOk) {
+      model_->dcoMessageHandler_->message(DISCO_UNEXPECTED_DECODE_STATUS,
+                                          *model_->dcoMessages_)
+        << __FILE__ << __LINE__ << CoinMessageEol;
+      delete desc;
+      continue;
+    }
+    desc->setSolEstimate(estimate);
+    restartDescs_.push_back(desc);
+    restartQualities_.push_back(quality);
+  }
+  model_->dcoMessageHandler_->message(DISCO_CHECKPOINT_RESTART,
+                                      *model_->dcoMessages_)
+    << file_name.c_str()
+    << numRestartNodes()
+    << CoinMessageEol;
+  return true;
+}
+
+void DcoCheckpoint::restartNodes(std::vector< CoinTriple<AlpsNodeDesc*,
+                                 AlpsNodeStatus, double> > & children,
+                                 double root_quality) {
+  for (long unsigned int i=0; i<restartDescs_.size(); ++i) {
+    double quality = std::max(restartQualities_[i], root_quality);
+    children.push_back(CoinMakeTriple(
+                         static_cast<AlpsNodeDesc*>(restartDescs_[i]),
+                         AlpsNodeStatusCandidate, quality));
+  }
+  restartDescs_.clear();
+  restartQualities_.clear();
+}
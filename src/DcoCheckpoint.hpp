@@ -0,0 +1,83 @@
+#ifndef DcoCheckpoint_hpp_
+#define DcoCheckpoint_hpp_
+
+#include <vector>
+
+#include <CoinHelperFunctions.hpp>
+#include <Alps.h>
+
+class AlpsNodeDesc;
+class DcoModel;
+class DcoNodeDesc;
+class DcoTreeNode;
+
+/*!
+  Checkpoints of the search, serial builds only.
+
+  Every DcoParams::checkpointInterval seconds of wall clock time the search
+  state is written to DcoParams::checkpointFile. A checkpoint keeps the
+  incumbent, the pseudocosts (DcoBranchStrategyPseudo::encodeHistory()) and
+  the open nodes, the node being processed and the nodes of the node pools
+  of Alps. Nodes are written with DcoNodeDesc::encode(), descriptions are
+  created by DcoTreeNode::createCheckpointDesc() and are relative to the
+  root. They keep the cuts generated in the subtree. DisCO has no global cut
+  pool, cuts valid for the whole tree are the root cuts and they are
+  generated again at restart. The file is written to a temporary file first
+  and renamed, a checkpoint interrupted by pre-emption does not overwrite
+  the previous one.
+
+  When DcoParams::checkpointRestart is set read() is called when the root is
+  created. It installs the incumbent and the pseudocosts. The root is
+  processed as usual and DcoTreeNode::branch() returns the open nodes of the
+  checkpoint as children of the root instead of branching. A checkpoint is
+  accepted only if it is written for the same instance, see
+  DcoModel::computeInstanceHash().
+*/
+
+class DcoCheckpoint {
+  /// Model of this process.
+  DcoModel * model_;
+  /// Wall clock time of the last checkpoint.
+  double lastWriteTime_;
+  /// Open nodes read at restart, not given to the root yet.
+  std::vector<DcoNodeDesc*> restartDescs_;
+  /// Qualities of restartDescs_.
+  std::vector<double> restartQualities_;
+public:
+  ///@name Constructors and Destructor.
+  //@{
+  /// Useful constructor.
+  DcoCheckpoint(DcoModel * model);
+  /// Destructor.
+  virtual ~DcoCheckpoint();
+  //@}
+
+  /// Write a checkpoint if DcoParams::checkpointInterval seconds passed
+  /// since the last one. Active is the node being processed.
+  void periodicWrite(DcoTreeNode * active);
+  /// Write checkpoint, active is the node being processed, it is not in the
+  /// node pool. Returns false if the file can not be written.
+  bool write(DcoTreeNode * active);
+  /// Read checkpoint, install incumbent and pseudocosts and keep open nodes
+  /// for the root. Returns false if the file can not be read or does not
+  /// match the model.
+  bool read();
+  /// Number of open nodes read at restart and not given to the root yet.
+  int numRestartNodes() const {
+    return static_cast<int>(restartDescs_.size());
+  }
+  /// Move open nodes read at restart to children, qualities are at least
+  /// root_quality.
+  void restartNodes(std::vector< CoinTriple<AlpsNodeDesc*, AlpsNodeStatus,
+                    double> > & children, double root_quality);
+
+private:
+  /// Disable default constructor.
+  DcoCheckpoint();
+  /// Disable copy constructor.
+  DcoCheckpoint(DcoCheckpoint const & other);
+  /// Disable copy assignment operator.
+  DcoCheckpoint & operator=(DcoCheckpoint const & rhs);
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include "DcoConicConstraint.hpp"
+#include "DcoEncoding.hpp"
 #include <numeric>
 
 DcoConicConstraint::DcoConicConstraint() {
@@ -158,23 +159,30 @@ int const * DcoConicConstraint::getActiveSupports() const {
 
 /// Encode this to an AlpsEncoded object.
 AlpsReturnStatus DcoConicConstraint::encode(AlpsEncoded * encoded) {
-  std::cerr << "Not implemented, "
-            << "file: " <<  __FILE__
-            << "line: " << __LINE__
-            << std::endl;
-  throw std::exception();
-  return AlpsReturnStatusOk;
+  DcoEncodeTag(encoded, DcoEncodedTagConic);
+  AlpsReturnStatus status = encodeBcpsObject(encoded);
+  int type = static_cast<int>(coneType_);
+  encoded->writeRep(type);
+  encoded->writeRep(coneSize_);
+  // member order matters, leading members come first.
+  DcoEncodeIndices(encoded, coneSize_, members_);
+  encoded->writeRep(numSupports_);
+  for (int i=0; i<numSupports_; ++i) {
+    supports_[i]->encode(encoded);
+  }
+  encoded->writeRep(activeSupports_, numSupports_);
+  return status;
 }
 
 /// Decode a given AlpsEncoded object to an AlpsKnowledge object and return a
 /// pointer to it.
 AlpsKnowledge * DcoConicConstraint::decode(AlpsEncoded & encoded) const {
-  std::cerr << "Not implemented, "
-            << "file: " <<  __FILE__
-            << "line: " << __LINE__
-            << std::endl;
-  throw std::exception();
   DcoConicConstraint * con = new DcoConicConstraint();
+  AlpsReturnStatus status = con->decodeToSelf(encoded);
+  if (status!=AlpsReturnStatusOk) {
+    delete con;
+    return NULL;
+  }
   return con;
 }
 
@@ -182,10 +190,51 @@ AlpsKnowledge * DcoConicConstraint::decode(AlpsEncoded & encoded) const {
 // we can overload this function here due to cv-qualifier.
 /// Decode a given AlpsEncoded object into self.
 AlpsReturnStatus DcoConicConstraint::decodeToSelf(AlpsEncoded & encoded) {
-  std::cerr << "Not implemented, "
-            << "file: " <<  __FILE__
-            << "line: " << __LINE__
-            << std::endl;
-  throw std::exception();
-  return AlpsReturnStatusOk;
+  if (!DcoDecodeTag(encoded, DcoEncodedTagConic)) {
+    return AlpsReturnStatusErr;
+  }
+  AlpsReturnStatus status = decodeBcpsObject(encoded);
+  // free old data
+  if (members_) {
+    delete[] members_;
+    members_ = NULL;
+  }
+  if (supports_) {
+    for (int i=0; i<numSupports_; ++i) {
+      delete supports_[i];
+    }
+    delete[] supports_;
+    supports_ = NULL;
+  }
+  if (activeSupports_) {
+    delete[] activeSupports_;
+    activeSupports_ = NULL;
+  }
+  numSupports_ = 0;
+  int type;
+  encoded.readRep(type);
+  coneType_ = static_cast<DcoLorentzConeType>(type);
+  encoded.readRep(coneSize_);
+  members_ = new int[coneSize_];
+  if (!DcoDecodeIndices(encoded, coneSize_, members_)) {
+    return AlpsReturnStatusErr;
+  }
+  int num_supports;
+  encoded.readRep(num_supports);
+  if (num_supports>0) {
+    supports_ = new DcoLinearConstraint*[num_supports];
+  }
+  for (int i=0; i<num_supports; ++i) {
+    supports_[i] = new DcoLinearConstraint();
+    numSupports_++;
+    if (supports_[i]->decodeToSelf(encoded)!=AlpsReturnStatusOk) {
+      return AlpsReturnStatusErr;
+    }
+  }
+  int num_active;
+  encoded.readRep(activeSupports_, num_active);
+  if (num_active!=numSupports_) {
+    return AlpsReturnStatusErr;
+  }
+  return status;
 }
@@ -0,0 +1,153 @@
+#include "DcoDisjunctionBranchObject.hpp"
+#include "DcoLinearConstraint.hpp"
+#include "DcoMessage.hpp"
+
+DcoDisjunctionBranchObject::DcoDisjunctionBranchObject(int index, int size,
+                                                       int const * indices,
+                                                       double const * values,
+                                                       double score,
+                                                       double value)
+  : BcpsBranchObject(DcoBranchingObjectTypeDisjunction, index, score, value) {
+  size_ = size;
+  indices_ = NULL;
+  values_ = NULL;
+  if (size_) {
+    indices_ = new int[size_];
+    std::copy(indices, indices+size_, indices_);
+    values_ = new double[size_];
+    std::copy(values, values+size_, values_);
+  }
+  rhs_ = floor(value);
+}
+
+/// Copy constructor.
+DcoDisjunctionBranchObject::DcoDisjunctionBranchObject(
+                            DcoDisjunctionBranchObject const & other)
+  : BcpsBranchObject(other) {
+  size_ = other.size();
+  indices_ = NULL;
+  values_ = NULL;
+  if (size_) {
+    indices_ = new int[size_];
+    std::copy(other.indices(), other.indices()+size_, indices_);
+    values_ = new double[size_];
+    std::copy(other.values(), other.values()+size_, values_);
+  }
+  rhs_ = other.rhs();
+}
+
+/// Helpful Copy constructor.
+DcoDisjunctionBranchObject::DcoDisjunctionBranchObject(
+                            BcpsBranchObject const * other)
+  : AlpsKnowledge(other->getType(), other->broker_),
+    BcpsBranchObject(*other) {
+  DcoDisjunctionBranchObject const * dco_other =
+    dynamic_cast<DcoDisjunctionBranchObject const *>(other);
+  if (dco_other==NULL) {
+    std::cerr << "Fatal error!" << std::endl;
+    throw std::exception();
+  }
+  size_ = dco_other->size();
+  indices_ = NULL;
+  values_ = NULL;
+  if (size_) {
+    indices_ = new int[size_];
+    std::copy(dco_other->indices(), dco_other->indices()+size_, indices_);
+    values_ = new double[size_];
+    std::copy(dco_other->values(), dco_other->values()+size_, values_);
+  }
+  rhs_ = dco_other->rhs();
+}
+
+/// Copy assignment operator
+DcoDisjunctionBranchObject &
+DcoDisjunctionBranchObject::operator=(DcoDisjunctionBranchObject const & rhs) {
+  if (this==&rhs) {
+    return *this;
+  }
+  BcpsBranchObject::operator=(rhs);
+  if (indices_) {
+    delete[] indices_;
+    indices_ = NULL;
+  }
+  if (values_) {
+    delete[] values_;
+    values_ = NULL;
+  }
+  size_ = rhs.size();
+  if (size_) {
+    indices_ = new int[size_];
+    std::copy(rhs.indices(), rhs.indices()+size_, indices_);
+    values_ = new double[size_];
+    std::copy(rhs.values(), rhs.values()+size_, values_);
+  }
+  rhs_ = rhs.rhs();
+  return *this;
+}
+
+DcoDisjunctionBranchObject::~DcoDisjunctionBranchObject() {
+  if (indices_) {
+    delete[] indices_;
+    indices_ = NULL;
+  }
+  if (values_) {
+    delete[] values_;
+    values_ = NULL;
+  }
+}
+
+DcoLinearConstraint * DcoDisjunctionBranchObject::createDownRow() const {
+  return new DcoLinearConstraint(size_, indices_, values_, -DISCO_INFINITY,
+                                 rhs_);
+}
+
+DcoLinearConstraint * DcoDisjunctionBranchObject::createUpRow() const {
+  return new DcoLinearConstraint(size_, indices_, values_, rhs_+1.0,
+                                 DISCO_INFINITY);
+}
+
+/// Encode the content of this into the given AlpsEncoded object.
+AlpsReturnStatus
+DcoDisjunctionBranchObject::encode(AlpsEncoded * encoded) const {
+  AlpsReturnStatus status;
+  status = BcpsBranchObject::encode(encoded);
+  assert(status==AlpsReturnStatusOk);
+  encoded->writeRep(indices_, size_);
+  encoded->writeRep(values_, size_);
+  encoded->writeRep(rhs_);
+  return status;
+}
+
+/// Decode the given AlpsEncoded object into a new AlpsKnowledge object and
+/// return a pointer to it.
+AlpsKnowledge *
+DcoDisjunctionBranchObject::decode(AlpsEncoded & encoded) const {
+  AlpsReturnStatus status;
+  AlpsKnowledge * new_bo =
+    new DcoDisjunctionBranchObject(-1, 0, NULL, NULL, 0.0, 0.0);
+  status = new_bo->decodeToSelf(encoded);
+  assert(status==AlpsReturnStatusOk);
+  return new_bo;
+}
+
+/// Decode the given AlpsEncoded object into this.
+AlpsReturnStatus
+DcoDisjunctionBranchObject::decodeToSelf(AlpsEncoded & encoded) {
+  AlpsReturnStatus status;
+  // decode Bcps part.
+  status = BcpsBranchObject::decodeToSelf(encoded);
+  assert(status==AlpsReturnStatusOk);
+  // decode fields of DcoDisjunctionBranchObject
+  if (indices_) {
+    delete[] indices_;
+    indices_ = NULL;
+  }
+  if (values_) {
+    delete[] values_;
+    values_ = NULL;
+  }
+  encoded.readRep(indices_, size_);
+  encoded.readRep(values_, size_);
+  encoded.readRep(rhs_);
+  return status;
+}
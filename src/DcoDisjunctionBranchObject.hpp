@@ -0,0 +1,98 @@
+#ifndef DcoDisjunctionBranchObject_hpp_
+#define DcoDisjunctionBranchObject_hpp_
+
+#include <BcpsBranchObject.h>
+#include "DcoModel.hpp"
+
+class DcoLinearConstraint;
+
+/*!
+  Represents a branch object for a general split disjunction
+
+  \f[ \pi^T x \leq \pi_0 \quad \vee \quad \pi^T x \geq \pi_0 + 1, \f]
+
+  where \f$ \pi \f$ is integral and has nonzero entries for integer variables
+  only.
+
+  # DcoDisjunctionBranchObject
+
+  Down branch adds row \f$ \pi^T x \leq \pi_0 \f$ and up branch adds row
+  \f$ \pi^T x \geq \pi_0 + 1 \f$ to the child nodes. These rows are local to
+  the subtree and are stored in the node descriptions (see DcoNodeDesc).
+
+  index() of this object is the index of the model row \f$ \pi \f$ is taken
+  from, -1 if \f$ \pi \f$ does not correspond to a model row. value() is the
+  value of \f$ \pi^T x \f$ at the current solution.
+
+ */
+
+class DcoDisjunctionBranchObject: virtual public BcpsBranchObject {
+  /// Number of nonzero entries of \f$ \pi \f$.
+  int size_;
+  /// Indices of nonzero entries.
+  int * indices_;
+  /// Values of nonzero entries.
+  double * values_;
+  /// Right hand side of the down branch, \f$ \pi_0 \f$.
+  double rhs_;
+public:
+  ///@name Constructor and Destructors.
+  //@{
+  /// Constructor, rhs is set to floor of value.
+  DcoDisjunctionBranchObject(int index, int size, int const * indices,
+                             double const * values, double score,
+                             double value);
+  /// Copy constructor.
+  DcoDisjunctionBranchObject(DcoDisjunctionBranchObject const & other);
+  /// Helpful Copy constructor.
+  DcoDisjunctionBranchObject(BcpsBranchObject const * other);
+  /// Copy assignment operator
+  DcoDisjunctionBranchObject &
+  operator=(DcoDisjunctionBranchObject const & rhs);
+  /// Destructor.
+  virtual ~DcoDisjunctionBranchObject();
+  //@}
+
+  ///@name Virtual functions inherited from BcpsBranchObject
+  /// The number of branch arms created for this branch object.
+  virtual int numBranches() const { return 2; }
+  /// The number of branch arms left to be evaluated.
+  virtual int numBranchesLeft() const { return 2; }
+  /// Spit out a branch and, update this or superclass fields if necessary.
+  virtual double branch(bool normalBranch = false) { return 0.0; }
+  //@}
+
+  ///@name Querry functions.
+  //@{
+  /// Get number of nonzero entries.
+  int size() const { return size_; }
+  /// Get indices of nonzero entries.
+  int const * indices() const { return indices_; }
+  /// Get values of nonzero entries.
+  double const * values() const { return values_; }
+  /// Get right hand side of the down branch.
+  double rhs() const { return rhs_; }
+  /// Create the row of the down branch. Caller owns the returned object.
+  DcoLinearConstraint * createDownRow() const;
+  /// Create the row of the up branch. Caller owns the returned object.
+  DcoLinearConstraint * createUpRow() const;
+  //@}
+
+  ///@name Encode and Decode functions
+  ///@{
+  using AlpsKnowledge::encode;
+  /// Encode the content of this into the given AlpsEncoded object.
+  virtual AlpsReturnStatus encode(AlpsEncoded * encoded) const;
+  /// Decode the given AlpsEncoded object into a new AlpsKnowledge object and
+  /// return a pointer to it.
+  virtual AlpsKnowledge * decode(AlpsEncoded & encoded) const;
+  /// Decode the given AlpsEncoded object into this.
+  virtual AlpsReturnStatus decodeToSelf(AlpsEncoded & encoded);
+  ///@}
+
+private:
+  /// Disable default constructor.
+  DcoDisjunctionBranchObject();
+};
+
+#endif
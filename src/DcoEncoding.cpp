@@ -0,0 +1,86 @@
+#include <vector>
+
+#include "DcoEncoding.hpp"
+
+void DcoEncodeTag(AlpsEncoded * encoded, DcoEncodedTag tag) {
+  char value = static_cast<char>(tag);
+  encoded->writeRep(value);
+}
+
+bool DcoDecodeTag(AlpsEncoded & encoded, DcoEncodedTag tag) {
+  char value;
+  encoded.readRep(value);
+  return value==static_cast<char>(tag);
+}
+
+void DcoEncodeIndices(AlpsEncoded * encoded, int size, int const * indices) {
+  char sorted = 1;
+  for (int i=1; i<size; ++i) {
+    if (indices[i]<indices[i-1]) {
+      sorted = 0;
+      break;
+    }
+  }
+  std::vector<char> buffer;
+  int prev = 0;
+  for (int i=0; i<size; ++i) {
+    int diff = indices[i] - prev;
+    prev = indices[i];
+    unsigned int value;
+    if (sorted) {
+      value = static_cast<unsigned int>(diff);
+    }
+    else {
+      // zigzag, small negative differences have small codes
+      value = (static_cast<unsigned int>(diff) << 1) ^
+        static_cast<unsigned int>(diff >> 31);
+    }
+    while (value >= 0x80) {
+      buffer.push_back(static_cast<char>((value & 0x7f) | 0x80));
+      value >>= 7;
+    }
+    buffer.push_back(static_cast<char>(value));
+  }
+  encoded->writeRep(sorted);
+  int length = static_cast<int>(buffer.size());
+  char const * data = buffer.empty() ? NULL : &buffer[0];
+  encoded->writeRep(data, length);
+}
+
+bool DcoDecodeIndices(AlpsEncoded & encoded, int size, int * indices) {
+  char sorted;
+  encoded.readRep(sorted);
+  char * buffer = NULL;
+  int length = 0;
+  encoded.readRep(buffer, length);
+  bool valid = true;
+  int pos = 0;
+  int prev = 0;
+  for (int i=0; valid and i<size; ++i) {
+    unsigned int value = 0;
+    for (int shift=0; ; shift+=7) {
+      if (pos>=length or shift>28) {
+        valid = false;
+        break;
+      }
+      unsigned char byte = static_cast<unsigned char>(buffer[pos++]);
+      value |= static_cast<unsigned int>(byte & 0x7f) << shift;
+      if ((byte & 0x80)==0) {
+        break;
+      }
+    }
+    int diff;
+    if (sorted) {
+      diff = static_cast<int>(value);
+    }
+    else {
+      diff = static_cast<int>(value >> 1) ^ -static_cast<int>(value & 1);
+    }
+    prev += diff;
+    indices[i] = prev;
+  }
+  if (buffer) {
+    delete[] buffer;
+  }
+  return valid and pos==length;
+}
@@ -0,0 +1,35 @@
+#ifndef DcoEncoding_hpp_
+#define DcoEncoding_hpp_
+
+#include <AlpsEncoded.h>
+
+/*!
+  Helpers of the compact binary format of DisCO objects (DcoVariable,
+  DcoLinearConstraint, DcoConicConstraint).
+
+  Each object starts with a DcoEncodedTag. Index arrays are written as a
+  varint stream, 7 bits a byte, low bits first, the high bit is set if more
+  bytes follow. Sorted arrays are delta coded, every entry but the first is
+  the difference to the previous one. Unsorted arrays (cone members, the
+  leading members are not the smallest) are delta coded with zigzag mapping
+  of the signed differences. Doubles are written raw.
+*/
+
+/// Type tags of encoded DisCO objects.
+enum DcoEncodedTag {
+  DcoEncodedTagVariable = 'V',
+  DcoEncodedTagLinear = 'L',
+  DcoEncodedTagConic = 'C'
+};
+
+/// Write tag.
+void DcoEncodeTag(AlpsEncoded * encoded, DcoEncodedTag tag);
+/// Read a tag and return true if it is tag.
+bool DcoDecodeTag(AlpsEncoded & encoded, DcoEncodedTag tag);
+/// Write size indices as a delta coded varint stream. Size is not written.
+void DcoEncodeIndices(AlpsEncoded * encoded, int size, int const * indices);
+/// Read size indices written by DcoEncodeIndices() to indices. Returns false
+/// if the stream is corrupt.
+bool DcoDecodeIndices(AlpsEncoded & encoded, int size, int * indices);
+
+#endif
@@ -0,0 +1,159 @@
+#include <cmath>
+#include <vector>
+
+#include <CoinMessageHandler.hpp>
+#include <CoinHelperFunctions.hpp>
+#include <CoinTime.hpp>
+#include <OsiCuts.hpp>
+
+#include "DcoHeurConicRepair.hpp"
+#include "DcoModel.hpp"
+#include "DcoMessage.hpp"
+#include "DcoSolution.hpp"
+
+DcoHeurConicRepair::DcoHeurConicRepair(DcoModel * model, char const * name,
+                                       DcoHeurStrategy strategy,
+                                       int frequency)
+  : DcoHeuristic(model, name, strategy, frequency) {
+  setType(DcoHeurTypeConicRepair);
+  int num_int = model->numIntegerCols();
+  lastFix_ = new double[num_int];
+  CoinFillN(lastFix_, num_int, -COIN_DBL_MAX);
+  isInteger_ = new char[model->getNumCoreVariables()]();
+  for (int i=0; i<num_int; ++i) {
+    isInteger_[model->integerCols()[i]] = 1;
+  }
+  activity_ = NULL;
+}
+
+DcoHeurConicRepair::~DcoHeurConicRepair() {
+  if (lastFix_) {
+    delete[] lastFix_;
+    lastFix_ = NULL;
+  }
+  if (isInteger_) {
+    delete[] isInteger_;
+    isInteger_ = NULL;
+  }
+  if (activity_) {
+    delete activity_;
+    activity_ = NULL;
+  }
+}
+
+bool DcoHeurConicRepair::shouldCall() {
+  if (strategy() == DcoHeurStrategyNone) {
+    // This heuristic has been disabled.
+    return false;
+  }
+  if (model()->numIntegerCols()==0 or
+      model()->getNumCoreConicConstraints()==0) {
+    return false;
+  }
+  if (!model()->solver()->isProvenOptimal()) {
+    return false;
+  }
+  return true;
+}
+
+DcoSolution * DcoHeurConicRepair::searchSolution() {
+  if (!shouldCall()) {
+    return NULL;
+  }
+  double const * sol = model()->solver()->getColSolution();
+  double integer_tol = model()->dcoPar()->entry(DcoParams::integerTol);
+  int num_int = model()->numIntegerCols();
+  int const * int_cols = model()->integerCols();
+  // check whether solution is integer feasible
+  for (int i=0; i<num_int; ++i) {
+    double value = sol[int_cols[i]];
+    if (fabs(value-floor(value+0.5)) > integer_tol) {
+      return NULL;
+    }
+  }
+  // check whether solution violates a cone
+  OsiCuts supports;
+  if (model()->coneSupports(sol, sol, supports)==0) {
+    return NULL;
+  }
+  // do not repair the same integer assignment again
+  bool same = true;
+  for (int i=0; i<num_int; ++i) {
+    double value = floor(sol[int_cols[i]]+0.5);
+    if (value!=lastFix_[i]) {
+      same = false;
+      lastFix_[i] = value;
+    }
+  }
+  if (same) {
+    return NULL;
+  }
+
+  stats().addCalls();
+  double start_time = CoinCpuTime();
+  DcoSolution * dco_sol = repair(sol);
+  if (dco_sol) {
+    stats().addNumSolutions();
+  }
+  else {
+    stats().addNoSolCalls();
+  }
+  stats().addTime(CoinCpuTime()-start_time);
+  model()->dcoMessageHandler_->message(DISCO_HEUR_REPAIR,
+                                       *model()->dcoMessages_)
+    << model()->broker()->getProcRank()
+    << static_cast<int>(dco_sol!=NULL)
+    << CoinMessageEol;
+  return dco_sol;
+}
+
+bool DcoHeurConicRepair::canRepair(double const * point) {
+  if (activity_==NULL) {
+    double primal_tol;
+    model()->solver()->getDblParam(OsiPrimalTolerance, primal_tol);
+    activity_ = new DcoRowActivity(model(), primal_tol);
+  }
+  int num_cols = model()->getNumCoreVariables();
+  int num_int = model()->numIntegerCols();
+  int const * int_cols = model()->integerCols();
+  double const * col_lb = model()->solver()->getColLower();
+  double const * col_ub = model()->solver()->getColUpper();
+  std::vector<double> rounded(point, point+num_cols);
+  for (int i=0; i<num_int; ++i) {
+    int col = int_cols[i];
+    rounded[col] = CoinMax(col_lb[col],
+                           CoinMin(col_ub[col], floor(point[col]+0.5)));
+  }
+  activity_->reset(&rounded[0]);
+  CoinPackedMatrix const * matrix = activity_->byRow();
+  for (int k=0; k<activity_->numViolated(); ++k) {
+    CoinShallowPackedVector row = matrix->getVector(activity_->violated()[k]);
+    int const * indices = row.getIndices();
+    bool has_free = false;
+    for (int j=0; j<row.getNumElements(); ++j) {
+      int col = indices[j];
+      if (!isInteger_[col] and col_lb[col]<col_ub[col]) {
+        has_free = true;
+        break;
+      }
+    }
+    if (!has_free) {
+      return false;
+    }
+  }
+  return true;
+}
+
+DcoSolution * DcoHeurConicRepair::repair(double const * point) {
+  if (!canRepair(point)) {
+    return NULL;
+  }
+#if defined(__OA__)
+  OsiSolverInterface * solver = model()->cloneSolver();
+#else
+  OsiConicSolverInterface * solver = model()->cloneSolver();
+#endif
+  DcoSolution * dco_sol = model()->repairSolution(solver, point);
+  delete solver;
+  return dco_sol;
+}
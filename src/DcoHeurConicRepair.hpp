@@ -0,0 +1,67 @@
+#ifndef DcoHeurConicRepair_hpp_
+#define DcoHeurConicRepair_hpp_
+
+// Disco headers
+#include "DcoHeuristic.hpp"
+#include "DcoRowActivity.hpp"
+
+/*!
+  Repairs points that are integer feasible but violate cones. Integer
+  columns are fixed to their (rounded) values and the problem is solved in
+  the continuous columns, see repair().
+
+  In conic builds the continuous problem is solved with a copy of the conic
+  solver. OA builds do not link a conic solver, the continuous problem is
+  solved on a copy of the node LP by adding supports of the violated cones,
+  see DcoModel::repairSolution(). Before the solver is copied, core rows are
+  checked at the rounded point (see DcoRowActivity), a violated row without
+  a continuous column that is not fixed can not be repaired.
+
+  searchSolution() repairs the node relaxation solution when it is integer
+  feasible but violates a cone, this happens in OA builds. The same integer
+  assignment is not repaired twice in a row. DcoHeurRounding repairs its
+  rounded points through repair() too.
+*/
+
+class DcoHeurConicRepair: virtual public DcoHeuristic {
+  /// Integer part of the last repaired point, size numIntegerCols().
+  double * lastFix_;
+  /// 1 for integer columns, size number of core columns.
+  char * isInteger_;
+  /// Core row activities, created at the first repair.
+  DcoRowActivity * activity_;
+  /// Returns true if the heuristic should be called now.
+  bool shouldCall();
+  /// Returns false if a core row is violated at point with integer columns
+  /// rounded and has no continuous column that is not fixed.
+  bool canRepair(double const * point);
+public:
+  ///@name Constructors and Destructor.
+  //@{
+  /// Useful constructor.
+  DcoHeurConicRepair(DcoModel * model, char const * name,
+                     DcoHeurStrategy strategy, int frequency);
+  /// Destructor.
+  virtual ~DcoHeurConicRepair();
+  //@}
+
+  ///@name Finding solutions.
+  //@{
+  /// returns a solution if found, NULL otherwise.
+  virtual DcoSolution * searchSolution();
+  /// Fix integer columns to their rounded values in point and solve for the
+  /// continuous columns. Returns a solution if the continuous problem is
+  /// feasible, NULL otherwise. Does not update statistics.
+  DcoSolution * repair(double const * point);
+  //@}
+
+private:
+  /// Disable default constructor.
+  DcoHeurConicRepair();
+  /// Disable copy constructor.
+  DcoHeurConicRepair(const DcoHeurConicRepair & other);
+  /// Disable copy assignment operator
+  DcoHeurConicRepair & operator=(const DcoHeurConicRepair & rhs);
+};
+
+#endif
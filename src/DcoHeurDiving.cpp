@@ -0,0 +1,452 @@
+#include <cmath>
+
+#include <CoinMessageHandler.hpp>
+#include <CoinHelperFunctions.hpp>
+#include <CoinTime.hpp>
+#include <CoinWarmStart.hpp>
+#include <OsiCuts.hpp>
+
+#include "DcoHeurDiving.hpp"
+#include "DcoModel.hpp"
+#include "DcoMessage.hpp"
+#include "DcoSolution.hpp"
+#include "DcoBranchStrategyPseudo.hpp"
+
+// Number of iterations a heuristic can use on top of its budget, lets the
+// heuristic dive at the root.
+#define DISCO_DIVE_ITER_OFFSET 1000
+
+DcoHeurDiving::DcoHeurDiving(DcoModel * model, char const * name,
+                             DcoHeurStrategy strategy, int frequency,
+                             double iter_ratio)
+  : DcoHeuristic(model, name, strategy, frequency) {
+  iterRatio_ = iter_ratio;
+  numDiveIterations_ = 0;
+  lastNode_ = -1;
+  frac_ = new double[model->numRelaxedCols()];
+  activity_ = NULL;
+}
+
+DcoHeurDiving::~DcoHeurDiving() {
+  if (frac_) {
+    delete[] frac_;
+    frac_ = NULL;
+  }
+  if (activity_) {
+    delete activity_;
+    activity_ = NULL;
+  }
+}
+
+bool DcoHeurDiving::shouldCall() {
+  if (strategy() == DcoHeurStrategyNone) {
+    // This heuristic has been disabled.
+    return false;
+  }
+  if (model()->numRelaxedCols()==0) {
+    return false;
+  }
+  int num_nodes = model()->broker()->getNumNodesProcessed();
+  if (num_nodes==lastNode_) {
+    // dive once in a node
+    return false;
+  }
+  if (strategy()==DcoHeurStrategyRoot or
+      strategy()==DcoHeurStrategyBeforeRoot) {
+    return num_nodes==0;
+  }
+  return true;
+}
+
+bool DcoHeurDiving::resolve(int & num_iter) {
+  model()->solver()->resolve();
+  num_iter += model()->solver()->getIterationCount();
+  if (model()->relaxationInfeasible(model()->solver())) {
+    return false;
+  }
+  double quality = model()->solver()->getObjSense() *
+    model()->solver()->getObjValue();
+  return quality<model()->broker()->getIncumbentValue();
+}
+
+DcoSolution * DcoHeurDiving::roundSolution(double const * sol) {
+  activity_->reset(sol);
+  if (activity_->numViolated()>0) {
+    return NULL;
+  }
+  int num_relaxed = model()->numRelaxedCols();
+  int const * relaxed = model()->relaxedCols();
+  for (int i=0; i<num_relaxed; ++i) {
+    if (frac_[i]==0.0) {
+      continue;
+    }
+    int col = relaxed[i];
+    double value = sol[col];
+    // nearest integer first
+    double down = floor(value)-value;
+    double up = ceil(value)-value;
+    double first = (-down<up) ? down : up;
+    double second = (-down<up) ? up : down;
+    if (activity_->canMove(col, first)) {
+      activity_->move(col, first);
+    }
+    else if (activity_->canMove(col, second)) {
+      activity_->move(col, second);
+    }
+    else {
+      return NULL;
+    }
+  }
+  double const * point = activity_->solution();
+  OsiCuts supports;
+  if (model()->coneSupports(point, point, supports)>0) {
+    return NULL;
+  }
+  if (!model()->sosFeasible(point)) {
+    return NULL;
+  }
+  int num_cols = model()->getNumCoreVariables();
+  double const * obj = model()->solver()->getObjCoefficients();
+  double quality = 0.0;
+  for (int i=0; i<num_cols; ++i) {
+    quality += obj[i]*point[i];
+  }
+  quality *= model()->solver()->getObjSense();
+  if (quality>=model()->broker()->getIncumbentValue()) {
+    return NULL;
+  }
+  DcoSolution * dco_sol = new DcoSolution(num_cols, point, quality);
+  dco_sol->setBroker(model()->broker_);
+  return dco_sol;
+}
+
+DcoSolution * DcoHeurDiving::searchSolution() {
+  if (!shouldCall()) {
+    return NULL;
+  }
+  if (!model()->solver()->isProvenOptimal()) {
+    return NULL;
+  }
+  long long budget = static_cast<long long>
+    (iterRatio_*model()->numRelaxIterations()) + DISCO_DIVE_ITER_OFFSET -
+    numDiveIterations_;
+  if (budget<=0) {
+    return NULL;
+  }
+  if (!startDive()) {
+    return NULL;
+  }
+  lastNode_ = model()->broker()->getNumNodesProcessed();
+  stats().addCalls();
+  if (activity_==NULL) {
+    double primal_tol;
+    model()->solver()->getDblParam(OsiPrimalTolerance, primal_tol);
+    activity_ = new DcoRowActivity(model(), primal_tol);
+  }
+  double start_time = CoinCpuTime();
+
+  // save node bounds and basis
+  int num_cols = model()->solver()->getNumCols();
+  double * lb = new double[num_cols];
+  double * ub = new double[num_cols];
+  CoinDisjointCopyN(model()->solver()->getColLower(), num_cols, lb);
+  CoinDisjointCopyN(model()->solver()->getColUpper(), num_cols, ub);
+  CoinWarmStart * ws = model()->solver()->getWarmStart();
+
+  DcoSolution * dco_sol = NULL;
+  int num_iter = 0;
+  int depth = 0;
+  bool backtracked = false;
+  while (num_iter < budget) {
+    double const * sol = model()->solver()->getColSolution();
+    if (model()->fractionality(sol, frac_)==0) {
+      int num_inf_cols;
+      double col_inf;
+      int num_inf_rows;
+      double row_inf;
+      DcoSolution * feasible =
+        model()->feasibleSolution(num_inf_cols, col_inf,
+                                  num_inf_rows, row_inf);
+      if (feasible) {
+        double quality = model()->solver()->getObjSense() *
+          model()->solver()->getObjValue();
+        dco_sol = new DcoSolution(num_cols, sol, quality);
+        dco_sol->setBroker(model()->broker_);
+        stats().addNumSolutions();
+        delete feasible;
+      }
+      // integral but infeasible, there is nothing to bound.
+      break;
+    }
+    dco_sol = roundSolution(sol);
+    if (dco_sol) {
+      stats().addNumSolutions();
+      break;
+    }
+    int direction;
+    int col = selectColumn(sol, direction);
+    if (col<0) {
+      break;
+    }
+    double value = sol[col];
+    double col_lb = model()->solver()->getColLower()[col];
+    double col_ub = model()->solver()->getColUpper()[col];
+    depth++;
+    if (direction<0) {
+      model()->solver()->setColUpper(col, floor(value));
+    }
+    else {
+      model()->solver()->setColLower(col, ceil(value));
+    }
+    if (resolve(num_iter)) {
+      continue;
+    }
+    if (backtracked) {
+      break;
+    }
+    // backtrack, bound in the other direction
+    backtracked = true;
+    if (direction<0) {
+      model()->solver()->setColUpper(col, col_ub);
+      model()->solver()->setColLower(col, ceil(value));
+    }
+    else {
+      model()->solver()->setColLower(col, col_lb);
+      model()->solver()->setColUpper(col, floor(value));
+    }
+    if (!resolve(num_iter)) {
+      break;
+    }
+  }
+
+  // restore node bounds and basis
+  for (int i=0; i<num_cols; ++i) {
+    model()->solver()->setColBounds(i, lb[i], ub[i]);
+  }
+  if (ws) {
+    model()->solver()->setWarmStart(ws);
+    delete ws;
+  }
+  model()->solver()->resolve();
+  delete[] lb;
+  delete[] ub;
+
+  numDiveIterations_ += num_iter;
+  if (dco_sol==NULL) {
+    stats().addNoSolCalls();
+  }
+  stats().addTime(CoinCpuTime()-start_time);
+  model()->dcoMessageHandler_->message(DISCO_HEUR_DIVE_STATS,
+                                       *model()->dcoMessages_)
+    << model()->broker()->getProcRank()
+    << name()
+    << depth
+    << num_iter
+    << static_cast<int>(dco_sol!=NULL)
+    << CoinMessageEol;
+  return dco_sol;
+}
+
+//#############################################################################
+// Fractional diving
+//#############################################################################
+
+DcoHeurDivingFractional::DcoHeurDivingFractional(DcoModel * model,
+                                                 char const * name,
+                                                 DcoHeurStrategy strategy,
+                                                 int frequency,
+                                                 double iter_ratio)
+  : DcoHeuristic(model, name, strategy, frequency),
+    DcoHeurDiving(model, name, strategy, frequency, iter_ratio) {
+  setType(DcoHeurTypeDivingFractional);
+}
+
+int DcoHeurDivingFractional::selectColumn(double const * sol,
+                                          int & direction) {
+  int num_relaxed = model()->numRelaxedCols();
+  int const * relaxed = model()->relaxedCols();
+  int best = -1;
+  double best_score = 1.0;
+  for (int i=0; i<num_relaxed; ++i) {
+    if (frac_[i]>0.0 and frac_[i]<best_score) {
+      best = relaxed[i];
+      best_score = frac_[i];
+    }
+  }
+  if (best>=0) {
+    direction = (sol[best]-floor(sol[best]) < 0.5) ? -1 : 1;
+  }
+  return best;
+}
+
+//#############################################################################
+// Pseudocost diving
+//#############################################################################
+
+DcoHeurDivingPseudocost::DcoHeurDivingPseudocost(DcoModel * model,
+                                                 char const * name,
+                                                 DcoHeurStrategy strategy,
+                                                 int frequency,
+                                                 double iter_ratio)
+  : DcoHeuristic(model, name, strategy, frequency),
+    DcoHeurDiving(model, name, strategy, frequency, iter_ratio) {
+  setType(DcoHeurTypeDivingPseudocost);
+  down_ = new double[model->numRelaxedCols()];
+  up_ = new double[model->numRelaxedCols()];
+}
+
+DcoHeurDivingPseudocost::~DcoHeurDivingPseudocost() {
+  if (down_) {
+    delete[] down_;
+    down_ = NULL;
+  }
+  if (up_) {
+    delete[] up_;
+    up_ = NULL;
+  }
+}
+
+bool DcoHeurDivingPseudocost::startDive() {
+  DcoBranchStrategyPseudo * pseudo =
+    dynamic_cast<DcoBranchStrategyPseudo*>(model()->branchStrategy());
+  if (pseudo==NULL) {
+    return false;
+  }
+  pseudo->pseudocosts(down_, up_);
+  return true;
+}
+
+int DcoHeurDivingPseudocost::selectColumn(double const * sol,
+                                          int & direction) {
+  int num_relaxed = model()->numRelaxedCols();
+  int const * relaxed = model()->relaxedCols();
+  int best = -1;
+  double best_score = 0.0;
+  for (int i=0; i<num_relaxed; ++i) {
+    if (frac_[i]==0.0) {
+      continue;
+    }
+    int col = relaxed[i];
+    double f = sol[col] - floor(sol[col]);
+    double down_cost = f*down_[i];
+    double up_cost = (1.0-f)*up_[i];
+    int dir;
+    if (f<0.3) {
+      dir = -1;
+    }
+    else if (f>0.7) {
+      dir = 1;
+    }
+    else {
+      dir = (down_cost<=up_cost) ? -1 : 1;
+    }
+    double score;
+    if (dir<0) {
+      score = (down_cost+1e-6)/(up_cost+1e-6);
+    }
+    else {
+      score = (up_cost+1e-6)/(down_cost+1e-6);
+    }
+    if (best<0 or score<best_score) {
+      best = col;
+      best_score = score;
+      direction = dir;
+    }
+  }
+  return best;
+}
+
+//#############################################################################
+// Vector length diving
+//#############################################################################
+
+DcoHeurDivingVectorLength::DcoHeurDivingVectorLength(DcoModel * model,
+                                                     char const * name,
+                                                     DcoHeurStrategy strategy,
+                                                     int frequency,
+                                                     double iter_ratio)
+  : DcoHeuristic(model, name, strategy, frequency),
+    DcoHeurDiving(model, name, strategy, frequency, iter_ratio) {
+  setType(DcoHeurTypeDivingVectorLength);
+}
+
+int DcoHeurDivingVectorLength::selectColumn(double const * sol,
+                                            int & direction) {
+  int num_relaxed = model()->numRelaxedCols();
+  int const * relaxed = model()->relaxedCols();
+  // number of core rows of columns, cuts are not counted.
+  int const * length = activity_->byCol()->getVectorLengths();
+  double const * obj = model()->solver()->getObjCoefficients();
+  double sense = model()->solver()->getObjSense();
+  int best = -1;
+  double best_score = 0.0;
+  for (int i=0; i<num_relaxed; ++i) {
+    if (frac_[i]==0.0) {
+      continue;
+    }
+    int col = relaxed[i];
+    double f = sol[col] - floor(sol[col]);
+    double cost = sense*obj[col];
+    // bound in the direction that worsens the objective
+    int dir = (cost>=0.0) ? 1 : -1;
+    double change = (dir>0) ? (1.0-f)*fabs(cost) : f*fabs(cost);
+    double score = (change+1e-6)/(length[col]+1.0);
+    if (best<0 or score<best_score) {
+      best = col;
+      best_score = score;
+      direction = dir;
+    }
+  }
+  return best;
+}
+
+//#############################################################################
+// Guided diving
+//#############################################################################
+
+DcoHeurDivingGuided::DcoHeurDivingGuided(DcoModel * model,
+                                         char const * name,
+                                         DcoHeurStrategy strategy,
+                                         int frequency,
+                                         double iter_ratio)
+  : DcoHeuristic(model, name, strategy, frequency),
+    DcoHeurDiving(model, name, strategy, frequency, iter_ratio) {
+  setType(DcoHeurTypeDivingGuided);
+  incumbent_ = NULL;
+}
+
+bool DcoHeurDivingGuided::startDive() {
+  incumbent_ = NULL;
+  if (model()->broker()->getIncumbentValue() >= ALPS_INC_MAX) {
+    return false;
+  }
+  // the incumbent may be stored in an other process
+  DcoSolution * sol = dynamic_cast<DcoSolution*>
+    (model()->broker()->getBestKnowledge(AlpsKnowledgeTypeSolution).first);
+  if (sol==NULL) {
+    return false;
+  }
+  incumbent_ = sol->getValues();
+  return true;
+}
+
+int DcoHeurDivingGuided::selectColumn(double const * sol,
+                                      int & direction) {
+  int num_relaxed = model()->numRelaxedCols();
+  int const * relaxed = model()->relaxedCols();
+  int best = -1;
+  double best_score = 0.0;
+  for (int i=0; i<num_relaxed; ++i) {
+    if (frac_[i]==0.0) {
+      continue;
+    }
+    int col = relaxed[i];
+    double score = fabs(sol[col]-incumbent_[col]);
+    if (best<0 or score<best_score) {
+      best = col;
+      best_score = score;
+      direction = (incumbent_[col]<sol[col]) ? -1 : 1;
+    }
+  }
+  return best;
+}
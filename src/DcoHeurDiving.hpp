@@ -0,0 +1,178 @@
+#ifndef DcoHeurDiving_hpp_
+#define DcoHeurDiving_hpp_
+
+// Disco headers
+#include "DcoHeuristic.hpp"
+#include "DcoRowActivity.hpp"
+
+/*!
+  Base class of diving heuristics. A dive repeatedly bounds one fractional
+  integer column and resolves the node relaxation with DcoModel::solver(),
+  starting from the current basis. Subclasses decide which column to bound
+  and in which direction, see selectColumn().
+
+  When the relaxation becomes infeasible or its objective value exceeds the
+  incumbent, the last bound change is reversed once (backtrack). The dive
+  ends when the relaxation solution is feasible, a second infeasibility is
+  met or no column can be selected. Before a column is bounded, the
+  fractional columns of the relaxation solution are rounded one by one in a
+  direction that keeps the core rows feasible (see DcoRowActivity), the dive
+  ends with the rounded point if it also satisfies the cones and SOS
+  sets. Column bounds and the basis of the node
+  are restored at the end and the node relaxation is resolved, so the node
+  continues with the solution it had.
+
+  # Iteration budget
+
+  Solver iterations of all dives of a heuristic are limited by iterRatio
+  times the iterations spent in node relaxations (see
+  DcoModel::numRelaxIterations()), plus 1000 so that the heuristic can
+  dive at the root. A dive that would exceed the budget is not started and
+  a running dive stops once it uses the remaining budget.
+*/
+
+class DcoHeurDiving: virtual public DcoHeuristic {
+  /// Ratio of dive iterations to the relaxation iterations.
+  double iterRatio_;
+  /// Total number of solver iterations used in dives.
+  long long numDiveIterations_;
+  /// Number of nodes processed when the heuristic is called last.
+  int lastNode_;
+  /// Returns true if the heuristic should be called now.
+  bool shouldCall();
+  /// Solve relaxation after a bound change, update iteration count. Returns
+  /// true if the relaxation is optimal and not cut off by the incumbent.
+  bool resolve(int & num_iter);
+  /// Round fractional columns of relaxation solution sol keeping core rows
+  /// feasible. Returns a solution if all columns are rounded and the point
+  /// is feasible and better than the incumbent, NULL otherwise.
+  DcoSolution * roundSolution(double const * sol);
+protected:
+  ///@name Column selection buffers
+  //@{
+  /// Fractionality of relaxed columns at the current relaxation solution,
+  /// see DcoModel::fractionality().
+  double * frac_;
+  /// Core row activities, created at the first dive.
+  DcoRowActivity * activity_;
+  //@}
+  /// Choose a column to bound at relaxation solution sol, frac_ is filled
+  /// for sol. Returns index of the column, -1 if no column can be chosen.
+  /// direction is set to -1 if the upper bound of the column should be
+  /// decreased and 1 if the lower bound should be increased.
+  virtual int selectColumn(double const * sol, int & direction) = 0;
+  /// Called once before each dive. Returns false if the dive should not be
+  /// started.
+  virtual bool startDive() { return true; }
+public:
+  ///@name Constructors and Destructor.
+  //@{
+  /// Useful constructor.
+  DcoHeurDiving(DcoModel * model, char const * name,
+                DcoHeurStrategy strategy, int frequency, double iter_ratio);
+  /// Destructor.
+  virtual ~DcoHeurDiving();
+  //@}
+
+  ///@name Finding solutions.
+  //@{
+  /// returns a solution if found, NULL otherwise.
+  virtual DcoSolution * searchSolution();
+  //@}
+
+private:
+  /// Disable default constructor.
+  DcoHeurDiving();
+  /// Disable copy constructor.
+  DcoHeurDiving(const DcoHeurDiving & other);
+  /// Disable copy assignment operator
+  DcoHeurDiving & operator=(const DcoHeurDiving & rhs);
+};
+
+/*!
+  Fractional diving, bounds the least fractional column to its nearest
+  integer.
+*/
+class DcoHeurDivingFractional: public DcoHeurDiving {
+protected:
+  virtual int selectColumn(double const * sol, int & direction);
+public:
+  DcoHeurDivingFractional(DcoModel * model, char const * name,
+                          DcoHeurStrategy strategy, int frequency,
+                          double iter_ratio);
+  virtual ~DcoHeurDivingFractional() { }
+private:
+  DcoHeurDivingFractional();
+  DcoHeurDivingFractional(const DcoHeurDivingFractional & other);
+  DcoHeurDivingFractional & operator=(const DcoHeurDivingFractional & rhs);
+};
+
+/*!
+  Pseudocost diving. Columns close to an integer are rounded to it, others
+  are bounded in the direction with the smaller pseudocost. The column with
+  the smallest ratio of the chosen to the other direction is bounded.
+  Pseudocosts are taken from DcoBranchStrategyPseudo, the heuristic does not
+  dive if pseudocost branching is not used.
+*/
+class DcoHeurDivingPseudocost: public DcoHeurDiving {
+  /// Down pseudocosts of relaxed columns.
+  double * down_;
+  /// Up pseudocosts of relaxed columns.
+  double * up_;
+protected:
+  virtual int selectColumn(double const * sol, int & direction);
+  virtual bool startDive();
+public:
+  DcoHeurDivingPseudocost(DcoModel * model, char const * name,
+                          DcoHeurStrategy strategy, int frequency,
+                          double iter_ratio);
+  virtual ~DcoHeurDivingPseudocost();
+private:
+  DcoHeurDivingPseudocost();
+  DcoHeurDivingPseudocost(const DcoHeurDivingPseudocost & other);
+  DcoHeurDivingPseudocost & operator=(const DcoHeurDivingPseudocost & rhs);
+};
+
+/*!
+  Vector length diving. Columns are bounded in the direction that worsens
+  the objective, the column with the smallest objective change per row it
+  appears in is chosen. This prefers columns that fix many rows for a small
+  objective loss (set partitioning like rows).
+*/
+class DcoHeurDivingVectorLength: public DcoHeurDiving {
+protected:
+  virtual int selectColumn(double const * sol, int & direction);
+public:
+  DcoHeurDivingVectorLength(DcoModel * model, char const * name,
+                            DcoHeurStrategy strategy, int frequency,
+                            double iter_ratio);
+  virtual ~DcoHeurDivingVectorLength() { }
+private:
+  DcoHeurDivingVectorLength();
+  DcoHeurDivingVectorLength(const DcoHeurDivingVectorLength & other);
+  DcoHeurDivingVectorLength & operator=(const DcoHeurDivingVectorLength & rhs);
+};
+
+/*!
+  Guided diving, bounds columns towards their values in the incumbent. The
+  column closest to its incumbent value is chosen. Does not dive if there
+  is no incumbent.
+*/
+class DcoHeurDivingGuided: public DcoHeurDiving {
+  /// Incumbent values, set in startDive().
+  double const * incumbent_;
+protected:
+  virtual int selectColumn(double const * sol, int & direction);
+  virtual bool startDive();
+public:
+  DcoHeurDivingGuided(DcoModel * model, char const * name,
+                      DcoHeurStrategy strategy, int frequency,
+                      double iter_ratio);
+  virtual ~DcoHeurDivingGuided() { }
+private:
+  DcoHeurDivingGuided();
+  DcoHeurDivingGuided(const DcoHeurDivingGuided & other);
+  DcoHeurDivingGuided & operator=(const DcoHeurDivingGuided & rhs);
+};
+
+#endif
@@ -0,0 +1,218 @@
+#include <algorithm>
+
+#include <CoinMessageHandler.hpp>
+#include <CoinHelperFunctions.hpp>
+#include <CoinSort.hpp>
+#include <CoinTime.hpp>
+#include <OsiCuts.hpp>
+
+#include "DcoHeurFeasibilityPump.hpp"
+#include "DcoModel.hpp"
+#include "DcoMessage.hpp"
+#include "DcoSolution.hpp"
+
+// Number of earlier rounded points kept to detect cycles.
+#define DISCO_FP_HISTORY 3
+
+DcoHeurFeasibilityPump::DcoHeurFeasibilityPump(DcoModel * model,
+                                               char const * name,
+                                               DcoHeurStrategy strategy,
+                                               int frequency,
+                                               int max_iter)
+  : DcoHeuristic(model, name, strategy, frequency) {
+  setType(DcoHeurTypeFeasibilityPump);
+  maxIter_ = max_iter;
+  lastNode_ = -1;
+}
+
+bool DcoHeurFeasibilityPump::shouldCall() {
+  if (strategy() == DcoHeurStrategyNone) {
+    // This heuristic has been disabled.
+    return false;
+  }
+  if (model()->numIntegerCols()==0) {
+    return false;
+  }
+  // pump is for finding the first solution.
+  if (model()->broker()->getIncumbentValue() < ALPS_INC_MAX) {
+    return false;
+  }
+  if (strategy()==DcoHeurStrategyRoot or
+      strategy()==DcoHeurStrategyBeforeRoot) {
+    return stats().numCalls()==0;
+  }
+  int num_nodes = model()->broker()->getNumNodesProcessed();
+  if (num_nodes==lastNode_) {
+    // already called for this node.
+    return false;
+  }
+  return true;
+}
+
+DcoSolution * DcoHeurFeasibilityPump::searchSolution() {
+  if (!shouldCall()) {
+    return NULL;
+  }
+  lastNode_ = model()->broker()->getNumNodesProcessed();
+  stats().addCalls();
+  double start_time = CoinCpuTime();
+
+  double integer_tol = model()->dcoPar()->entry(DcoParams::integerTol);
+  int num_int = model()->numIntegerCols();
+  int const * int_cols = model()->integerCols();
+
+#if defined(__OA__)
+  OsiSolverInterface * solver = model()->cloneSolver();
+#else
+  OsiConicSolverInterface * solver = model()->cloneSolver();
+#endif
+  int num_cols = solver->getNumCols();
+  double const * lb = solver->getColLower();
+  double const * ub = solver->getColUpper();
+  // keep original objective to evaluate solutions
+  double sense = solver->getObjSense();
+  double * obj = new double[num_cols];
+  std::copy(solver->getObjCoefficients(),
+            solver->getObjCoefficients()+num_cols, obj);
+  double * dist_obj = new double[num_cols];
+  // rounded points, current one is at position 0.
+  double * rounded[DISCO_FP_HISTORY];
+  for (int k=0; k<DISCO_FP_HISTORY; ++k) {
+    rounded[k] = new double[num_int];
+  }
+  int num_rounded = 0;
+  // buffers for flipping
+  double * score = new double[num_int];
+  int * index = new int[num_int];
+  // number of columns flipped when cycling
+  int num_flip = CoinMin(num_int, 10);
+
+  DcoSolution * dco_sol = NULL;
+  int iter = 0;
+  int num_perturb = 0;
+  solver->resolve();
+  while (solver->isProvenOptimal() and iter<maxIter_) {
+    iter++;
+    double const * sol = solver->getColSolution();
+    // shift history and round
+    double * curr = rounded[DISCO_FP_HISTORY-1];
+    for (int k=DISCO_FP_HISTORY-1; k>0; --k) {
+      rounded[k] = rounded[k-1];
+    }
+    rounded[0] = curr;
+    num_rounded = CoinMin(num_rounded+1, DISCO_FP_HISTORY);
+    bool integral = true;
+    for (int i=0; i<num_int; ++i) {
+      double value = sol[int_cols[i]];
+      curr[i] = floor(value+0.5);
+      curr[i] = CoinMax(lb[int_cols[i]], CoinMin(ub[int_cols[i]], curr[i]));
+      if (fabs(curr[i]-value) > integer_tol) {
+        integral = false;
+      }
+    }
+    if (integral) {
+#if defined(__OA__)
+      // projection is integral, check whether cones are satisfied.
+      OsiCuts supports;
+      if (model()->coneSupports(sol, sol, supports) > 0) {
+        solver->applyCuts(supports);
+        solver->resolve();
+        continue;
+      }
+#endif
+      double * new_sol = new double[num_cols];
+      std::copy(sol, sol+num_cols, new_sol);
+      double quality = 0.0;
+      for (int i=0; i<num_int; ++i) {
+        new_sol[int_cols[i]] = curr[i];
+      }
+      for (int i=0; i<num_cols; ++i) {
+        quality += obj[i]*new_sol[i];
+      }
+      quality *= sense;
+      dco_sol = new DcoSolution(num_cols, new_sol, quality);
+      dco_sol->setBroker(model()->broker_);
+      stats().addNumSolutions();
+      delete[] new_sol;
+      break;
+    }
+    // check cycles
+    if (num_rounded>1 and
+        std::equal(rounded[1], rounded[1]+num_int, curr)) {
+      // flip the columns furthest from their rounded values
+      for (int i=0; i<num_int; ++i) {
+        score[i] = -fabs(sol[int_cols[i]]-curr[i]);
+        index[i] = i;
+      }
+      CoinSort_2(score, score+num_int, index);
+      int t = num_flip/2 + static_cast<int>
+        (model()->randomGenerator()->randomDouble()*(num_flip+1));
+      t = CoinMin(t, num_int);
+      for (int k=0; k<t; ++k) {
+        int i = index[k];
+        int col = int_cols[i];
+        double flip = sol[col]>curr[i] ? 1.0 : -1.0;
+        curr[i] = CoinMax(lb[col], CoinMin(ub[col], curr[i]+flip));
+      }
+      num_perturb++;
+    }
+    else {
+      bool cycle = false;
+      for (int k=2; k<num_rounded; ++k) {
+        if (std::equal(rounded[k], rounded[k]+num_int, curr)) {
+          cycle = true;
+          break;
+        }
+      }
+      if (cycle) {
+        // random perturbation
+        for (int i=0; i<num_int; ++i) {
+          int col = int_cols[i];
+          double rho = model()->randomGenerator()->randomDouble() - 0.3;
+          double value = sol[col];
+          if (fabs(value-curr[i]) + CoinMax(rho, 0.0) > 0.5) {
+            curr[i] = value>curr[i] ? ceil(value) : floor(value);
+            curr[i] = CoinMax(lb[col], CoinMin(ub[col], curr[i]));
+          }
+        }
+        num_perturb++;
+      }
+    }
+    // projection, minimize L1 distance to the rounded point.
+    CoinZeroN(dist_obj, num_cols);
+    for (int i=0; i<num_int; ++i) {
+      int col = int_cols[i];
+      if (curr[i]==lb[col]) {
+        dist_obj[col] = 1.0;
+      }
+      else if (curr[i]==ub[col]) {
+        dist_obj[col] = -1.0;
+      }
+    }
+    solver->setObjective(dist_obj);
+    solver->setObjSense(1.0);
+    solver->resolve();
+  }
+
+  if (dco_sol==NULL) {
+    stats().addNoSolCalls();
+  }
+  stats().addTime(CoinCpuTime()-start_time);
+  model()->dcoMessageHandler_->message(DISCO_HEUR_FP_STATS,
+                                       *model()->dcoMessages_)
+    << model()->broker()->getProcRank()
+    << iter
+    << num_perturb
+    << static_cast<int>(dco_sol!=NULL)
+    << CoinMessageEol;
+
+  delete solver;
+  delete[] obj;
+  delete[] dist_obj;
+  for (int k=0; k<DISCO_FP_HISTORY; ++k) {
+    delete[] rounded[k];
+  }
+  delete[] score;
+  delete[] index;
+  return dco_sol;
+}
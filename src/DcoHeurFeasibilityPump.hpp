@@ -0,0 +1,76 @@
+#ifndef DcoHeurFeasibilityPump_hpp_
+#define DcoHeurFeasibilityPump_hpp_
+
+// Disco headers
+#include "DcoHeuristic.hpp"
+
+/*!
+  Implements feasibility pump heuristic of Fischetti, Glover and Lodi
+  extended to convex mixed integer nonlinear problems by Bonami, Cornuejols,
+  Lodi and Margot.
+
+  Starting from the solution of the continuous relaxation, integer columns
+  are rounded and the point of the relaxation closest to the rounded point is
+  computed (projection). These two steps are repeated until the projection
+  is integral or the iteration limit is reached.
+
+  # Projection
+
+  Projection minimizes the L1 distance over integer columns. Distance is
+  linear for integer columns rounded to one of their bounds (all binary
+  columns), other integer columns do not contribute to the distance.
+
+  Projection is solved with a copy of DcoModel::solver(). In OA builds this is
+  the LP outer approximation, integral points that are not conic feasible are
+  cut off with supports of the violated cones and pumping continues. In
+  conic builds projections are conic feasible.
+
+  # Cycles
+
+  If rounding gives the previous rounded point again, T integer columns with
+  the largest distance to their rounded values are flipped, where T is
+  random in [numFlip/2, 3numFlip/2]. If rounding gives one of the earlier
+  rounded points, columns are flipped with a random threshold.
+
+  # Strategy
+
+  The heuristic is called until an incumbent is found. With
+  DcoHeurStrategyBeforeRoot and DcoHeurStrategyRoot it is called once, before
+  and after the root relaxation is solved respectively. Otherwise
+  DcoHeurScheduler decides when it is called, at most once in a node.
+*/
+
+class DcoHeurFeasibilityPump: virtual public DcoHeuristic {
+  /// Maximum number of pumping iterations.
+  int maxIter_;
+  /// Number of nodes processed when the heuristic is called last.
+  int lastNode_;
+  /// Returns true if the heuristic should be called now.
+  bool shouldCall();
+public:
+  ///@name Constructors and Destructor.
+  //@{
+  /// Useful constructor.
+  DcoHeurFeasibilityPump(DcoModel * model, char const * name,
+                         DcoHeurStrategy strategy, int frequency,
+                         int max_iter);
+  /// Destructor.
+  virtual ~DcoHeurFeasibilityPump() { }
+  //@}
+
+  ///@name Finding solutions.
+  //@{
+  /// returns a solution if found, NULL otherwise.
+  virtual DcoSolution * searchSolution();
+  //@}
+
+private:
+  /// Disable default constructor.
+  DcoHeurFeasibilityPump();
+  /// Disable copy constructor.
+  DcoHeurFeasibilityPump(const DcoHeurFeasibilityPump & other);
+  /// Disable copy assignment operator
+  DcoHeurFeasibilityPump & operator=(const DcoHeurFeasibilityPump & rhs);
+};
+
+#endif
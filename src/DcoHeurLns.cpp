@@ -0,0 +1,319 @@
+#include <cmath>
+
+#include <CoinMessageHandler.hpp>
+#include <CoinTime.hpp>
+
+#include <AlpsKnowledgeBrokerSerial.h>
+
+#include "DcoHeurLns.hpp"
+#include "DcoModel.hpp"
+#include "DcoMessage.hpp"
+#include "DcoSolution.hpp"
+#include "DcoSolutionPool.hpp"
+
+DcoHeurLns::DcoHeurLns(DcoModel * model, char const * name,
+                       DcoHeurStrategy strategy, int frequency)
+  : DcoHeuristic(model, name, strategy, frequency) {
+  lastNode_ = -1;
+  minFixRatio_ = model->dcoPar()->entry(DcoParams::heurLnsMinFixRatio);
+}
+
+bool DcoHeurLns::shouldCall() {
+  if (strategy() == DcoHeurStrategyNone) {
+    // This heuristic has been disabled.
+    return false;
+  }
+  if (model()->numIntegerCols()==0) {
+    return false;
+  }
+  if (!model()->solver()->isProvenOptimal()) {
+    return false;
+  }
+  int num_nodes = model()->broker()->getNumNodesProcessed();
+  if (num_nodes==lastNode_) {
+    // search once in a node
+    return false;
+  }
+  if (strategy()==DcoHeurStrategyRoot or
+      strategy()==DcoHeurStrategyBeforeRoot) {
+    return num_nodes==0;
+  }
+  return readyToSearch();
+}
+
+DcoSolution * DcoHeurLns::searchSolution() {
+  if (!shouldCall()) {
+    return NULL;
+  }
+  // get global column bounds
+  int num_cols = model()->getNumCoreVariables();
+  std::vector<BcpsVariable*> & cols = model()->getVariables();
+  double * lb = new double[num_cols];
+  double * ub = new double[num_cols];
+  for (int i=0; i<num_cols; ++i) {
+    lb[i] = cols[i]->getLbHard();
+    ub[i] = cols[i]->getUbHard();
+  }
+  int num_fixed = fixColumns(lb, ub);
+  if (num_fixed<0 or num_fixed < minFixRatio_*model()->numIntegerCols()) {
+    delete[] lb;
+    delete[] ub;
+    return NULL;
+  }
+  lastNode_ = model()->broker()->getNumNodesProcessed();
+  stats().addCalls();
+  double start_time = CoinCpuTime();
+
+  // create the restricted model and set its parameters
+  DcoModel * sub = model()->createSubModel(lb, ub);
+  delete[] lb;
+  delete[] ub;
+  restrictSubModel(sub);
+  sub->setSubSearchParams(model()->dcoPar()->entry(DcoParams::heurLnsNodeLimit),
+                          model()->dcoPar()->entry(DcoParams::heurLnsTimeLimit),
+                          model()->broker()->getIncumbentValue());
+
+  DcoSolution * dco_sol = NULL;
+  int num_nodes = 0;
+  {
+    // nested search, parameters are not read from the command line.
+    char prog_name[] = "disco";
+    char * argv[] = {prog_name};
+    AlpsKnowledgeBrokerSerial sub_broker(1, argv, *sub);
+    sub_broker.search(sub);
+    num_nodes = sub_broker.getNumNodesProcessed();
+    if (sub_broker.hasKnowledge(AlpsKnowledgeTypeSolution)) {
+      DcoSolution * sub_sol = dynamic_cast<DcoSolution*>
+        (sub_broker.getBestKnowledge(AlpsKnowledgeTypeSolution).first);
+      double const * values = sub_sol->getValues();
+      double const * obj = model()->solver()->getObjCoefficients();
+      double quality = 0.0;
+      for (int i=0; i<num_cols; ++i) {
+        quality += obj[i]*values[i];
+      }
+      quality *= model()->solver()->getObjSense();
+      dco_sol = new DcoSolution(num_cols, values, quality);
+      dco_sol->setBroker(model()->broker_);
+      stats().addNumSolutions();
+    }
+  }
+  delete sub->solver();
+  delete sub;
+
+  if (dco_sol==NULL) {
+    stats().addNoSolCalls();
+  }
+  stats().addTime(CoinCpuTime()-start_time);
+  model()->dcoMessageHandler_->message(DISCO_HEUR_LNS_STATS,
+                                       *model()->dcoMessages_)
+    << model()->broker()->getProcRank()
+    << name()
+    << num_fixed
+    << num_nodes
+    << static_cast<int>(dco_sol!=NULL)
+    << CoinMessageEol;
+  return dco_sol;
+}
+
+//#############################################################################
+// RINS
+//#############################################################################
+
+DcoHeurRins::DcoHeurRins(DcoModel * model, char const * name,
+                         DcoHeurStrategy strategy, int frequency)
+  : DcoHeuristic(model, name, strategy, frequency),
+    DcoHeurLns(model, name, strategy, frequency) {
+  setType(DcoHeurTypeRins);
+}
+
+int DcoHeurRins::fixColumns(double * lb, double * ub) {
+  if (model()->broker()->getIncumbentValue() >= ALPS_INC_MAX) {
+    return -1;
+  }
+  // the incumbent may be stored in an other process
+  DcoSolution * inc = dynamic_cast<DcoSolution*>
+    (model()->broker()->getBestKnowledge(AlpsKnowledgeTypeSolution).first);
+  if (inc==NULL) {
+    return -1;
+  }
+  double const * inc_values = inc->getValues();
+  double const * sol = model()->solver()->getColSolution();
+  double integer_tol = model()->dcoPar()->entry(DcoParams::integerTol);
+  int num_int = model()->numIntegerCols();
+  int const * int_cols = model()->integerCols();
+  int num_fixed = 0;
+  for (int i=0; i<num_int; ++i) {
+    int col = int_cols[i];
+    if (fabs(sol[col]-inc_values[col]) <= integer_tol) {
+      lb[col] = floor(inc_values[col]+0.5);
+      ub[col] = lb[col];
+      num_fixed++;
+    }
+  }
+  return num_fixed;
+}
+
+//#############################################################################
+// RENS
+//#############################################################################
+
+DcoHeurRens::DcoHeurRens(DcoModel * model, char const * name,
+                         DcoHeurStrategy strategy, int frequency)
+  : DcoHeuristic(model, name, strategy, frequency),
+    DcoHeurLns(model, name, strategy, frequency) {
+  setType(DcoHeurTypeRens);
+}
+
+int DcoHeurRens::fixColumns(double * lb, double * ub) {
+  double const * sol = model()->solver()->getColSolution();
+  double integer_tol = model()->dcoPar()->entry(DcoParams::integerTol);
+  int num_int = model()->numIntegerCols();
+  int const * int_cols = model()->integerCols();
+  int num_fixed = 0;
+  for (int i=0; i<num_int; ++i) {
+    int col = int_cols[i];
+    double value = sol[col];
+    double rounded = floor(value+0.5);
+    if (fabs(value-rounded) <= integer_tol) {
+      lb[col] = rounded;
+      ub[col] = rounded;
+      num_fixed++;
+    }
+    else {
+      lb[col] = CoinMax(lb[col], floor(value));
+      ub[col] = CoinMin(ub[col], ceil(value));
+    }
+  }
+  return num_fixed;
+}
+
+//#############################################################################
+// Crossover
+//#############################################################################
+
+DcoHeurCrossover::DcoHeurCrossover(DcoModel * model, char const * name,
+                                   DcoHeurStrategy strategy, int frequency)
+  : DcoHeuristic(model, name, strategy, frequency),
+    DcoHeurLns(model, name, strategy, frequency) {
+  setType(DcoHeurTypeCrossover);
+  lastVersion_ = -1;
+}
+
+bool DcoHeurCrossover::readyToSearch() {
+  DcoSolutionPool * pool = model()->solutionPool();
+  if (pool==NULL or pool->size()<2 or pool->version()==lastVersion_) {
+    return false;
+  }
+  // search when the search stalls
+  int num_nodes = model()->broker()->getNumNodesProcessed();
+  int stall_nodes = model()->dcoPar()->entry(DcoParams::heurStallNodes);
+  return num_nodes - pool->lastImproveNode() >= stall_nodes;
+}
+
+int DcoHeurCrossover::fixColumns(double * lb, double * ub) {
+  DcoSolutionPool * pool = model()->solutionPool();
+  int num_sols = CoinMin(pool->size(),
+                         model()->dcoPar()->entry(DcoParams::heurCrossoverNumSols));
+  if (num_sols<2) {
+    return -1;
+  }
+  lastVersion_ = pool->version();
+  int num_int = model()->numIntegerCols();
+  int const * int_cols = model()->integerCols();
+  double const * best = pool->solution(0)->getValues();
+  int num_fixed = 0;
+  for (int i=0; i<num_int; ++i) {
+    int col = int_cols[i];
+    double value = floor(best[col]+0.5);
+    bool agree = true;
+    for (int k=1; k<num_sols; ++k) {
+      if (floor(pool->solution(k)->getValues()[col]+0.5) != value) {
+        agree = false;
+        break;
+      }
+    }
+    if (agree) {
+      lb[col] = value;
+      ub[col] = value;
+      num_fixed++;
+    }
+  }
+  if (num_fixed==num_int) {
+    // solutions agree in all integer columns, nothing to search
+    return -1;
+  }
+  return num_fixed;
+}
+
+//#############################################################################
+// Local branching
+//#############################################################################
+
+DcoHeurLocalBranching::DcoHeurLocalBranching(DcoModel * model,
+                                             char const * name,
+                                             DcoHeurStrategy strategy,
+                                             int frequency)
+  : DcoHeuristic(model, name, strategy, frequency),
+    DcoHeurLns(model, name, strategy, frequency) {
+  setType(DcoHeurTypeLocalBranching);
+  lastQuality_ = COIN_DBL_MAX;
+  ballUb_ = 0.0;
+  // binary columns are not fixed, the ball restricts them.
+  minFixRatio_ = 0.0;
+}
+
+bool DcoHeurLocalBranching::readyToSearch() {
+  DcoSolutionPool * pool = model()->solutionPool();
+  if (pool==NULL or pool->size()==0 or
+      pool->solution(0)->getQuality()==lastQuality_) {
+    return false;
+  }
+  // search when the search stalls
+  int num_nodes = model()->broker()->getNumNodesProcessed();
+  int stall_nodes = model()->dcoPar()->entry(DcoParams::heurStallNodes);
+  return num_nodes - pool->lastImproveNode() >= stall_nodes;
+}
+
+int DcoHeurLocalBranching::fixColumns(double * lb, double * ub) {
+  DcoSolution const * inc = model()->solutionPool()->solution(0);
+  lastQuality_ = inc->getQuality();
+  double const * inc_values = inc->getValues();
+  int num_int = model()->numIntegerCols();
+  int const * int_cols = model()->integerCols();
+  int radius = model()->dcoPar()->entry(DcoParams::heurLocalBranchRadius);
+  ballInd_.clear();
+  ballVal_.clear();
+  ballUb_ = radius;
+  int num_fixed = 0;
+  for (int i=0; i<num_int; ++i) {
+    int col = int_cols[i];
+    double value = floor(inc_values[col]+0.5);
+    if (lb[col]==0.0 and ub[col]==1.0) {
+      // binary column, x_j if incumbent is 0, 1-x_j if it is 1
+      ballInd_.push_back(col);
+      if (value==0.0) {
+        ballVal_.push_back(1.0);
+      }
+      else {
+        ballVal_.push_back(-1.0);
+        ballUb_ -= 1.0;
+      }
+    }
+    else {
+      lb[col] = value;
+      ub[col] = value;
+      num_fixed++;
+    }
+  }
+  if (static_cast<int>(ballInd_.size()) <= radius) {
+    // ball contains all binary points
+    return -1;
+  }
+  return num_fixed;
+}
+
+void DcoHeurLocalBranching::restrictSubModel(DcoModel * sub) {
+  int size = static_cast<int>(ballInd_.size());
+  sub->addCoreLinearRow(size, &ballInd_[0], &ballVal_[0],
+                        -COIN_DBL_MAX, ballUb_);
+}
@@ -0,0 +1,157 @@
+#ifndef DcoHeurLns_hpp_
+#define DcoHeurLns_hpp_
+
+// Disco headers
+#include "DcoHeuristic.hpp"
+
+#include <vector>
+
+/*!
+  Base class of large neighborhood search heuristics. Subclasses restrict
+  column bounds (see fixColumns()), the restricted problem is solved with a
+  nested serial search on a copy of the model, see
+  DcoModel::createSubModel().
+
+  The nested search is limited by DcoParams::heurLnsNodeLimit and
+  DcoParams::heurLnsTimeLimit, it uses the incumbent value as cutoff. It is
+  not started if less than DcoParams::heurLnsMinFixRatio of the integer
+  columns are fixed. Large neighborhood search heuristics are disabled in
+  the nested search.
+
+  Subclasses can delay the search with readyToSearch() and add rows to the
+  restricted problem with restrictSubModel().
+*/
+
+class DcoHeurLns: virtual public DcoHeuristic {
+  /// Number of nodes processed when the heuristic is called last.
+  int lastNode_;
+  /// Returns true if the heuristic should be called now.
+  bool shouldCall();
+protected:
+  /// Minimum ratio of fixed integer columns to start the nested search.
+  double minFixRatio_;
+  /// Restrict bounds of the problem. lb and ub are initialized to global
+  /// column bounds. Returns number of fixed integer columns, -1 if the
+  /// neighborhood can not be defined.
+  virtual int fixColumns(double * lb, double * ub) = 0;
+  /// Returns false if the heuristic should not search now. Called after the
+  /// strategy checks.
+  virtual bool readyToSearch() { return true; }
+  /// Restrict the problem further, called before the nested search starts.
+  /// Rows can be added with DcoModel::addCoreLinearRow().
+  virtual void restrictSubModel(DcoModel * sub) { }
+public:
+  ///@name Constructors and Destructor.
+  //@{
+  /// Useful constructor.
+  DcoHeurLns(DcoModel * model, char const * name,
+             DcoHeurStrategy strategy, int frequency);
+  /// Destructor.
+  virtual ~DcoHeurLns() { }
+  //@}
+
+  ///@name Finding solutions.
+  //@{
+  /// returns a solution if found, NULL otherwise.
+  virtual DcoSolution * searchSolution();
+  //@}
+
+private:
+  /// Disable default constructor.
+  DcoHeurLns();
+  /// Disable copy constructor.
+  DcoHeurLns(const DcoHeurLns & other);
+  /// Disable copy assignment operator
+  DcoHeurLns & operator=(const DcoHeurLns & rhs);
+};
+
+/*!
+  Relaxation induced neighborhood search (RINS) of Danna, Rothberg and Le
+  Pape. Integer columns that have the same value in the incumbent and the
+  node relaxation solution are fixed. Does nothing if there is no incumbent.
+*/
+class DcoHeurRins: public DcoHeurLns {
+protected:
+  virtual int fixColumns(double * lb, double * ub);
+public:
+  DcoHeurRins(DcoModel * model, char const * name,
+              DcoHeurStrategy strategy, int frequency);
+  virtual ~DcoHeurRins() { }
+private:
+  DcoHeurRins();
+  DcoHeurRins(const DcoHeurRins & other);
+  DcoHeurRins & operator=(const DcoHeurRins & rhs);
+};
+
+/*!
+  Relaxation enforced neighborhood search (RENS) of Berthold. Integer
+  columns integral in the relaxation solution are fixed, the others are
+  bounded by the floor and ceiling of their values. Meant to be called at
+  the root.
+*/
+class DcoHeurRens: public DcoHeurLns {
+protected:
+  virtual int fixColumns(double * lb, double * ub);
+public:
+  DcoHeurRens(DcoModel * model, char const * name,
+              DcoHeurStrategy strategy, int frequency);
+  virtual ~DcoHeurRens() { }
+private:
+  DcoHeurRens();
+  DcoHeurRens(const DcoHeurRens & other);
+  DcoHeurRens & operator=(const DcoHeurRens & rhs);
+};
+
+/*!
+  Crossover of solutions in the pool. Integer columns that have the same
+  value in the best DcoParams::heurCrossoverNumSols pool solutions are
+  fixed, see DcoSolutionPool. Needs at least two pool solutions. Searches
+  when the incumbent is not improved for DcoParams::heurStallNodes nodes,
+  once for a pool.
+*/
+class DcoHeurCrossover: public DcoHeurLns {
+  /// Pool version at the last search.
+  int lastVersion_;
+protected:
+  virtual int fixColumns(double * lb, double * ub);
+  virtual bool readyToSearch();
+public:
+  DcoHeurCrossover(DcoModel * model, char const * name,
+                   DcoHeurStrategy strategy, int frequency);
+  virtual ~DcoHeurCrossover() { }
+private:
+  DcoHeurCrossover();
+  DcoHeurCrossover(const DcoHeurCrossover & other);
+  DcoHeurCrossover & operator=(const DcoHeurCrossover & rhs);
+};
+
+/*!
+  Local branching of Fischetti and Lodi, polishes the best pool solution
+  \f$ \bar{x} \f$. The nested search is restricted to the Hamming ball
+  \f$ \sum_{j: \bar{x}_j = 0} x_j + \sum_{j: \bar{x}_j = 1} (1-x_j) \leq k \f$
+  over binary columns, where k is DcoParams::heurLocalBranchRadius. General
+  integer columns are fixed. Searches when the incumbent is not improved for
+  DcoParams::heurStallNodes nodes, once for an incumbent.
+*/
+class DcoHeurLocalBranching: public DcoHeurLns {
+  /// Quality of the solution searched last.
+  double lastQuality_;
+  /// Row of the Hamming ball, set by fixColumns().
+  std::vector<int> ballInd_;
+  std::vector<double> ballVal_;
+  double ballUb_;
+protected:
+  virtual int fixColumns(double * lb, double * ub);
+  virtual bool readyToSearch();
+  virtual void restrictSubModel(DcoModel * sub);
+public:
+  DcoHeurLocalBranching(DcoModel * model, char const * name,
+                        DcoHeurStrategy strategy, int frequency);
+  virtual ~DcoHeurLocalBranching() { }
+private:
+  DcoHeurLocalBranching();
+  DcoHeurLocalBranching(const DcoHeurLocalBranching & other);
+  DcoHeurLocalBranching & operator=(const DcoHeurLocalBranching & rhs);
+};
+
+#endif
@@ -1,4 +1,6 @@
 #include <numeric>
+#include <vector>
+#include <algorithm>
 
 #include <CoinMessageHandler.hpp>
 //#include <CoinMessage.hpp>
@@ -9,12 +11,33 @@
 #include "DcoModel.hpp"
 #include "DcoSolution.hpp"
 #include "DcoConicConstraint.hpp"
+#include "DcoHeurConicRepair.hpp"
 
 
 DcoHeurRounding::DcoHeurRounding(DcoModel * model, char const * name,
                                  DcoHeurStrategy strategy, int frequency)
   : DcoHeuristic(model, name, strategy, frequency) {
   setType(DcoHeurTypeRounding);
+  downLocks_ = NULL;
+  upLocks_ = NULL;
+  double primal_tol;
+  model->solver()->getDblParam(OsiPrimalTolerance, primal_tol);
+  activity_ = new DcoRowActivity(model, primal_tol);
+}
+
+DcoHeurRounding::~DcoHeurRounding() {
+  if (downLocks_) {
+    delete[] downLocks_;
+    downLocks_ = NULL;
+  }
+  if (upLocks_) {
+    delete[] upLocks_;
+    upLocks_ = NULL;
+  }
+  if (activity_) {
+    delete activity_;
+    activity_ = NULL;
+  }
 }
 
 DcoSolution * DcoHeurRounding::searchSolution() {
@@ -30,15 +53,12 @@ DcoSolution * DcoHeurRounding::searchSolution() {
     }
   }
   DcoSolution * dco_sol = NULL;
-  // get pointers for message logging
-  CoinMessageHandler * message_handler = model()->dcoMessageHandler_;
-  CoinMessages * messages = model()->dcoMessages_;
   // update statistics
   stats().addCalls();
 
-  // Get a copy of original matrix (and by row for rounding);
-  CoinPackedMatrix const * matrix = model()->solver()->getMatrixByCol();
-  CoinPackedMatrix const * matrixByRow = model()->solver()->getMatrixByRow();
+  // Core matrix, cached by the model (and by row for rounding);
+  CoinPackedMatrix const * matrix = activity_->byCol();
+  CoinPackedMatrix const * matrixByRow = activity_->byRow();
 
 #if defined(__OA__)
   OsiSolverInterface * solver = model()->solver();
@@ -47,14 +67,13 @@ DcoSolution * DcoHeurRounding::searchSolution() {
 #endif
   double const * colLower = solver->getColLower();
   double const * colUpper = solver->getColUpper();
-  double const * rowLower = solver->getRowLower();
-  double const * rowUpper = solver->getRowUpper();
+  double const * rowLower = model()->rowLB();
+  double const * rowUpper = model()->rowUB();
   double const * obj = solver->getObjCoefficients();
   double integerTol = model()->dcoPar()->entry(DcoParams::integerTol);
   double primalTolerance;
   solver->getDblParam(OsiPrimalTolerance, primalTolerance);
 
-  int numRows = matrix->getNumRows();
   int numIntegers = model()->numIntegerCols();
   int const * integerCols = model()->integerCols();
   double direction = solver->getObjSense();
@@ -62,9 +81,6 @@ DcoSolution * DcoHeurRounding::searchSolution() {
   //double newSolutionValue = direction * solver->getObjValue();
 
   // Column copy
-  double const * element = matrix->getElements();
-  int const * row = matrix->getIndices();
-  int const * columnStart = matrix->getVectorStarts();
   int const * columnLength = matrix->getVectorLengths();
   // Row copy
   double const * elementByRow = matrixByRow->getElements();
@@ -72,37 +88,17 @@ DcoSolution * DcoHeurRounding::searchSolution() {
   int const * rowStart = matrixByRow->getVectorStarts();
   int const * rowLength = matrixByRow->getVectorLengths();
 
-  // Get solution array for heuristic solution
+  // Set heuristic solution to the relaxation solution. Rows the relaxation
+  // solution violates slightly (cleaning may move) are repaired below.
   int numCols = solver->getNumCols();
-  double * sol = new double [numCols];
-  std::copy(solver->getColSolution(), solver->getColSolution()+numCols, sol);
+  activity_->reset(solver->getColSolution());
+  double const * sol = activity_->solution();
 
-  double * rowActivity = new double[numRows]();
-
-  for (int i=0; i<numCols; i++) {
-    double value = sol[i];
-    if (value) {
-      for (int j=columnStart[i]; j<columnStart[i]+columnLength[i]; j++) {
-        int iRow = row[j];
-        rowActivity[iRow] += value*element[j];
-      }
-    }
-  }
-  // check was feasible - if not adjust (cleaning may move)
-  for (int i=0; i< numRows; i++) {
-    if(rowActivity[i] < rowLower[i]) {
-      rowActivity[i] = rowLower[i];
-    }
-    else if(rowActivity[i] > rowUpper[i]) {
-      rowActivity[i] = rowUpper[i];
-    }
-  }
   for (int i=0; i<numIntegers; i++) {
     int iColumn = integerCols[i];
     double value = sol[iColumn];
     if (fabs(floor(value + 0.5) - value) > integerTol) {
       double below = floor(value);
-      double newValue = sol[iColumn];
       double cost = direction * obj[iColumn];
       double move;
       if (cost > 0.0) {
@@ -118,36 +114,25 @@ DcoSolution * DcoHeurRounding::searchSolution() {
         // just for now go down
         move = below-value;
       }
-      newValue += move;
-      sol[iColumn] = newValue;
       sol_quality += move * cost;
-      for (int j=columnStart[iColumn];
-           j<columnStart[iColumn]+columnLength[iColumn]; j++) {
-        int iRow = row[j];
-        rowActivity[iRow] += move * element[j];
-      }
+      activity_->move(iColumn, move);
     }
   }
 
   double penalty = 0.0;
-  // see if feasible
-  for (int i=0; i< numRows; i++) {
-    double value = rowActivity[i];
-    double thisInfeasibility = 0.0;
-    if (value < rowLower[i] - primalTolerance) {
-      thisInfeasibility = value - rowLower[i];
-    }
-    else if (value > rowUpper[i] + primalTolerance) {
-      thisInfeasibility = value - rowUpper[i];
-    }
+  // see if feasible, repair changes the violated set so iterate over a copy.
+  std::vector<int> violated(activity_->violated(),
+                            activity_->violated()+activity_->numViolated());
+  for (unsigned int k=0; k<violated.size(); k++) {
+    int i = violated[k];
+    double thisInfeasibility = activity_->violation(i);
     if (thisInfeasibility) {
       // See if there are any slacks I can use to fix up
       // maybe put in coding for multiple slacks?
       double bestCost = 1.0e50;
       int iBest = -1;
       double addCost = 0.0;
-      double newValue = 0.0;
-      double changeRowActivity = 0.0;
+      double bestMove = 0.0;
       double absInfeasibility = fabs(thisInfeasibility);
       for (int k=rowStart[i]; k<rowStart[i]+rowLength[i]; k++) {
         int iColumn = column[k];
@@ -182,8 +167,7 @@ DcoSolution * DcoHeurRounding::searchSolution() {
                 bestCost = thisCost;
                 iBest = iColumn;
                 addCost = thisCost;
-                newValue = currentValue - distance;
-                changeRowActivity = -distance * elementValue;
+                bestMove = -distance;
               }
             }
           }
@@ -210,8 +194,7 @@ DcoSolution * DcoHeurRounding::searchSolution() {
                 bestCost = thisCost;
                 iBest = iColumn;
                 addCost = thisCost;
-                newValue = currentValue + distance;
-                changeRowActivity = distance * elementValue;
+                bestMove = distance;
               }
             }
           }
@@ -220,10 +203,9 @@ DcoSolution * DcoHeurRounding::searchSolution() {
       if (iBest >= 0) {
         /*printf("Infeasibility of %g on row %d cost %g\n",
           thisInfeasibility,i,addCost);*/
-        sol[iBest] = newValue;
+        activity_->move(iBest, bestMove);
         thisInfeasibility = 0.0;
         sol_quality += addCost;
-        rowActivity[i] += changeRowActivity;
       }
       penalty += fabs(thisInfeasibility);
     }
@@ -236,7 +218,7 @@ DcoSolution * DcoHeurRounding::searchSolution() {
     //CoinSeedRandom(seed_);
     // Random number between 0 and 1.
 
-    double randomNumber = CoinDrand48();
+    double randomNumber = model()->randomGenerator()->randomDouble();
     int start[2];
     int end[2];
     int iRandom = (int) (randomNumber * ((double) numIntegers));
@@ -260,148 +242,295 @@ DcoSolution * DcoHeurRounding::searchSolution() {
         else if (cost < 0.0)
           move = 1.0;
         while (move) {
-          bool good = true;
           double newValue = sol[iColumn] + move;
           if (newValue < colLower[iColumn] - primalTolerance||
               newValue > colUpper[iColumn] + primalTolerance) {
             move = 0.0;
           }
-          else {
+          else if (activity_->canMove(iColumn, move)) {
             // see if we can move
-            for (int j=columnStart[iColumn];
-                 j<columnStart[iColumn]+columnLength[iColumn]; j++) {
-              int iRow = row[j];
-              double newActivity =
-                rowActivity[iRow] + move*element[j];
-              if (newActivity < rowLower[iRow] - primalTolerance
-                  ||
-                  newActivity > rowUpper[iRow]+primalTolerance) {
-                good = false;
-                break;
-              }
-            }
-            if (good) {
-              sol[iColumn] = newValue;
-              sol_quality += move * cost;
-              for (int j=columnStart[iColumn];
-                   j<columnStart[iColumn]+columnLength[iColumn]; j++) {
-                int iRow = row[j];
-                rowActivity[iRow] += move*element[j];
-              }
-            }
-            else {
-              move=0.0;
-            }
+            sol_quality += move * cost;
+            activity_->move(iColumn, move);
+          }
+          else {
+            move=0.0;
           }
         }
       }
     }
-    // paranoid check
-    std::fill_n(rowActivity, numRows, 0.0);
-    for (int i=0; i<numCols; i++) {
-      double value = sol[i];
-      if (value) {
-        for (int j=columnStart[i]; j<columnStart[i]+columnLength[i]; j++) {
-          int iRow = row[j];
-          rowActivity[iRow] += value * element[j];
-        }
-      }
-    }
-
-
-    // check was approximately feasible
-    bool feasible = true;
-    for (int i=0; i<numRows; i++) {
-      if (rowActivity[i] < rowLower[i]) {
-        if (rowActivity[i] < rowLower[i] - 1000.0*primalTolerance)
-          feasible = false;
-      }
-      else if (rowActivity[i] > rowUpper[i]) {
-        if (rowActivity[i] > rowUpper[i] + 1000.0*primalTolerance)
-          feasible = false;
-      }
-    }
-    if (feasible!=false) {
-      // check whether the solution is conic feasible
-      double cone_tol = model()->dcoPar()->entry(DcoParams::coneTol);
-      int num_linear_rows = model()->getNumCoreLinearConstraints();
-      int num_conic_rows = model()->getNumCoreConicConstraints();
-      for (int i=num_linear_rows; i<num_linear_rows+num_conic_rows; ++i) {
-        DcoConicConstraint * con =
-          dynamic_cast<DcoConicConstraint*> (model()->getConstraints()[i]);
-        int const * members = con->coneMembers();
-        DcoLorentzConeType type = con->coneType();
-        int size = con->coneSize();
-        double * values = new double[size];
-        for (int i=0; i<size; ++i) {
-          values[i] = sol[members[i]];
-        }
-        double term1;
-        double term2;
-        if (type==DcoLorentzCone) {
-          term1 = values[0];
-          term2 = std::inner_product(values+1, values+size, values+1, 0.0);
-          term2 = sqrt(term2);
-        }
-        else if (type==DcoRotatedLorentzCone) {
-          term1 = 2.0*sol[members[0]]*sol[members[1]];
-          term2 = std::inner_product(values+2, values+size, values+2, 0.0);
-        }
-        else {
-          message_handler->message(DISCO_UNKNOWN_CONETYPE,
-                                   *messages)
-            << type << CoinMessageEol;
-        }
-        if (term1-term2<-cone_tol) {
-          delete[] values;
-          feasible = false;
-          break;
-        }
-        delete[] values;
-      }
+    // paranoid check, recompute activities
+    activity_->reset(sol);
+    // check was feasible
+    bool feasible = (activity_->numViolated()==0);
+    bool cone_violated = false;
+    if (feasible!=false and !coneFeasible(sol)) {
+      feasible = false;
+      cone_violated = true;
     }
 
     if (feasible) {
       // new solution found, store solution.
       dco_sol = new DcoSolution(numCols, sol, sol_quality);
       dco_sol->setBroker(model()->broker_);
-      stats().addNumSolutions();
+    }
+    else if (cone_violated) {
+      // rounded point satisfies linear rows, fix integer columns and solve
+      // for the continuous ones.
+      dco_sol = repairCones(sol);
     }
     else {
-      // update statistics
-      stats().addNoSolCalls();
       // Can easily happen
       //printf("Debug DcoHeurRound giving bad solution\n");
     }
   }
-  delete [] sol;
-  delete [] rowActivity;
+  if (dco_sol==NULL) {
+    // simple rounding failed, round with locks and shift.
+    dco_sol = searchSolution2();
+  }
+  // update statistics
+  if (dco_sol) {
+    stats().addNumSolutions();
+  }
+  else {
+    stats().addNoSolCalls();
+  }
   return dco_sol;
 }
 
+bool DcoHeurRounding::coneFeasible(double const * sol) const {
+  CoinMessageHandler * message_handler = model()->dcoMessageHandler_;
+  CoinMessages * messages = model()->dcoMessages_;
+  double cone_tol = model()->dcoPar()->entry(DcoParams::coneTol);
+  int num_linear_rows = model()->getNumCoreLinearConstraints();
+  int num_conic_rows = model()->getNumCoreConicConstraints();
+  for (int i=num_linear_rows; i<num_linear_rows+num_conic_rows; ++i) {
+    DcoConicConstraint * con =
+      dynamic_cast<DcoConicConstraint*> (model()->getConstraints()[i]);
+    int const * members = con->coneMembers();
+    DcoLorentzConeType type = con->coneType();
+    int size = con->coneSize();
+    double * values = new double[size];
+    for (int i=0; i<size; ++i) {
+      values[i] = sol[members[i]];
+    }
+    double term1 = 0.0;
+    double term2 = 0.0;
+    if (type==DcoLorentzCone) {
+      term1 = values[0];
+      term2 = std::inner_product(values+1, values+size, values+1, 0.0);
+      term2 = sqrt(term2);
+    }
+    else if (type==DcoRotatedLorentzCone) {
+      term1 = 2.0*sol[members[0]]*sol[members[1]];
+      term2 = std::inner_product(values+2, values+size, values+2, 0.0);
+    }
+    else {
+      message_handler->message(DISCO_UNKNOWN_CONETYPE,
+                               *messages)
+        << type << CoinMessageEol;
+    }
+    delete[] values;
+    if (term1-term2<-cone_tol) {
+      return false;
+    }
+  }
+  return true;
+}
 
-DcoSolution * DcoHeurRounding::searchSolution2() {
-  /// todo(aykut) disable heuristic search for now.
+DcoSolution * DcoHeurRounding::repairCones(double const * sol) {
+  for (long unsigned int i=0; i<model()->numHeuristics(); ++i) {
+    DcoHeurConicRepair * repair =
+      dynamic_cast<DcoHeurConicRepair*>(model()->heuristics(i));
+    if (repair and repair->strategy()!=DcoHeurStrategyNone) {
+      return repair->repair(sol);
+    }
+  }
   return NULL;
+}
+
+
+DcoSolution * DcoHeurRounding::searchSolution2() {
   if (strategy() == DcoHeurStrategyNone) {
     // This heuristic has been disabled.
     return NULL;
   }
   DcoModel * dcom = model();
-  // get required pointers for log messages
-  //CoinMessageHandler * message_handler = dcom->dcoMessageHandler_;
-  //CoinMessages * messages = dcom->dcoMessages_;
+  // compute locks once, they depend on core rows only.
+  if (downLocks_==NULL) {
+    int num_cols = dcom->getNumCoreVariables();
+    downLocks_ = new int[num_cols]();
+    upLocks_ = new int[num_cols]();
+    bound_fix(downLocks_, upLocks_);
+  }
 
-  // call bound_fix function to compute find up_fix and down_fix
-  int num_rel_cols = dcom->numRelaxedCols();
-  // if down_fix[i] is 0 variable i can be fixed to its lower bound.
-  int * down_fix = new int[num_rel_cols]();
-  int * up_fix = new int[num_rel_cols]();
-  // == compute up and down fixes
-  bound_fix(down_fix, up_fix);
+#if defined(__OA__)
+  OsiSolverInterface * solver = dcom->solver();
+#else
+  OsiConicSolverInterface * solver = dcom->solver();
+#endif
+  // only core linear rows are kept feasible, cuts are implied by them and
+  // the cones.
+  CoinPackedMatrix const * matrix = activity_->byCol();
+  CoinPackedMatrix const * matrixByRow = activity_->byRow();
+  // Column copy
+  int const * row = matrix->getIndices();
+  int const * columnStart = matrix->getVectorStarts();
+  int const * columnLength = matrix->getVectorLengths();
+  // Row copy
+  double const * elementByRow = matrixByRow->getElements();
+  int const * column = matrixByRow->getIndices();
+  int const * rowStart = matrixByRow->getVectorStarts();
+  int const * rowLength = matrixByRow->getVectorLengths();
 
-  // check up_fix and down_fix
-  return NULL;
+  double const * colLower = solver->getColLower();
+  double const * colUpper = solver->getColUpper();
+  double const * obj = solver->getObjCoefficients();
+  double direction = solver->getObjSense();
+  double integerTol = dcom->dcoPar()->entry(DcoParams::integerTol);
+  double primalTolerance;
+  solver->getDblParam(OsiPrimalTolerance, primalTolerance);
+  int numCols = solver->getNumCols();
+  int numIntegers = dcom->numIntegerCols();
+  int const * integerCols = dcom->integerCols();
+
+  activity_->reset(solver->getColSolution());
+  double const * sol = activity_->solution();
+
+  // round trivially, columns with no lock in a direction can be moved in
+  // that direction without violating any row or cone.
+  int num_trivial = 0;
+  std::vector<int> remaining;
+  for (int i=0; i<numIntegers; ++i) {
+    int iColumn = integerCols[i];
+    double value = sol[iColumn];
+    if (fabs(floor(value+0.5)-value) <= integerTol) {
+      continue;
+    }
+    double cost = direction*obj[iColumn];
+    double newValue;
+    if (downLocks_[iColumn]==0 and (upLocks_[iColumn]!=0 or cost>=0.0)) {
+      newValue = floor(value);
+    }
+    else if (upLocks_[iColumn]==0) {
+      newValue = ceil(value);
+    }
+    else {
+      remaining.push_back(iColumn);
+      continue;
+    }
+    activity_->move(iColumn, newValue-value);
+    num_trivial++;
+  }
+
+  // round the rest in the direction with less locks, columns with fewer
+  // locks first. Shift other columns to repair rows violated by rounding.
+  std::vector<std::pair<int,int> > order;
+  for (unsigned int i=0; i<remaining.size(); ++i) {
+    int iColumn = remaining[i];
+    order.push_back(std::make_pair(downLocks_[iColumn]+upLocks_[iColumn],
+                                   iColumn));
+  }
+  std::sort(order.begin(), order.end());
+  // columns that are rounded are not shifted again
+  char * rounded = new char[numCols]();
+  for (int i=0; i<numIntegers; ++i) {
+    int iColumn = integerCols[i];
+    double value = sol[iColumn];
+    rounded[iColumn] = (fabs(floor(value+0.5)-value) <= integerTol);
+  }
+  int num_shifts = 0;
+  bool feasible = true;
+  for (unsigned int k=0; feasible and k<order.size(); ++k) {
+    int iColumn = order[k].second;
+    double value = sol[iColumn];
+    double newValue;
+    if (downLocks_[iColumn]<upLocks_[iColumn]) {
+      newValue = floor(value);
+    }
+    else if (downLocks_[iColumn]>upLocks_[iColumn]) {
+      newValue = ceil(value);
+    }
+    else {
+      newValue = floor(value+0.5);
+    }
+    activity_->move(iColumn, newValue-value);
+    rounded[iColumn] = 1;
+    // repair rows of this column
+    for (int j=columnStart[iColumn];
+         feasible and j<columnStart[iColumn]+columnLength[iColumn]; ++j) {
+      int iRow = row[j];
+      double violation = activity_->violation(iRow);
+      if (violation==0.0) {
+        continue;
+      }
+      // find the cheapest shift that repairs the row and does not violate
+      // other rows.
+      int iBest = -1;
+      double bestMove = 0.0;
+      double bestCost = COIN_DBL_MAX;
+      for (int l=rowStart[iRow]; l<rowStart[iRow]+rowLength[iRow]; ++l) {
+        int jColumn = column[l];
+        if (rounded[jColumn] and solver->isInteger(jColumn)) {
+          continue;
+        }
+        double move = -violation/elementByRow[l];
+        if (solver->isInteger(jColumn)) {
+          move = (move>0.0) ? ceil(move-primalTolerance) :
+            floor(move+primalTolerance);
+        }
+        double newValue = sol[jColumn] + move;
+        if (newValue < colLower[jColumn]-primalTolerance or
+            newValue > colUpper[jColumn]+primalTolerance) {
+          continue;
+        }
+        double cost = direction*obj[jColumn]*move;
+        if (cost<bestCost and activity_->canMove(jColumn, move)) {
+          iBest = jColumn;
+          bestMove = move;
+          bestCost = cost;
+        }
+      }
+      if (iBest<0) {
+        feasible = false;
+        break;
+      }
+      activity_->move(iBest, bestMove);
+      num_shifts++;
+    }
+  }
+  delete[] rounded;
+
+  // paranoid check, recompute activities
+  if (feasible) {
+    activity_->reset(sol);
+    feasible = (activity_->numViolated()==0);
+  }
+  DcoSolution * dco_sol = NULL;
+  if (feasible) {
+    if (coneFeasible(sol)) {
+      double quality = 0.0;
+      for (int i=0; i<numCols; ++i) {
+        quality += obj[i]*sol[i];
+      }
+      quality *= direction;
+      dco_sol = new DcoSolution(numCols, sol, quality);
+      dco_sol->setBroker(dcom->broker_);
+    }
+    else {
+      // rows are feasible, fix integer columns and solve for the
+      // continuous ones.
+      dco_sol = repairCones(sol);
+    }
+  }
+  dcom->dcoMessageHandler_->message(DISCO_HEUR_LOCK_STATS,
+                                    *dcom->dcoMessages_)
+    << dcom->broker()->getProcRank()
+    << num_trivial
+    << static_cast<int>(remaining.size())
+    << num_shifts
+    << static_cast<int>(dco_sol!=NULL)
+    << CoinMessageEol;
+  return dco_sol;
 }
 
 void DcoHeurRounding::bound_fix(int * down_fix, int * up_fix) {
@@ -410,26 +539,28 @@ void DcoHeurRounding::bound_fix(int * down_fix, int * up_fix) {
   CoinMessageHandler * message_handler = dcom->dcoMessageHandler_;
   //CoinMessages * messages = dcom->dcoMessages_;
 
-  int num_rows = dcom->solver()->getNumRows();
+  // locks of core linear rows
+  int num_rows = dcom->getNumCoreLinearConstraints();
   char const * row_sense = dcom->solver()->getRowSense();
+  double const * row_lower = dcom->solver()->getRowLower();
+  double const * row_upper = dcom->solver()->getRowUpper();
 
   double infinity = dcom->solver()->getInfinity();
   // iterate over rows and update up and down fixed.
   for (int i=0; i<num_rows; ++i) {
     if (row_sense[i]=='R') {
-      if (dcom->solver()->getColUpper()[i]>=infinity
-          and dcom->solver()->getColLower()[i]<=-infinity) {
+      if (row_upper[i]>=infinity and row_lower[i]<=-infinity) {
         // both upper and lower bound are not finite,
         // do nothing
         continue;
       }
       // upper bound is infinity
-      if (dcom->solver()->getColUpper()[i]>=infinity) {
+      if (row_upper[i]>=infinity) {
         bound_fix2('G', i, down_fix, up_fix);
         continue;
       }
       // lower bound is negative infinity
-      if (dcom->solver()->getColLower()[i]<=-infinity) {
+      if (row_lower[i]<=-infinity) {
         bound_fix2('L', i, down_fix, up_fix);
         continue;
       }
@@ -455,12 +586,28 @@ void DcoHeurRounding::bound_fix(int * down_fix, int * up_fix) {
         << CoinMessageEol;
     }
   }
-}
 
+  // locks of cones, decreasing leading columns may violate the cone, other
+  // members can violate the cone in both directions.
+  int num_conic_rows = dcom->getNumCoreConicConstraints();
+  for (int i=num_rows; i<num_rows+num_conic_rows; ++i) {
+    DcoConicConstraint * con =
+      dynamic_cast<DcoConicConstraint*> (dcom->getConstraints()[i]);
+    int const * members = con->coneMembers();
+    int size = con->coneSize();
+    int num_leading = (con->coneType()==DcoRotatedLorentzCone) ? 2 : 1;
+    for (int k=0; k<size; ++k) {
+      down_fix[members[k]]++;
+      if (k>=num_leading) {
+        up_fix[members[k]]++;
+      }
+    }
+  }
+}
 void DcoHeurRounding::bound_fix2(char sense, int row_index, int * down_fix, int * up_fix) {
   //char row_sense = dcom->solver()->getRowSense()[row_index];
 
-  CoinPackedMatrix const * matrix = model()->solver()->getMatrixByRow();
+  CoinPackedMatrix const * matrix = model()->matrixByRow();
   int const * indices = matrix->getIndices();
   double const * values = matrix->getElements();
   int const * lengths = matrix->getVectorLengths();
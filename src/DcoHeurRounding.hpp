@@ -3,6 +3,7 @@
 
 // Disco headers
 #include "DcoHeuristic.hpp"
+#include "DcoRowActivity.hpp"
 
 /*!
   Implements simple rounding heuristic described in Achterberg's dissretation.
@@ -10,12 +11,36 @@
   # Ideas:
   When rounding solutions we can round integer leading variables up.
 
+  # Lock rounding
+
+  When simple rounding fails searchSolution2() is called. A down (up) lock
+  of a column is a core row or cone that may be violated when the column
+  is decreased (increased). Locks are computed once, see bound_fix().
+  Fractional integer columns without a lock in a direction are rounded in
+  that direction. The rest are rounded in the direction with less locks,
+  columns with fewer locks first, and rows violated by rounding are repaired
+  by shifting one column of the row (shift and propagate). Row activities
+  are updated incrementally, see DcoRowActivity. Points that satisfy rows but violate cones are
+  passed to DcoHeurConicRepair::repair().
 */
 
 /** Heuristic base class */
 class DcoHeurRounding: virtual public DcoHeuristic {
+  /// Number of down locks of columns, NULL until computed.
+  int * downLocks_;
+  /// Number of up locks of columns, NULL until computed.
+  int * upLocks_;
+  /// Rounded point and its row activities.
+  DcoRowActivity * activity_;
+  /// Compute locks of core linear rows and cones.
   void bound_fix(int * down_fix, int * up_fix);
+  /// Add locks of row row_index, sense is the sense of its finite bounds.
   void bound_fix2(char sense, int row_index, int * down_fix, int * up_fix);
+  /// Returns true if sol satisfies core cones.
+  bool coneFeasible(double const * sol) const;
+  /// Repair a point that violates cones with DcoHeurConicRepair, if it is
+  /// enabled.
+  DcoSolution * repairCones(double const * sol);
 public:
   ///@name Constructors and Destructor.
   //@{
@@ -23,13 +48,15 @@ public:
   DcoHeurRounding(DcoModel * model, char const * name,
                   DcoHeurStrategy strategy, int frequency);
   /// Destructor.
-  virtual ~DcoHeurRounding() { }
+  virtual ~DcoHeurRounding();
   //@}
 
   ///@name Finding solutions.
   //@{
   /// returns a solution if found, NULL otherwise.
   virtual DcoSolution * searchSolution();
+  /// Lock rounding with shift and propagate. Called by searchSolution() when
+  /// simple rounding fails, does not update statistics.
   virtual DcoSolution * searchSolution2();
   //@}
 
@@ -0,0 +1,108 @@
+#include <CoinHelperFunctions.hpp>
+#include <CoinTime.hpp>
+
+#include "DcoHeurScheduler.hpp"
+#include "DcoModel.hpp"
+#include "DcoHeuristic.hpp"
+
+// Number of calls of an auto heuristic before its statistics are used.
+#define DISCO_HEUR_EXPLORE_CALLS 5
+
+DcoHeurScheduler::DcoHeurScheduler(DcoModel * model) {
+  model_ = model;
+  numHeuristics_ = static_cast<int>(model->numHeuristics());
+  numCalls_ = new int[numHeuristics_]();
+  numSuccess_ = new int[numHeuristics_]();
+  time_ = new double[numHeuristics_]();
+  lastNode_ = new int[numHeuristics_];
+  CoinFillN(lastNode_, numHeuristics_, -1);
+  startTime_ = CoinCpuTime();
+  totalTime_ = 0.0;
+}
+
+DcoHeurScheduler::~DcoHeurScheduler() {
+  if (numCalls_) {
+    delete[] numCalls_;
+    numCalls_ = NULL;
+  }
+  if (numSuccess_) {
+    delete[] numSuccess_;
+    numSuccess_ = NULL;
+  }
+  if (time_) {
+    delete[] time_;
+    time_ = NULL;
+  }
+  if (lastNode_) {
+    delete[] lastNode_;
+    lastNode_ = NULL;
+  }
+}
+
+double DcoHeurScheduler::yield(int i) const {
+  return (numSuccess_[i]+1.0)/(time_[i]+1e-3);
+}
+
+bool DcoHeurScheduler::select(int i, int depth, double gap) {
+  DcoHeuristic * heur = model_->heuristics(i);
+  DcoHeurStrategy strategy = heur->strategy();
+  if (strategy==DcoHeurStrategyNone or
+      strategy==DcoHeurStrategyBeforeRoot) {
+    return false;
+  }
+  if (strategy==DcoHeurStrategyRoot) {
+    return depth==0;
+  }
+  int node = model_->broker()->getNumNodesProcessed();
+  if (lastNode_[i]==node) {
+    // periodic and auto heuristics are called once in a node
+    return false;
+  }
+  // check time share, heuristics get at least share seconds
+  double share = model_->dcoPar()->entry(DcoParams::heurTimeShare);
+  double budget = share*CoinMax(CoinCpuTime()-startTime_, 1.0);
+  if (totalTime_ > budget) {
+    return false;
+  }
+  int freq = CoinMax(heur->frequency(), 1);
+  if (strategy==DcoHeurStrategyPeriodic) {
+    return node%freq==0;
+  }
+  // auto strategy
+  if (numCalls_[i] < DISCO_HEUR_EXPLORE_CALLS) {
+    return true;
+  }
+  if (totalTime_ > 0.5*budget) {
+    // prefer heuristics with better yield
+    double best = 0.0;
+    for (int k=0; k<numHeuristics_; ++k) {
+      if (model_->heuristics(k)->strategy()==DcoHeurStrategyAuto) {
+        best = CoinMax(best, yield(k));
+      }
+    }
+    if (yield(i) < 0.1*best) {
+      return false;
+    }
+  }
+  double rate = (numSuccess_[i]+1.0)/(numCalls_[i]+1.0);
+  double interval = freq/rate;
+  if (gap>1.0) {
+    // no incumbent
+    interval *= 0.25;
+  }
+  else if (gap<0.01) {
+    interval *= 4.0;
+  }
+  interval *= 1.0 + depth/10.0;
+  return node-lastNode_[i] >= interval;
+}
+
+void DcoHeurScheduler::update(int i, double time, bool found) {
+  numCalls_[i]++;
+  if (found) {
+    numSuccess_[i]++;
+  }
+  time_[i] += time;
+  totalTime_ += time;
+  lastNode_[i] = model_->broker()->getNumNodesProcessed();
+}
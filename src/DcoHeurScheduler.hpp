@@ -0,0 +1,85 @@
+#ifndef DcoHeurScheduler_hpp_
+#define DcoHeurScheduler_hpp_
+
+#include "Dco.hpp"
+
+class DcoModel;
+
+/*!
+  Decides which heuristics are called at a node. DcoTreeNode::callHeuristics()
+  asks select() before calling a heuristic and reports the outcome with
+  update(). Heuristics do not check their strategy and frequency themselves.
+
+  Strategies are honoured as follows.
+
+  <ul>
+  <li> DcoHeurStrategyNone: never called.
+  <li> DcoHeurStrategyBeforeRoot: never called here, see
+       DcoTreeNode::callHeuristicsBeforeRoot().
+  <li> DcoHeurStrategyRoot: called at every bounding iteration of the root.
+  <li> DcoHeurStrategyPeriodic: called once at every frequency() nodes.
+  <li> DcoHeurStrategyAuto: called once at a node when at least an interval
+       of nodes is processed since the last call. The interval is
+       \f$ frequency() / rate \f$ where rate is the ratio of the calls that
+       found a solution (with one success and one call added). The interval
+       is decreased when there is no incumbent, increased when the gap is
+       small and increases with depth.
+  </ul>
+
+  Periodic and auto heuristics are skipped when the total time spent in
+  heuristics exceeds DcoParams::heurTimeShare of the search time. Among auto
+  heuristics, the ones with solution yield per second below a tenth of the
+  best yield are skipped when the time share is more than half used.
+*/
+
+class DcoHeurScheduler {
+  /// Pointer to the model.
+  DcoModel * model_;
+  /// Number of heuristics.
+  int numHeuristics_;
+  ///@name Statistics of heuristics, observed by the scheduler.
+  //@{
+  /// Number of calls.
+  int * numCalls_;
+  /// Number of calls that found a solution.
+  int * numSuccess_;
+  /// CPU time spent.
+  double * time_;
+  /// Node counter at the last call, -1 if not called yet.
+  int * lastNode_;
+  //@}
+  /// CPU time when the scheduler is created.
+  double startTime_;
+  /// Total CPU time spent in heuristics.
+  double totalTime_;
+  /// Solution yield per second of heuristic i.
+  double yield(int i) const;
+public:
+  ///@name Constructors and Destructor.
+  //@{
+  /// Useful constructor. Heuristics of the model should be added.
+  DcoHeurScheduler(DcoModel * model);
+  /// Destructor.
+  virtual ~DcoHeurScheduler();
+  //@}
+
+  ///@name Scheduling
+  //@{
+  /// Returns true if heuristic i should be called at the current node. depth
+  /// is the depth of the node, gap is the relative gap of the node to the
+  /// incumbent, larger than 1 if there is no incumbent.
+  bool select(int i, int depth, double gap);
+  /// Update statistics of heuristic i after a call that took time seconds.
+  void update(int i, double time, bool found);
+  //@}
+
+private:
+  /// Disable default constructor.
+  DcoHeurScheduler();
+  /// Disable copy constructor.
+  DcoHeurScheduler(const DcoHeurScheduler & other);
+  /// Disable copy assignment operator
+  DcoHeurScheduler & operator=(const DcoHeurScheduler & rhs);
+};
+
+#endif
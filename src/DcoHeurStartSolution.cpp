@@ -0,0 +1,252 @@
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <map>
+#include <vector>
+
+#include <CoinMessageHandler.hpp>
+#include <CoinHelperFunctions.hpp>
+#include <CoinTime.hpp>
+#include <OsiCuts.hpp>
+
+#include "DcoHeurStartSolution.hpp"
+#include "DcoHeurConicRepair.hpp"
+#include "DcoRowActivity.hpp"
+#include "DcoModel.hpp"
+#include "DcoMessage.hpp"
+#include "DcoSolution.hpp"
+
+DcoHeurStartSolution::DcoHeurStartSolution(DcoModel * model,
+                                           char const * name,
+                                           DcoHeurStrategy strategy,
+                                           int frequency)
+  : DcoHeuristic(model, name, strategy, frequency) {
+  setType(DcoHeurTypeStartSolution);
+  read_ = false;
+}
+
+bool DcoHeurStartSolution::shouldCall() {
+  if (strategy() == DcoHeurStrategyNone) {
+    // This heuristic has been disabled.
+    return false;
+  }
+  if (read_) {
+    return false;
+  }
+  std::string file_name = model()->dcoPar()->entry(DcoParams::startSolutionFile);
+  return !file_name.empty();
+}
+
+int DcoHeurStartSolution::readFile(char const * file_name, double * point,
+                                   bool * given, int & num_unknown) {
+  std::ifstream in(file_name);
+  if (!in.is_open()) {
+    return -1;
+  }
+  std::vector<std::string> const & names = model()->colNames();
+  std::map<std::string, int> name_map;
+  for (int i=0; i<static_cast<int>(names.size()); ++i) {
+    name_map[names[i]] = i;
+  }
+  int num_given = 0;
+  num_unknown = 0;
+  std::string line;
+  while (std::getline(in, line)) {
+    // skip comments and empty lines
+    if (line.empty() or line[0]=='#') {
+      continue;
+    }
+    std::istringstream ls(line);
+    std::string name;
+    double value;
+    if (!(ls >> name >> value)) {
+      continue;
+    }
+    std::map<std::string, int>::const_iterator it = name_map.find(name);
+    if (it==name_map.end()) {
+      num_unknown++;
+      continue;
+    }
+    if (!given[it->second]) {
+      num_given++;
+    }
+    point[it->second] = value;
+    given[it->second] = true;
+  }
+  in.close();
+  return num_given;
+}
+
+bool DcoHeurStartSolution::feasible(double const * point) const {
+  int num_cols = model()->getNumCoreVariables();
+  double primal_tol;
+  model()->solver()->getDblParam(OsiPrimalTolerance, primal_tol);
+  double integer_tol = model()->dcoPar()->entry(DcoParams::integerTol);
+  // column bounds
+  double const * col_lb = model()->solver()->getColLower();
+  double const * col_ub = model()->solver()->getColUpper();
+  for (int i=0; i<num_cols; ++i) {
+    if (point[i] < col_lb[i]-primal_tol or point[i] > col_ub[i]+primal_tol) {
+      return false;
+    }
+  }
+  // integrality
+  int num_int = model()->numIntegerCols();
+  int const * int_cols = model()->integerCols();
+  for (int i=0; i<num_int; ++i) {
+    double value = point[int_cols[i]];
+    if (fabs(value-floor(value+0.5)) > integer_tol) {
+      return false;
+    }
+  }
+  // core rows
+  DcoRowActivity activity(model(), primal_tol);
+  activity.reset(point);
+  if (activity.numViolated()>0) {
+    return false;
+  }
+  // cones
+  OsiCuts supports;
+  if (model()->coneSupports(point, point, supports)>0) {
+    return false;
+  }
+  // SOS sets
+  if (!model()->sosFeasible(point)) {
+    return false;
+  }
+  return true;
+}
+
+bool DcoHeurStartSolution::complete(double * point, bool const * given) {
+#if defined(__OA__)
+  OsiSolverInterface * solver = model()->cloneSolver();
+#else
+  OsiConicSolverInterface * solver = model()->cloneSolver();
+#endif
+  double integer_tol = model()->dcoPar()->entry(DcoParams::integerTol);
+  int num_int = model()->numIntegerCols();
+  int const * int_cols = model()->integerCols();
+  // solver may reallocate its bound arrays, keep a copy
+  std::vector<double> col_lb(solver->getColLower(),
+                             solver->getColLower()+solver->getNumCols());
+  std::vector<double> col_ub(solver->getColUpper(),
+                             solver->getColUpper()+solver->getNumCols());
+  // fix given integer columns
+  std::vector<int> missing;
+  for (int i=0; i<num_int; ++i) {
+    int col = int_cols[i];
+    if (!given[col]) {
+      missing.push_back(col);
+      continue;
+    }
+    double value = floor(point[col]+0.5);
+    value = CoinMax(col_lb[col], CoinMin(col_ub[col], value));
+    solver->setColBounds(col, value, value);
+  }
+  bool is_feasible = true;
+  while (!missing.empty()) {
+    solver->resolve();
+    if (model()->relaxationInfeasible(solver)) {
+      is_feasible = false;
+      break;
+    }
+    double const * sol = solver->getColSolution();
+    // fix integral columns, the least fractional one if there is none
+    std::vector<int> rest;
+    int least = -1;
+    double least_frac = COIN_DBL_MAX;
+    for (std::vector<int>::iterator it=missing.begin(); it!=missing.end();
+         ++it) {
+      int col = *it;
+      double frac = fabs(sol[col]-floor(sol[col]+0.5));
+      if (frac <= integer_tol) {
+        point[col] = floor(sol[col]+0.5);
+        solver->setColBounds(col, point[col], point[col]);
+        continue;
+      }
+      if (frac < least_frac) {
+        least = static_cast<int>(rest.size());
+        least_frac = frac;
+      }
+      rest.push_back(col);
+    }
+    if (rest.size()==missing.size()) {
+      int col = rest[least];
+      double value = floor(sol[col]+0.5);
+      point[col] = CoinMax(col_lb[col], CoinMin(col_ub[col], value));
+      solver->setColBounds(col, point[col], point[col]);
+      rest.erase(rest.begin()+least);
+    }
+    missing.swap(rest);
+  }
+  delete solver;
+  return is_feasible;
+}
+
+DcoSolution * DcoHeurStartSolution::searchSolution() {
+  if (!shouldCall()) {
+    return NULL;
+  }
+  read_ = true;
+  std::string file_name = model()->dcoPar()->entry(DcoParams::startSolutionFile);
+  stats().addCalls();
+  double start_time = CoinCpuTime();
+  int num_cols = model()->getNumCoreVariables();
+  double * point = new double[num_cols]();
+  bool * given = new bool[num_cols]();
+  int num_unknown = 0;
+  int num_given = readFile(file_name.c_str(), point, given, num_unknown);
+  if (num_given<0) {
+    model()->dcoMessageHandler_->message(DISCO_HEUR_START_FAILED,
+                                         *model()->dcoMessages_)
+      << file_name.c_str() << CoinMessageEol;
+    delete[] point;
+    delete[] given;
+    stats().addNoSolCalls();
+    stats().addTime(CoinCpuTime()-start_time);
+    return NULL;
+  }
+  // number of integer columns completed by fix-and-solve
+  int num_missing = 0;
+  int num_int = model()->numIntegerCols();
+  int const * int_cols = model()->integerCols();
+  for (int i=0; i<num_int; ++i) {
+    if (!given[int_cols[i]]) {
+      num_missing++;
+    }
+  }
+  DcoSolution * dco_sol = NULL;
+  if (num_given==num_cols and feasible(point)) {
+    double const * obj = model()->solver()->getObjCoefficients();
+    double quality = 0.0;
+    for (int i=0; i<num_cols; ++i) {
+      quality += obj[i]*point[i];
+    }
+    quality *= model()->solver()->getObjSense();
+    dco_sol = new DcoSolution(num_cols, point, quality);
+    dco_sol->setBroker(model()->broker_);
+  }
+  else if (num_given>0 and (num_missing==0 or complete(point, given))) {
+    // fix integer columns, solve for the continuous ones.
+    DcoHeurConicRepair repair(model(), "start repair", DcoHeurStrategyNone, -1);
+    dco_sol = repair.repair(point);
+  }
+  delete[] point;
+  delete[] given;
+  if (dco_sol) {
+    stats().addNumSolutions();
+  }
+  else {
+    stats().addNoSolCalls();
+  }
+  stats().addTime(CoinCpuTime()-start_time);
+  model()->dcoMessageHandler_->message(DISCO_HEUR_START_READ,
+                                       *model()->dcoMessages_)
+    << num_given
+    << file_name.c_str()
+    << num_unknown
+    << num_missing
+    << static_cast<int>(dco_sol!=NULL)
+    << CoinMessageEol;
+  return dco_sol;
+}
@@ -0,0 +1,68 @@
+#ifndef DcoHeurStartSolution_hpp_
+#define DcoHeurStartSolution_hpp_
+
+// Disco headers
+#include "DcoHeuristic.hpp"
+
+/*!
+  Reads a start solution from DcoParams::startSolutionFile and installs it
+  as the incumbent before the root relaxation is solved, so the root is
+  solved with the objective cutoff of the start.
+
+  Each line of the file is a column name followed by its value, other lines
+  and unknown names are skipped. Solution files written by DisCO and most
+  MIP solvers can be read. The start can be partial.
+
+  A complete start is checked against column bounds, integrality, core rows
+  (see DcoRowActivity), cones and SOS sets. If it is infeasible, integer
+  columns are fixed and the problem is solved for the continuous columns
+  with DcoHeurConicRepair::repair(). Integer columns missing in a partial
+  start are completed first by fix-and-solve, given integer columns are
+  fixed, the relaxation is solved and missing columns are fixed to their
+  rounded relaxation values one at a time, integral ones first.
+
+  The file is read once, in the root of the search. Large neighborhood
+  search heuristics do not read it in their nested searches.
+*/
+
+class DcoHeurStartSolution: virtual public DcoHeuristic {
+  /// True if the file is read.
+  bool read_;
+  /// Returns true if the heuristic should be called now.
+  bool shouldCall();
+  /// Read the file to point. Sets given[i] for columns in the file. Returns
+  /// number of columns given, -1 if the file can not be opened.
+  int readFile(char const * file_name, double * point, bool * given,
+               int & num_unknown);
+  /// Returns true if point is feasible.
+  bool feasible(double const * point) const;
+  /// Fix-and-solve, fill integer columns of point that are not given.
+  /// Returns false if the relaxation becomes infeasible.
+  bool complete(double * point, bool const * given);
+public:
+  ///@name Constructors and Destructor.
+  //@{
+  /// Useful constructor.
+  DcoHeurStartSolution(DcoModel * model, char const * name,
+                       DcoHeurStrategy strategy, int frequency);
+  /// Destructor.
+  virtual ~DcoHeurStartSolution() { }
+  //@}
+
+  ///@name Finding solutions.
+  //@{
+  /// returns the start solution if it is feasible or can be repaired, NULL
+  /// otherwise.
+  virtual DcoSolution * searchSolution();
+  //@}
+
+private:
+  /// Disable default constructor.
+  DcoHeurStartSolution();
+  /// Disable copy constructor.
+  DcoHeurStartSolution(const DcoHeurStartSolution & other);
+  /// Disable copy assignment operator
+  DcoHeurStartSolution & operator=(const DcoHeurStartSolution & rhs);
+};
+
+#endif
@@ -0,0 +1,290 @@
+#include <cmath>
+
+#include <CoinHelperFunctions.hpp>
+#include <CoinTime.hpp>
+
+#include "DcoHeurWorker.hpp"
+#include "DcoModel.hpp"
+#include "DcoSolution.hpp"
+
+// Maximum number of LPs solved for a snapshot.
+#define DISCO_WORKER_MAX_LPS 1000
+
+DcoHeurWorker::DcoHeurWorker(DcoModel * model) {
+  model_ = model;
+  solver_ = model->cloneSolver();
+  numCols_ = model->getNumCoreVariables();
+  integerTol_ = model->dcoPar()->entry(DcoParams::integerTol);
+  colLb_ = new double[numCols_];
+  colUb_ = new double[numCols_];
+  lpSol_ = new double[numCols_];
+  incumbent_ = new double[numCols_];
+  hasIncumbent_ = false;
+  cutoff_ = COIN_DBL_MAX;
+  frac_ = new double[model->numRelaxedCols()];
+  numPosted_ = 0;
+  numDropped_ = 0;
+  numSolutions_ = 0;
+  time_ = 0.0;
+  stop_ = false;
+  hasJob_ = false;
+  busy_ = false;
+  pthread_mutex_init(&mutex_, NULL);
+  pthread_cond_init(&cond_, NULL);
+  running_ = (pthread_create(&thread_, NULL, &DcoHeurWorker::run, this)==0);
+}
+
+DcoHeurWorker::~DcoHeurWorker() {
+  stop();
+  pthread_cond_destroy(&cond_);
+  pthread_mutex_destroy(&mutex_);
+  if (solver_) {
+    delete solver_;
+    solver_ = NULL;
+  }
+  if (colLb_) {
+    delete[] colLb_;
+    colLb_ = NULL;
+  }
+  if (colUb_) {
+    delete[] colUb_;
+    colUb_ = NULL;
+  }
+  if (lpSol_) {
+    delete[] lpSol_;
+    lpSol_ = NULL;
+  }
+  if (incumbent_) {
+    delete[] incumbent_;
+    incumbent_ = NULL;
+  }
+  if (frac_) {
+    delete[] frac_;
+    frac_ = NULL;
+  }
+}
+
+void * DcoHeurWorker::run(void * arg) {
+  DcoHeurWorker * worker = static_cast<DcoHeurWorker*>(arg);
+  worker->work();
+  return NULL;
+}
+
+void DcoHeurWorker::work() {
+  pthread_mutex_lock(&mutex_);
+  while (true) {
+    while (!stop_ and !hasJob_) {
+      pthread_cond_wait(&cond_, &mutex_);
+    }
+    if (stop_) {
+      break;
+    }
+    // post() does not write the snapshot while busy_ is set.
+    hasJob_ = false;
+    busy_ = true;
+    pthread_mutex_unlock(&mutex_);
+    double start_time = CoinWallclockTime();
+    DcoSolution * sol = search();
+    double time = CoinWallclockTime() - start_time;
+    pthread_mutex_lock(&mutex_);
+    busy_ = false;
+    time_ += time;
+    if (sol) {
+      solutions_.push_back(sol);
+      numSolutions_++;
+    }
+  }
+  pthread_mutex_unlock(&mutex_);
+}
+
+bool DcoHeurWorker::post(double const * lb, double const * ub,
+                         double const * sol, double cutoff,
+                         double const * incumbent) {
+  if (!running_) {
+    return false;
+  }
+  if (pthread_mutex_trylock(&mutex_)!=0) {
+    numDropped_++;
+    return false;
+  }
+  bool posted = false;
+  if (busy_) {
+    numDropped_++;
+  }
+  else {
+    // a snapshot that is not taken yet is replaced by the newer one.
+    CoinDisjointCopyN(lb, numCols_, colLb_);
+    CoinDisjointCopyN(ub, numCols_, colUb_);
+    CoinDisjointCopyN(sol, numCols_, lpSol_);
+    hasIncumbent_ = (incumbent!=NULL);
+    if (incumbent) {
+      CoinDisjointCopyN(incumbent, numCols_, incumbent_);
+    }
+    cutoff_ = cutoff;
+    hasJob_ = true;
+    numPosted_++;
+    posted = true;
+    pthread_cond_signal(&cond_);
+  }
+  pthread_mutex_unlock(&mutex_);
+  return posted;
+}
+
+int DcoHeurWorker::takeSolutions(std::vector<DcoSolution*> & sols) {
+  if (pthread_mutex_trylock(&mutex_)!=0) {
+    return 0;
+  }
+  int num_sols = static_cast<int>(solutions_.size());
+  sols.insert(sols.end(), solutions_.begin(), solutions_.end());
+  solutions_.clear();
+  pthread_mutex_unlock(&mutex_);
+  return num_sols;
+}
+
+void DcoHeurWorker::stop() {
+  if (!running_) {
+    return;
+  }
+  pthread_mutex_lock(&mutex_);
+  stop_ = true;
+  pthread_cond_signal(&cond_);
+  pthread_mutex_unlock(&mutex_);
+  pthread_join(thread_, NULL);
+  running_ = false;
+  for (std::vector<DcoSolution*>::iterator it=solutions_.begin();
+       it!=solutions_.end(); ++it) {
+    delete *it;
+  }
+  solutions_.clear();
+}
+
+bool DcoHeurWorker::resolve() {
+  solver_->resolve();
+  if (model_->relaxationInfeasible(solver_)) {
+    return false;
+  }
+  return solver_->getObjSense()*solver_->getObjValue() < cutoff_;
+}
+
+DcoSolution * DcoHeurWorker::search() {
+  int num_int = model_->numIntegerCols();
+  int const * int_cols = model_->integerCols();
+  for (int i=0; i<numCols_; ++i) {
+    solver_->setColBounds(i, colLb_[i], colUb_[i]);
+  }
+  if (hasIncumbent_) {
+    // fix integer columns that agree with the incumbent
+    int num_fixed = 0;
+    for (int i=0; i<num_int; ++i) {
+      int col = int_cols[i];
+      if (fabs(lpSol_[col]-incumbent_[col]) <= integerTol_) {
+        double value = floor(incumbent_[col]+0.5);
+        solver_->setColBounds(col, value, value);
+        num_fixed++;
+      }
+    }
+    if (num_fixed>0 and resolve()) {
+      DcoSolution * sol = dive();
+      if (sol) {
+        return sol;
+      }
+    }
+    // no solution in the neighborhood, dive in the node
+    for (int i=0; i<num_int; ++i) {
+      int col = int_cols[i];
+      solver_->setColBounds(col, colLb_[col], colUb_[col]);
+    }
+  }
+  if (!resolve()) {
+    return NULL;
+  }
+  return dive();
+}
+
+DcoSolution * DcoHeurWorker::dive() {
+  int num_relaxed = model_->numRelaxedCols();
+  int const * relaxed = model_->relaxedCols();
+  bool backtracked = false;
+  for (int num_lps=0; num_lps<DISCO_WORKER_MAX_LPS; ++num_lps) {
+    double const * sol = solver_->getColSolution();
+    if (model_->fractionality(sol, frac_)==0) {
+      return repair();
+    }
+    // guided by the incumbent if there is one, least fractional otherwise
+    int col = -1;
+    int direction = 0;
+    double best_score = COIN_DBL_MAX;
+    for (int i=0; i<num_relaxed; ++i) {
+      if (frac_[i]==0.0) {
+        continue;
+      }
+      int c = relaxed[i];
+      double score;
+      int dir;
+      if (hasIncumbent_) {
+        score = fabs(sol[c]-incumbent_[c]);
+        dir = (incumbent_[c]<sol[c]) ? -1 : 1;
+      }
+      else {
+        score = frac_[i];
+        dir = (sol[c]-floor(sol[c]) < 0.5) ? -1 : 1;
+      }
+      if (score<best_score) {
+        col = c;
+        direction = dir;
+        best_score = score;
+      }
+    }
+    double value = sol[col];
+    double col_lb = solver_->getColLower()[col];
+    double col_ub = solver_->getColUpper()[col];
+    if (direction<0) {
+      solver_->setColUpper(col, floor(value));
+    }
+    else {
+      solver_->setColLower(col, ceil(value));
+    }
+    if (resolve()) {
+      continue;
+    }
+    if (backtracked) {
+      return NULL;
+    }
+    // backtrack, bound in the other direction
+    backtracked = true;
+    if (direction<0) {
+      solver_->setColUpper(col, col_ub);
+      solver_->setColLower(col, ceil(value));
+    }
+    else {
+      solver_->setColLower(col, col_lb);
+      solver_->setColUpper(col, floor(value));
+    }
+    if (!resolve()) {
+      return NULL;
+    }
+  }
+  return NULL;
+}
+
+DcoSolution * DcoHeurWorker::repair() {
+  double const * sol = solver_->getColSolution();
+  // SOS sets are resolved by branching, the worker does not repair them.
+  if (!model_->sosFeasible(sol)) {
+    return NULL;
+  }
+  int num_rows = solver_->getNumRows();
+  // same repair as DcoHeurConicRepair, on the copy of the worker. The
+  // solution is copied, fixing columns may change the solver arrays.
+  std::vector<double> point(sol, sol+solver_->getNumCols());
+  DcoSolution * dco_sol = model_->repairSolution(solver_, &point[0], cutoff_);
+  // remove cone supports, next snapshot installs its own bounds.
+  int num_added = solver_->getNumRows() - num_rows;
+  if (num_added>0) {
+    int * added = new int[num_added];
+    CoinIotaN(added, num_added, num_rows);
+    solver_->deleteRows(num_added, added);
+    delete[] added;
+  }
+  return dco_sol;
+}
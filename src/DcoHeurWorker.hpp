@@ -0,0 +1,150 @@
+#ifndef DcoHeurWorker_hpp_
+#define DcoHeurWorker_hpp_
+
+#include <pthread.h>
+#include <vector>
+
+#include <OsiSolverInterface.hpp>
+#include <OsiConicSolverInterface.hpp>
+
+#include "Dco.hpp"
+
+class DcoModel;
+class DcoSolution;
+
+/*!
+  Runs heuristics in a background thread on its own copy of
+  DcoModel::solver(). Enabled with DcoParams::heurThread.
+
+  The search thread posts snapshots of node solutions with post(), the
+  snapshot holds the node column bounds, the node relaxation solution, the
+  incumbent value and the incumbent. post() does not wait for the worker, if
+  the worker is busy the snapshot is dropped. Solutions found by the worker
+  are collected with takeSolutions() and added to the broker by the search
+  thread, the worker does not touch the broker, the model solver or the
+  message handlers.
+
+  For each snapshot the worker installs the node bounds to its solver and
+  dives. When there is an incumbent, integer columns with the same value in
+  the node solution and the incumbent are fixed first (RINS neighborhood)
+  and the dive is guided by the incumbent. Otherwise the least fractional
+  column is bounded (fractional diving). Integral points are repaired with
+  DcoModel::repairSolution() on the copy of the worker, as
+  DcoHeurConicRepair does.
+
+  The solver copy is made when the worker is created, rows of the node
+  subproblem at that time are kept. The search thread should create the
+  worker once the root relaxation is solved.
+*/
+
+class DcoHeurWorker {
+  /// Pointer to the model, the worker reads problem data only.
+  DcoModel * model_;
+  /// Copy of the model solver, used by the worker thread only.
+#if defined(__OA__)
+  OsiSolverInterface * solver_;
+#else
+  OsiConicSolverInterface * solver_;
+#endif
+  /// Number of columns in snapshots.
+  int numCols_;
+  /// Integrality tolerance.
+  double integerTol_;
+  ///@name Thread data
+  //@{
+  pthread_t thread_;
+  /// Protects the fields below, except snapshot arrays.
+  pthread_mutex_t mutex_;
+  /// Signals a new snapshot or stop request to the worker.
+  pthread_cond_t cond_;
+  /// True if the thread is started.
+  bool running_;
+  /// True if the worker should exit.
+  bool stop_;
+  /// True if there is a snapshot the worker did not take yet.
+  bool hasJob_;
+  /// True while the worker searches, snapshot arrays are not written then.
+  bool busy_;
+  //@}
+  ///@name Snapshot
+  //@{
+  double * colLb_;
+  double * colUb_;
+  double * lpSol_;
+  /// Incumbent values, valid if hasIncumbent_ is true.
+  double * incumbent_;
+  bool hasIncumbent_;
+  /// Solutions should be better than this.
+  double cutoff_;
+  //@}
+  /// Solutions found and not taken yet.
+  std::vector<DcoSolution*> solutions_;
+  ///@name Statistics
+  //@{
+  int numPosted_;
+  int numDropped_;
+  int numSolutions_;
+  /// Wall clock time spent in search.
+  double time_;
+  //@}
+  /// Fractionality of relaxed columns, used by the worker thread.
+  double * frac_;
+
+  /// Thread entry point, arg is the worker.
+  static void * run(void * arg);
+  /// Worker loop, waits for snapshots until stop() is called.
+  void work();
+  /// Search the current snapshot.
+  DcoSolution * search();
+  /// Dive from the solution of solver_.
+  DcoSolution * dive();
+  /// Resolve solver_, returns true if it is optimal and better than
+  /// the cutoff.
+  bool resolve();
+  /// Integer columns of solver_ solution are integral, fix them and return a
+  /// solution if the continuous part is feasible. Rows and bounds of
+  /// solver_ are restored.
+  DcoSolution * repair();
+public:
+  ///@name Constructors and Destructor.
+  //@{
+  /// Useful constructor, copies the model solver and starts the thread.
+  DcoHeurWorker(DcoModel * model);
+  /// Destructor, stops the thread.
+  virtual ~DcoHeurWorker();
+  //@}
+
+  ///@name Exchange with the search thread
+  //@{
+  /// Post a snapshot of a node. lb, ub and sol are of size number of core
+  /// columns, incumbent is NULL if there is no incumbent. Returns false if
+  /// the worker is busy and the snapshot is dropped. Does not block.
+  bool post(double const * lb, double const * ub, double const * sol,
+            double cutoff, double const * incumbent);
+  /// Move solutions found by the worker to sols, caller owns them. Returns
+  /// the number of solutions moved. Does not block, returns 0 if the worker
+  /// is storing a solution.
+  int takeSolutions(std::vector<DcoSolution*> & sols);
+  /// Stop the worker and wait for it to exit. Solutions that are not taken
+  /// are freed.
+  void stop();
+  //@}
+
+  ///@name Statistics, valid after stop().
+  //@{
+  int numPosted() const { return numPosted_; }
+  int numDropped() const { return numDropped_; }
+  int numSolutions() const { return numSolutions_; }
+  double time() const { return time_; }
+  //@}
+
+private:
+  /// Disable default constructor.
+  DcoHeurWorker();
+  /// Disable copy constructor.
+  DcoHeurWorker(const DcoHeurWorker & other);
+  /// Disable copy assignment operator
+  DcoHeurWorker & operator=(const DcoHeurWorker & rhs);
+};
+
+#endif
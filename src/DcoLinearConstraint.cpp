@@ -1,5 +1,9 @@
 #include "DcoLinearConstraint.hpp"
 
+#include "DcoEncoding.hpp"
+
+#include <algorithm>
+#include <vector>
 #include <CoinHelperFunctions.hpp>
 #include <OsiRowCut.hpp>
 
@@ -7,6 +11,7 @@ DcoLinearConstraint::DcoLinearConstraint() {
   size_ = 0;
   indices_ = NULL;
   values_ = NULL;
+  shared_ = false;
 }
 
 DcoLinearConstraint::DcoLinearConstraint(int size, int const * indices,
@@ -14,15 +19,36 @@ DcoLinearConstraint::DcoLinearConstraint(int size, int const * indices,
                                          double ub):
   DcoConstraint(lb, ub) {
   size_ = size;
+  shared_ = false;
   indices_ = new int[size];
   std::copy(indices, indices+size, indices_);
   values_ = new double[size];
   std::copy(values, values+size, values_);
 }
 
+DcoLinearConstraint::DcoLinearConstraint(int size, int const * indices,
+                                         double const * values, double lb,
+                                         double ub, bool shared):
+  DcoConstraint(lb, ub) {
+  size_ = size;
+  shared_ = shared;
+  if (shared_) {
+    // segment is mapped read only, arrays are never written through these.
+    indices_ = const_cast<int*>(indices);
+    values_ = const_cast<double*>(values);
+  }
+  else {
+    indices_ = new int[size];
+    std::copy(indices, indices+size, indices_);
+    values_ = new double[size];
+    std::copy(values, values+size, values_);
+  }
+}
+
 DcoLinearConstraint::DcoLinearConstraint(DcoLinearConstraint const & other):
   DcoConstraint(other) {
   size_ = other.getSize();
+  shared_ = false;
   // set indices
   indices_ = new int[size_];
   int const * other_indices = other.getIndices();
@@ -36,6 +62,7 @@ DcoLinearConstraint::DcoLinearConstraint(DcoLinearConstraint const & other):
 DcoLinearConstraint &
 DcoLinearConstraint::operator=(DcoLinearConstraint const & rhs) {
   size_ = rhs.getSize();
+  shared_ = false;
   // set indices
   indices_ = new int[size_];
   int const * rhs_indices = rhs.getIndices();
@@ -48,6 +75,9 @@ DcoLinearConstraint::operator=(DcoLinearConstraint const & rhs) {
 }
 
 DcoLinearConstraint::~DcoLinearConstraint() {
+  if (shared_) {
+    return;
+  }
   if (indices_) {
     delete[] indices_;
   }
@@ -97,30 +127,37 @@ double DcoLinearConstraint::infeasibility(BcpsModel * m,
 
 /// Encode this to an AlpsEncoded object.
 AlpsReturnStatus DcoLinearConstraint::encode(AlpsEncoded * encoded) {
-  std::cerr << "Not implemented, "
-            << "file: " <<  __FILE__
-            << "line: " << __LINE__
-            << std::endl;
-  throw std::exception();
-  return AlpsReturnStatusOk;
+  DcoEncodeTag(encoded, DcoEncodedTagLinear);
+  AlpsReturnStatus status = encodeBcpsObject(encoded);
+  // sort coefficients by index for delta coding
+  std::vector<std::pair<int, double> > coefs(size_);
+  for (int i=0; i<size_; ++i) {
+    coefs[i] = std::make_pair(indices_[i], values_[i]);
+  }
+  std::sort(coefs.begin(), coefs.end());
+  int * indices = new int[size_];
+  double * values = new double[size_];
+  for (int i=0; i<size_; ++i) {
+    indices[i] = coefs[i].first;
+    values[i] = coefs[i].second;
+  }
+  encoded->writeRep(size_);
+  DcoEncodeIndices(encoded, size_, indices);
+  encoded->writeRep(values, size_);
+  delete[] indices;
+  delete[] values;
+  return status;
 }
 
 /// Decode a given AlpsEncoded object to an AlpsKnowledge object and return a
 /// pointer to it.
 AlpsKnowledge * DcoLinearConstraint::decode(AlpsEncoded & encoded) const {
-  std::cerr << "Not implemented, "
-            << "file: " <<  __FILE__
-            << "line: " << __LINE__
-            << std::endl;
-  throw std::exception();
   DcoLinearConstraint * con = new DcoLinearConstraint();
-  // if (status!=AlpsReturnStatusOk) {
-  //   std::cerr << "Unexpected decode status, "
-  //             << "file: " <<  __FILE__
-  //             << "line: " << __LINE__
-  //             << std::endl;
-  //   throw std::exception();
-  // }
+  AlpsReturnStatus status = con->decodeToSelf(encoded);
+  if (status!=AlpsReturnStatusOk) {
+    delete con;
+    return NULL;
+  }
   return con;
 }
 
@@ -128,10 +165,32 @@ AlpsKnowledge * DcoLinearConstraint::decode(AlpsEncoded & encoded) const {
 // we can overload this function here due to cv-qualifier.
 /// Decode a given AlpsEncoded object into self.
 AlpsReturnStatus DcoLinearConstraint::decodeToSelf(AlpsEncoded & encoded) {
-  std::cerr << "Not implemented, "
-            << "file: " <<  __FILE__
-            << "line: " << __LINE__
-            << std::endl;
-  throw std::exception();
-  return AlpsReturnStatusOk;
+  if (!DcoDecodeTag(encoded, DcoEncodedTagLinear)) {
+    return AlpsReturnStatusErr;
+  }
+  AlpsReturnStatus status = decodeBcpsObject(encoded);
+  if (shared_) {
+    indices_ = NULL;
+    values_ = NULL;
+    shared_ = false;
+  }
+  if (indices_) {
+    delete[] indices_;
+    indices_ = NULL;
+  }
+  if (values_) {
+    delete[] values_;
+    values_ = NULL;
+  }
+  encoded.readRep(size_);
+  indices_ = new int[size_];
+  if (!DcoDecodeIndices(encoded, size_, indices_)) {
+    return AlpsReturnStatusErr;
+  }
+  int num_values;
+  encoded.readRep(values_, num_values);
+  if (num_values!=size_) {
+    return AlpsReturnStatusErr;
+  }
+  return status;
 }
@@ -22,11 +22,18 @@ class DcoLinearConstraint: virtual public DcoConstraint {
   int * indices_;
   /// Values of non-zero coefficients.
   double * values_;
+  /// Indices and values are in the shared model segment, they are not
+  /// owned by this. See DcoSharedModel.
+  bool shared_;
   //@}
 public:
   DcoLinearConstraint();
   DcoLinearConstraint(int size, int const * indices, double const * values,
                       double lb, double ub);
+  /// Constraint with indices and values in the shared model segment. The
+  /// arrays are not copied and are not freed by this.
+  DcoLinearConstraint(int size, int const * indices, double const * values,
+                      double lb, double ub, bool shared);
   DcoLinearConstraint(DcoLinearConstraint const & other);
   DcoLinearConstraint & operator=(DcoLinearConstraint const & rhs);
   virtual ~DcoLinearConstraint();
@@ -2,6 +2,11 @@
 #include "DcoSolution.hpp"
 #include "DcoTreeNode.hpp"
 #include "DcoBranchObject.hpp"
+#include "DcoSosBranchObject.hpp"
+#include "DcoDisjunctionBranchObject.hpp"
+#include "DcoThreadSearch.hpp"
+#include "DcoProcessStats.hpp"
+#include "DcoRacing.hpp"
 
 #if  COIN_HAS_MPI
 #include "AlpsKnowledgeBrokerMPI.h"
@@ -70,16 +75,39 @@ int main(int argc, char *argv[]) {
   broker.registerClass(AlpsKnowledgeTypeNode, new DcoTreeNode);
   broker.registerClass(AlpsKnowledgeTypeNodeDesc, new DcoNodeDesc);
   broker.registerClass(999, new DcoBranchObject(-1, 0.0, 0.0));
+  broker.registerClass(998, new DcoSosBranchObject(-1, -1, 0.0, 0.0));
+  broker.registerClass(997, new DcoDisjunctionBranchObject(-1, 0, NULL, NULL,
+                                                            0.0, 0.0));
 #else
   AlpsKnowledgeBrokerSerial broker(argc, argv, model);
 #endif
 
   // Search for best solution
+#ifdef  COIN_HAS_MPI
+  if (model.dcoPar()->entry(DcoParams::rampUpRace)) {
+    // pick parameters by racing variants, collective
+    DcoRacing racing(&model);
+    racing.race();
+  }
   broker.search(&model);
+  // statistics of all processes, collective
+  model.processStats()->report();
+#else
+  int num_threads = model.dcoPar()->entry(DcoParams::numThreads);
+  if (num_threads>1) {
+    DcoThreadSearch thread_search(&model, num_threads);
+    thread_search.search();
+  }
+  else {
+    broker.search(&model);
+  }
+#endif
   // Report the best solution found and its ojective value
   broker.printBestSolution();
 
   model.reportFeasibility();
+  // keep pseudocosts for the next run
+  model.writeBranchHistory();
   delete solver;
   return 0;
 }
@@ -123,6 +123,7 @@ static Dco_message us_english[]=
     {DISCO_READ_ROTATEDCONESIZE, 9004, 1, "Rotated cones should have at least 3 members."},
     {DISCO_READ_CONESTATS1, 101, 3, "Problem has %d cones."},
     {DISCO_READ_CONESTATS2, 102, 3, "Cone %d has %d entries (type %d)"},
+    {DISCO_READ_SOSSTATS, 104, 1, "Problem has %d SOS sets."},
     {DISCO_PROBLEM_INFO, 103, 1, "Problem info.\n"
      "  Problem name: %s\n"
      "  Objective sense: %s\n"
@@ -131,6 +132,7 @@ static Dco_message us_english[]=
      "  Number of nonzero in coefficient matrix: %d\n"
      "  Number of conic constraints: %d\n"
      "  Number of integer variables: %d"},
+    {DISCO_PREPROCESS_SUMMARY, 105, 1, "Cones approximated with %d IPM iterations, %d IPM cuts, %d OA iterations, %d OA cuts. Linear relaxation objective value %g."},
     // tree node
     {DISCO_NODE_BRANCHONINT, 9201, 1, "[%d] Branched on integer variable. Variable index %d."},
     {DISCO_NODE_UNEXPECTEDSTATUS,9202,1, "[%d] Unexpected node status %d"},
@@ -142,8 +144,13 @@ static Dco_message us_english[]=
      "[%d] BCP function decided to keep bounding %d, branch %d, generate cons %d."},
     {DISCO_NODE_BRANCH, 206, DISCO_DLOG_BRANCH,
      "[%d] Branching node %d, variable %d, value %f, score %f."},
+    {DISCO_NODE_BRANCH_SOS, 209, DISCO_DLOG_BRANCH,
+     "[%d] Branching node %d, SOS set %d, separator %d."},
+    {DISCO_NODE_BRANCH_DISJUNCTION, 210, DISCO_DLOG_BRANCH,
+     "[%d] Branching node %d, disjunction of row %d, activity %f."},
     {DISCO_NODE_ENCODED, 207, DISCO_DLOG_MPI, "[%d] Node %d encoded."},
     {DISCO_NODE_DECODED, 208, DISCO_DLOG_MPI, "[%d] Node decoded into %d."},
+    {DISCO_NODE_ENCODE_STATS, 211, 1, "[%d] Encoded %d %s nodes, %.0f bytes, %.1f bytes per node."},
     // constraint generation
     {DISCO_INVALID_CUT_FREQUENCY,9301,1, "%d is not a valid cut frequency, changed it to %d."},
     {DISCO_INEFFECTIVE_CUT, 302, DISCO_DLOG_CUT, "[%d] Node %d, cut is ignored since the activity is low."},
@@ -162,11 +169,23 @@ static Dco_message us_english[]=
     {DISCO_INVALID_HEUR_FREQUENCY, 9501, 1, "%d is not a valid heuristic frequency, changed it to %d."},
     {DISCO_HEUR_SOL_FOUND, 504, DISCO_DLOG_HEURISTIC, "[%d] %s heuristic found solution, quality %f."},
     {DISCO_HEUR_NOSOL_FOUND, 505, DISCO_DLOG_HEURISTIC, "[%d] %s heuristic is called and no solution is found."},
+    {DISCO_HEUR_FP_STATS, 506, DISCO_DLOG_HEURISTIC, "[%d] Feasibility pump, %d iterations, %d perturbations, solution found %d."},
+    {DISCO_HEUR_DIVE_STATS, 507, DISCO_DLOG_HEURISTIC, "[%d] %s diving, depth %d, %d iterations, solution found %d."},
+    {DISCO_HEUR_LNS_STATS, 508, DISCO_DLOG_HEURISTIC, "[%d] %s fixed %d integer columns, nested search processed %d nodes, solution found %d."},
+    {DISCO_HEUR_REPAIR, 509, DISCO_DLOG_HEURISTIC, "[%d] Conic repair of integer feasible point, solution found %d."},
+    {DISCO_HEUR_THREAD_STATS, 510, 1, "Heuristic thread searched %d node solutions, dropped %d, found %d solutions, wall clock time %.4f seconds"},
+    {DISCO_HEUR_LOCK_STATS, 511, DISCO_DLOG_HEURISTIC, "[%d] Lock rounding, %d columns rounded without locks, %d with locks, %d shifts, solution found %d."},
+    {DISCO_HEUR_START_READ, 512, 1, "Read start values of %d columns from %s, %d names unknown, %d integer columns completed, solution found %d."},
+    {DISCO_HEUR_START_FAILED, 6512, 1, "Could not open start solution file %s."},
     // branch strategies
     {DISCO_PSEUDO_REPORT, 551, DISCO_DLOG_BRANCH, "[%d] Pseudocost score of variable %d is %f."},
     {DISCO_PSEUDO_DUP, 552, DISCO_DLOG_BRANCH, "[%d] Updating down pseudocost of %d from %f to %f, frac value %f."},
     {DISCO_PSEUDO_UUP, 553, DISCO_DLOG_BRANCH, "[%d] Updating up pseudocost of %d from %f to %f, frac value %f."},
     {DISCO_STRONG_REPORT, 554, DISCO_DLOG_BRANCH, "[%d] Strong score of variable %d is %f."},
+    {DISCO_BRANCH_HISTORY_READ, 555, 1, "Read branching history of %d columns from %s, decay weight %g."},
+    {DISCO_BRANCH_HISTORY_WRITE, 556, 1, "Wrote branching history of %d columns to %s."},
+    {DISCO_BRANCH_HISTORY_FAILED, 6555, 1, "Could not open branching history file %s."},
+    {DISCO_STRONG_OA_UPDATE, 557, DISCO_DLOG_BRANCH, "[%d] OA LP for strong branching has %d rows, %d supports added."},
 
     // grumpy messages
     // time, node status, node id, parent id, branch direction, obj val [,sum
@@ -177,6 +196,28 @@ static Dco_message us_english[]=
     // Parallelization related messages
     {DISCO_UNEXPECTED_ENCODE_STATUS, 9601, 0, "Unexpected encode return value, file: %s, line: %d."},
     {DISCO_UNEXPECTED_DECODE_STATUS, 9602, 0, "Unexpected decode return value, file: %s, line: %d."},
+    {DISCO_THREAD_RAMPUP, 611, 1, "Threaded search with %d threads, root split into %d subtrees, %d relaxations solved."},
+    {DISCO_THREAD_STATS, 612, 1, "Threaded search with %d threads searched %d subtrees, %d pruned, %d not completed, %d nodes processed, wall clock time %.4f seconds."},
+    {DISCO_THREAD_INCOMPLETE, 625, 1, "Threaded search stopped by %s limit with %d subtrees open, best bound %g."},
+    {DISCO_LAZY_MODEL_READ, 613, 1, "[%d] Read model from %s, %d rows received from the master."},
+    {DISCO_LAZY_MODEL_MISMATCH, 9603, 0, "[%d] Model read from %s does not match the model of the master."},
+    {DISCO_PROC_STATS, 614, 1, "[%d] %d nodes, node time %.2f, relaxation time %.2f, idle time %.2f, %d cuts, %d solutions."},
+    {DISCO_PAR_STATS_HEADER, 615, 1, "Process  Nodes      Node time    Relax time   Idle time    Cuts       Solutions"},
+    {DISCO_PAR_STATS_PROC, 616, 1, "%-8d %-10d %-12.2f %-12.2f %-12.2f %-10d %d"},
+    {DISCO_PAR_STATS_BALANCE, 617, 1, "Nodes per process min %d, max %d, mean %.1f. Idle %.1f%% of wall clock time."},
+    {DISCO_RACE_RESULT, 618, 1, "[%d] Race variant %s, %d nodes, bound %g, incumbent %g, gap %.2f%%."},
+    {DISCO_RACE_WINNER, 619, 1, "Race won by variant %s, search continues with its parameters."},
+    {DISCO_CHECKPOINT_WRITE, 620, 1, "Checkpoint with %d open nodes written to %s."},
+    {DISCO_CHECKPOINT_RESTART, 621, 1, "Restarting from checkpoint %s with %d open nodes."},
+    {DISCO_CHECKPOINT_FAILED, 9604, 0, "Checkpoint file %s can not be written."},
+    {DISCO_CHECKPOINT_READ_FAILED, 9605, 0, "Checkpoint file %s can not be read or is written for a different model, search starts from the root."},
+    {DISCO_NODE_SPILL, 622, 1, "[%d] Spilled %d nodes to %s, %d nodes on disk, open nodes use %.1f MB."},
+    {DISCO_NODE_SPILL_FAILED, 9606, 0, "[%d] Node spill file %s can not be written, spilling is disabled."},
+    {DISCO_NODE_SPILL_READ_FAILED, 9607, 0, "[%d] Node spill file %s can not be read."},
+    {DISCO_SHARED_MODEL_CREATE, 623, 1, "[%d] Model data is in shared memory segment %s, %.1f MB."},
+    {DISCO_SHARED_MODEL_ATTACH, 624, 3, "[%d] Mapped shared memory segment %s."},
+    {DISCO_SHARED_MODEL_FAILED, 9608, 0, "[%d] Shared memory segment %s can not be used, model data is kept by this process."},
+    {DISCO_SHARED_MODEL_STALE, 626, 1, "[%d] Removed shared memory segment %s left by a process that ended."},
     // general messages
     {DISCO_INFEAS_REPORT, 603, DISCO_DLOG_PROCESS, "[%d] Column infeas %f, row infeas %f."},
     {DISCO_SOL_FOUND, 604, DISCO_DLOG_PROCESS, "[%d] Solution found, quality %f."},
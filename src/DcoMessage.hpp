@@ -61,7 +61,9 @@ enum DISCO_Message {
     DISCO_READ_ROTATEDCONESIZE,
     DISCO_READ_CONESTATS1,
     DISCO_READ_CONESTATS2,
+    DISCO_READ_SOSSTATS,
     DISCO_PROBLEM_INFO,
+    DISCO_PREPROCESS_SUMMARY,
     // tree node
     DISCO_NODE_BRANCHONINT,
     DISCO_NODE_UNEXPECTEDSTATUS,
@@ -69,8 +71,11 @@ enum DISCO_Message {
     DISCO_NODE_FATHOM,
     DISCO_NODE_BCP_DECISION,
     DISCO_NODE_BRANCH,
+    DISCO_NODE_BRANCH_SOS,
+    DISCO_NODE_BRANCH_DISJUNCTION,
     DISCO_NODE_ENCODED,
     DISCO_NODE_DECODED,
+    DISCO_NODE_ENCODE_STATS,
     // constraint generation
     DISCO_INVALID_CUT_FREQUENCY,
     DISCO_INEFFECTIVE_CUT,
@@ -88,11 +93,23 @@ enum DISCO_Message {
     DISCO_INVALID_HEUR_FREQUENCY,
     DISCO_HEUR_SOL_FOUND,
     DISCO_HEUR_NOSOL_FOUND,
+    DISCO_HEUR_FP_STATS,
+    DISCO_HEUR_DIVE_STATS,
+    DISCO_HEUR_LNS_STATS,
+    DISCO_HEUR_REPAIR,
+    DISCO_HEUR_THREAD_STATS,
+    DISCO_HEUR_LOCK_STATS,
+    DISCO_HEUR_START_READ,
+    DISCO_HEUR_START_FAILED,
     // branch strategies
     DISCO_PSEUDO_REPORT,
     DISCO_PSEUDO_DUP,
     DISCO_PSEUDO_UUP,
     DISCO_STRONG_REPORT,
+    DISCO_BRANCH_HISTORY_READ,
+    DISCO_BRANCH_HISTORY_WRITE,
+    DISCO_BRANCH_HISTORY_FAILED,
+    DISCO_STRONG_OA_UPDATE,
     // grumpy messages
     DISCO_GRUMPY_MESSAGE_LONG,
     DISCO_GRUMPY_MESSAGE_MED,
@@ -100,6 +117,28 @@ enum DISCO_Message {
     // Parallelization related messages
     DISCO_UNEXPECTED_ENCODE_STATUS,
     DISCO_UNEXPECTED_DECODE_STATUS,
+    DISCO_THREAD_RAMPUP,
+    DISCO_THREAD_STATS,
+    DISCO_THREAD_INCOMPLETE,
+    DISCO_LAZY_MODEL_READ,
+    DISCO_LAZY_MODEL_MISMATCH,
+    DISCO_PROC_STATS,
+    DISCO_PAR_STATS_HEADER,
+    DISCO_PAR_STATS_PROC,
+    DISCO_PAR_STATS_BALANCE,
+    DISCO_RACE_RESULT,
+    DISCO_RACE_WINNER,
+    DISCO_CHECKPOINT_WRITE,
+    DISCO_CHECKPOINT_RESTART,
+    DISCO_CHECKPOINT_FAILED,
+    DISCO_CHECKPOINT_READ_FAILED,
+    DISCO_NODE_SPILL,
+    DISCO_NODE_SPILL_FAILED,
+    DISCO_NODE_SPILL_READ_FAILED,
+    DISCO_SHARED_MODEL_CREATE,
+    DISCO_SHARED_MODEL_ATTACH,
+    DISCO_SHARED_MODEL_FAILED,
+    DISCO_SHARED_MODEL_STALE,
     // more general messages
     DISCO_INFEAS_REPORT,
     DISCO_SOL_FOUND,
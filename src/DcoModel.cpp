@@ -1,5 +1,10 @@
 // CoinUtils
 #include <CoinMpsIO.hpp>
+#include <CoinSort.hpp>
+
+// Osi headers
+#include <OsiClpSolverInterface.hpp>
+#include <OsiCuts.hpp>
 
 // Disco headers
 #include "DcoModel.hpp"
@@ -19,6 +24,21 @@
 #include "DcoPresolve.hpp"
 #include "DcoHeuristic.hpp"
 #include "DcoHeurRounding.hpp"
+#include "DcoHeurFeasibilityPump.hpp"
+#include "DcoHeurDiving.hpp"
+#include "DcoHeurLns.hpp"
+#include "DcoHeurConicRepair.hpp"
+#include "DcoHeurStartSolution.hpp"
+#include "DcoHeurScheduler.hpp"
+#include "DcoHeurWorker.hpp"
+#include "DcoSolutionPool.hpp"
+#include "DcoProcessStats.hpp"
+#include "DcoCheckpoint.hpp"
+#include "DcoNodeSpill.hpp"
+#include "DcoSharedModel.hpp"
+
+#include <AlpsNodePool.h>
+#include <AlpsSubTree.h>
 
 // MILP cuts
 #include <CglCutGenerator.hpp>
@@ -43,11 +63,31 @@
 #include <fstream>
 #include <sstream>
 #include <numeric>
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 
+// Maximum number of cone support rounds of repairSolution() in OA builds.
+#define DISCO_REPAIR_MAX_ROUNDS 20
+
 DcoModel::DcoModel() {
   solver_ = NULL;
+  oaSolver_ = NULL;
+  numOaBaseRows_ = 0;
+  numOaRows_ = 0;
+  numRelaxIterations_ = 0;
+  numEncodedNodes_[0] = 0;
+  numEncodedNodes_[1] = 0;
+  numEncodedBytes_[0] = 0;
+  numEncodedBytes_[1] = 0;
+  heurScheduler_ = NULL;
+  heurWorker_ = NULL;
+  solutionPool_ = NULL;
+  threadSearch_ = NULL;
+  processStats_ = NULL;
+  checkpoint_ = NULL;
+  nodeSpill_ = NULL;
+  sharedModel_ = NULL;
   colLB_ = NULL;
   colUB_ = NULL;
   rowLB_ = NULL;
@@ -62,9 +102,17 @@ DcoModel::DcoModel() {
   integerCols_ = NULL;
   isInteger_ = NULL;
   matrix_ = NULL;
+  matrixByCol_ = NULL;
   coneStart_ = NULL;
   coneMembers_ = NULL;
   coneType_ = NULL;
+  numSos_ = 0;
+  sosStart_ = NULL;
+  sosMembers_ = NULL;
+  sosWeights_ = NULL;
+  sosType_ = NULL;
+  numInstanceRows_ = 0;
+  instanceHash_ = 0;
 
   dcoPar_ = new DcoParams();
   numRelaxedCols_ = 0;
@@ -88,6 +136,21 @@ DcoModel::DcoModel() {
 
 DcoModel::~DcoModel() {
   // solver_ is freed in main function.
+  if (sharedModel_) {
+    // data in the segment is freed with sharedModel_.
+    rowLB_ = NULL;
+    rowUB_ = NULL;
+    objCoef_ = NULL;
+    matrix_ = NULL;
+    matrixByCol_ = NULL;
+    coneStart_ = NULL;
+    coneMembers_ = NULL;
+    coneType_ = NULL;
+  }
+  if (oaSolver_) {
+    delete oaSolver_;
+    oaSolver_=NULL;
+  }
   if (colLB_) {
     delete[] colLB_;
     colLB_=NULL;
@@ -120,6 +183,10 @@ DcoModel::~DcoModel() {
     delete matrix_;
     matrix_=NULL;
   }
+  if (matrixByCol_) {
+    delete matrixByCol_;
+    matrixByCol_=NULL;
+  }
   if (coneStart_) {
     delete[] coneStart_;
     coneStart_=NULL;
@@ -132,6 +199,22 @@ DcoModel::~DcoModel() {
     delete[] coneType_;
     coneType_=NULL;
   }
+  if (sosStart_) {
+    delete[] sosStart_;
+    sosStart_=NULL;
+  }
+  if (sosMembers_) {
+    delete[] sosMembers_;
+    sosMembers_=NULL;
+  }
+  if (sosWeights_) {
+    delete[] sosWeights_;
+    sosWeights_=NULL;
+  }
+  if (sosType_) {
+    delete[] sosType_;
+    sosType_=NULL;
+  }
   if (branchStrategy_) {
     delete branchStrategy_;
     branchStrategy_=NULL;
@@ -170,6 +253,35 @@ DcoModel::~DcoModel() {
     delete *it;
   }
   heuristics_.clear();
+  if (heurScheduler_) {
+    delete heurScheduler_;
+    heurScheduler_ = NULL;
+  }
+  if (heurWorker_) {
+    delete heurWorker_;
+    heurWorker_ = NULL;
+  }
+  if (solutionPool_) {
+    delete solutionPool_;
+    solutionPool_ = NULL;
+  }
+  if (processStats_) {
+    delete processStats_;
+    processStats_ = NULL;
+  }
+  if (checkpoint_) {
+    delete checkpoint_;
+    checkpoint_ = NULL;
+  }
+  if (nodeSpill_) {
+    delete nodeSpill_;
+    nodeSpill_ = NULL;
+  }
+  // constraints referring to the segment do not touch it when freed.
+  if (sharedModel_) {
+    delete sharedModel_;
+    sharedModel_ = NULL;
+  }
 }
 
 #if defined(__OA__)
@@ -201,7 +313,10 @@ void DcoModel::readInstance(char const * dataFile) {
   // set reader log level
   //reader->messageHandler()->setLogLevel(dcoPar_->entry(DcoParams::logLevel));
   reader->messageHandler()->setLogLevel(0);
-  reader->readMps(dataFile, "");
+  // read SOS sets too, they are discarded by readMps(dataFile, "")
+  int num_sets = 0;
+  CoinSet ** sets = NULL;
+  reader->readMps(dataFile, "", num_sets, sets);
   numCols_ = reader->getNumCols();
 
   // allocate variable bounds
@@ -220,6 +335,12 @@ void DcoModel::readInstance(char const * dataFile) {
   double const * reader_obj = reader->getObjCoefficients();
   std::copy(reader_obj, reader_obj+numCols_, objCoef_);
 
+  // set column names
+  colNames_.resize(numCols_);
+  for (int i=0; i<numCols_; ++i) {
+    colNames_[i] = reader->columnName(i);
+  }
+
   // set integer columns
   // get variable integrality constraints
   numIntegerCols_ = 0;
@@ -264,6 +385,42 @@ void DcoModel::readInstance(char const * dataFile) {
   delete[] integerCols_;
   integerCols_ = temp;
 
+  // set SOS sets, members are sorted with respect to weights.
+  numSos_ = num_sets;
+  if (numSos_) {
+    sosStart_ = new int[numSos_+1];
+    sosType_ = new int[numSos_];
+    sosStart_[0] = 0;
+    for (int i=0; i<numSos_; ++i) {
+      sosStart_[i+1] = sosStart_[i] + sets[i]->numberEntries();
+      sosType_[i] = sets[i]->setType();
+    }
+    sosMembers_ = new int[sosStart_[numSos_]];
+    sosWeights_ = new double[sosStart_[numSos_]];
+    for (int i=0; i<numSos_; ++i) {
+      int start = sosStart_[i];
+      int size = sets[i]->numberEntries();
+      std::copy(sets[i]->which(), sets[i]->which()+size, sosMembers_+start);
+      if (sets[i]->weights()) {
+        std::copy(sets[i]->weights(), sets[i]->weights()+size,
+                  sosWeights_+start);
+      }
+      else {
+        for (int k=0; k<size; ++k) {
+          sosWeights_[start+k] = k;
+        }
+      }
+      CoinSort_2(sosWeights_+start, sosWeights_+start+size,
+                 sosMembers_+start);
+    }
+    dcoMessageHandler_->message(DISCO_READ_SOSSTATS, *dcoMessages_)
+      << numSos_ << CoinMessageEol;
+  }
+  for (int i=0; i<num_sets; ++i) {
+    delete sets[i];
+  }
+  delete[] sets;
+
   // read conic part
   int reader_return = reader->readConicMps(NULL, coneStart_, coneMembers_,
                                            coneType_, numConicRows_);
@@ -322,6 +479,52 @@ void DcoModel::readInstance(char const * dataFile) {
     << CoinMessageEol;
   // free Coin MPS reader
   delete reader;
+  // identify the instance, workers reading the file compare hashes
+  numInstanceRows_ = numLinearRows_;
+  instanceHash_ = computeInstanceHash();
+}
+
+// FNV-1a hash of size bytes of data, combined into hash.
+static void hashBytes(unsigned long long & hash, void const * data,
+                      size_t size) {
+  unsigned char const * bytes = static_cast<unsigned char const *>(data);
+  for (size_t i=0; i<size; ++i) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+}
+
+unsigned long long DcoModel::computeInstanceHash() const {
+  unsigned long long hash = 14695981039346656037ULL;
+  hashBytes(hash, &numCols_, sizeof(int));
+  hashBytes(hash, &numInstanceRows_, sizeof(int));
+  hashBytes(hash, &numConicRows_, sizeof(int));
+  hashBytes(hash, colLB_, sizeof(double)*numCols_);
+  hashBytes(hash, colUB_, sizeof(double)*numCols_);
+  hashBytes(hash, objCoef_, sizeof(double)*numCols_);
+  hashBytes(hash, isInteger_, sizeof(int)*numCols_);
+  hashBytes(hash, rowLB_, sizeof(double)*numInstanceRows_);
+  hashBytes(hash, rowUB_, sizeof(double)*numInstanceRows_);
+  for (int i=0; i<numInstanceRows_; ++i) {
+    CoinShallowPackedVector row = matrix_->getVector(i);
+    int size = row.getNumElements();
+    hashBytes(hash, &size, sizeof(int));
+    hashBytes(hash, row.getIndices(), sizeof(int)*size);
+    hashBytes(hash, row.getElements(), sizeof(double)*size);
+  }
+  if (numConicRows_) {
+    hashBytes(hash, coneStart_, sizeof(int)*(numConicRows_+1));
+    hashBytes(hash, coneType_, sizeof(int)*numConicRows_);
+    hashBytes(hash, coneMembers_, sizeof(int)*coneStart_[numConicRows_]);
+  }
+  hashBytes(hash, &numSos_, sizeof(int));
+  if (numSos_) {
+    hashBytes(hash, sosStart_, sizeof(int)*(numSos_+1));
+    hashBytes(hash, sosType_, sizeof(int)*numSos_);
+    hashBytes(hash, sosMembers_, sizeof(int)*sosStart_[numSos_]);
+    hashBytes(hash, sosWeights_, sizeof(double)*sosStart_[numSos_]);
+  }
+  return hash;
 }
 
 
@@ -360,9 +563,19 @@ void DcoModel::setupAddLinearConstraints() {
   int const * lengths = matrix_->getVectorLengths();
   int const * starts = matrix_->getVectorStarts();
   for (int i=0; i<numLinearRows_; ++i) {
-    constraints[i] = new DcoLinearConstraint(lengths[i], indices+starts[i],
-                                             values+starts[i], rowLB_[i],
-                                             rowUB_[i]);
+    if (sharedModel_) {
+      // refer to the row in shared memory, do not copy it.
+      constraints[i] = new DcoLinearConstraint(sharedModel_->rowSize(i),
+                                               sharedModel_->rowIndices(i),
+                                               sharedModel_->rowValues(i),
+                                               rowLB_[i], rowUB_[i], true);
+    }
+    else {
+      constraints[i] = new DcoLinearConstraint(lengths[i],
+                                               indices+starts[i],
+                                               values+starts[i], rowLB_[i],
+                                               rowUB_[i]);
+    }
     constraints[i]->setBroker(broker_);
   }
   setConstraints(constraints, numLinearRows_);
@@ -522,14 +735,13 @@ void DcoModel::approximateCones() {
     iter++;
   }
   oa_iter = iter;
-  std::cout << "===== Preprocessing Summary =====" << std::endl;
-  std::cout << "IPM iterations " << ipm_iter << std::endl;
-  std::cout << "IPM cuts " << num_ipm_cuts << std::endl;
-  std::cout << "OA iterations " << oa_iter << std::endl;
-  std::cout << "OA cuts " << num_oa_cuts << std::endl;
-  std::cout << "Linear relaxation objective value "
-            << solver_->getObjValue() << std::endl;
-  std::cout << "=================================" << std::endl;
+  dcoMessageHandler_->message(DISCO_PREPROCESS_SUMMARY, *dcoMessages_)
+    << ipm_iter
+    << num_ipm_cuts
+    << oa_iter
+    << num_oa_cuts
+    << solver_->getObjValue()
+    << CoinMessageEol;
   delete[] coneTypes;
   delete[] coneSizes;
   delete[] coneMembers;
@@ -554,6 +766,286 @@ void DcoModel::approximateCones() {
 #endif
 }
 
+void DcoModel::setupOaSolver() {
+  oaSolver_ = new OsiClpSolverInterface();
+  oaSolver_->setHintParam(OsiDoInBranchAndCut, true, OsiHintDo, NULL);
+  oaSolver_->messageHandler()->setLogLevel(0);
+  oaSolver_->loadProblem(*matrix_, colLB_, colUB_, objCoef_,
+                         rowLB_, rowUB_);
+  // set leading variable lower bounds to 0
+  for (int i=0; i<numConicRows_; ++i) {
+    oaSolver_->setColLower(coneMembers_[coneStart_[i]], 0.0);
+    if (coneType_[i]==2) {
+      oaSolver_->setColLower(coneMembers_[coneStart_[i]+1], 0.0);
+    }
+  }
+  // initial approximation of the cones. Lorentz cone x_1 >= |x_{2:n}|
+  // implies x_1 >= |x_k|, rotated cone implies (x_1+x_2)/sqrt(2) >= |x_k|,
+  // the LP is bounded in the cone directions.
+  OsiCuts seeds;
+  for (int i=0; i<numConicRows_; ++i) {
+    int size = coneStart_[i+1] - coneStart_[i];
+    int const * members = coneMembers_ + coneStart_[i];
+    int num_leading = (coneType_[i]==2) ? 2 : 1;
+    double scale = (coneType_[i]==2) ? 1.0/sqrt(2.0) : 1.0;
+    int ind[3];
+    double val[3];
+    for (int k=num_leading; k<size; ++k) {
+      for (int j=0; j<num_leading; ++j) {
+        ind[j] = members[j];
+        val[j] = scale;
+      }
+      ind[num_leading] = members[k];
+      for (int sign=-1; sign<=1; sign+=2) {
+        val[num_leading] = sign;
+        OsiRowCut cut;
+        cut.setRow(num_leading+1, ind, val);
+        cut.setLb(0.0);
+        cut.setUb(DISCO_INFINITY);
+        seeds.insert(cut);
+      }
+    }
+  }
+  oaSolver_->applyCuts(seeds);
+  // supports at the LP solution, approxNumPass rounds as in
+  // approximateCones() of OA builds.
+  oaSolver_->initialSolve();
+  int num_pass = dcoPar_->entry(DcoParams::approxNumPass);
+  for (int pass=0; pass<num_pass and oaSolver_->isProvenOptimal(); ++pass) {
+    OsiCuts supports;
+    double const * sol = oaSolver_->getColSolution();
+    if (coneSupports(sol, sol, supports)==0) {
+      break;
+    }
+    oaSolver_->applyCuts(supports);
+    oaSolver_->resolve();
+  }
+  numOaBaseRows_ = oaSolver_->getNumRows();
+  numOaRows_ = 0;
+}
+
+OsiSolverInterface * DcoModel::lpSolver() {
+  if (oaSolver_) {
+    return oaSolver_;
+  }
+  return solver_;
+}
+
+void DcoModel::updateOaSolver() {
+  if (oaSolver_==NULL) {
+    return;
+  }
+  // 1. remove rows of the previous node
+  int num_node_rows = oaSolver_->getNumRows() - numOaBaseRows_ - numOaRows_;
+  if (num_node_rows > 0) {
+    int * indices = new int[num_node_rows];
+    for (int i=0; i<num_node_rows; ++i) {
+      indices[i] = numOaBaseRows_ + numOaRows_ + i;
+    }
+    oaSolver_->deleteRows(num_node_rows, indices);
+    delete[] indices;
+  }
+  // 2. column bounds of the node
+  oaSolver_->setColLower(solver_->getColLower());
+  oaSolver_->setColUpper(solver_->getColUpper());
+  // 3. rows of the node, cuts and branching constraints installed after the
+  // core linear rows.
+  OsiCuts node_rows;
+  int num_solver_rows = solver_->getNumRows();
+  CoinPackedMatrix const * solver_matrix = solver_->getMatrixByRow();
+  for (int i=numLinearRows_; i<num_solver_rows; ++i) {
+    OsiRowCut row;
+    row.setRow(solver_matrix->getVector(i));
+    row.setLb(solver_->getRowLower()[i]);
+    row.setUb(solver_->getRowUpper()[i]);
+    node_rows.insert(row);
+  }
+  oaSolver_->applyCuts(node_rows);
+  oaSolver_->resolve();
+  // 4. add supports of cones at the conic solution if they cut the LP
+  // solution. Supports are valid globally, keep them before the node rows.
+  OsiCuts supports;
+  int num_supports = coneSupports(solver_->getColSolution(),
+                                  oaSolver_->getColSolution(), supports);
+  int max_supports = dcoPar_->entry(DcoParams::strongBranchOaMaxSupports);
+  if (num_supports > max_supports) {
+    OsiCuts first;
+    for (int i=0; i<max_supports; ++i) {
+      first.insert(supports.rowCut(i));
+    }
+    supports = first;
+    num_supports = max_supports;
+  }
+  if (num_supports > 0) {
+    // node rows and the supports that make room for the new ones
+    std::vector<int> indices;
+    int num_remove = numOaRows_ + num_supports - max_supports;
+    if (num_remove > 0) {
+      // supports slack at the LP solution first, then tight ones, oldest
+      // first. Supports are x >= 0 rows.
+      double tol = dcoPar_->entry(DcoParams::coneTol);
+      double const * activity = oaSolver_->getRowActivity();
+      std::vector<char> removed(numOaRows_, 0);
+      for (int pass=0; pass<2; ++pass) {
+        for (int i=0; i<numOaRows_ and
+               static_cast<int>(indices.size())<num_remove; ++i) {
+          if (!removed[i] and
+              (pass==1 or activity[numOaBaseRows_+i] > tol)) {
+            removed[i] = 1;
+            indices.push_back(numOaBaseRows_+i);
+          }
+        }
+      }
+      std::sort(indices.begin(), indices.end());
+    }
+    num_node_rows = node_rows.sizeRowCuts();
+    for (int i=0; i<num_node_rows; ++i) {
+      indices.push_back(numOaBaseRows_ + numOaRows_ + i);
+    }
+    numOaRows_ -= num_remove > 0 ? num_remove : 0;
+    if (!indices.empty()) {
+      oaSolver_->deleteRows(static_cast<int>(indices.size()), &indices[0]);
+    }
+    oaSolver_->applyCuts(supports);
+    numOaRows_ += num_supports;
+    oaSolver_->applyCuts(node_rows);
+    oaSolver_->resolve();
+  }
+  dcoMessageHandler_->message(DISCO_STRONG_OA_UPDATE, *dcoMessages_)
+    << broker()->getProcRank()
+    << oaSolver_->getNumRows()
+    << num_supports
+    << CoinMessageEol;
+}
+
+// Support of Lorentz cone x_1 >= |x_{2:n}| at point x* is
+// x_1 - sum_i (x*_i/r) x_i >= 0 where r = |x*_{2:n}|. Rotated cone
+// 2x_1x_2 >= |x_{3:n}|^2 is the Lorentz cone
+// (x_1+x_2)/sqrt(2) >= |((x_1-x_2)/sqrt(2), x_{3:n})|.
+int DcoModel::coneSupports(double const * sol, double const * lp_sol,
+                           OsiCuts & cuts) const {
+  double tol = dcoPar_->entry(DcoParams::coneTol);
+  int num_cuts = 0;
+  for (int i=0; i<numConicRows_; ++i) {
+    int size = coneStart_[i+1] - coneStart_[i];
+    int const * members = coneMembers_ + coneStart_[i];
+    int * ind = new int[size];
+    double * val = new double[size];
+    std::copy(members, members+size, ind);
+    if (coneType_[i]==1) {
+      double r = 0.0;
+      for (int k=1; k<size; ++k) {
+        r += sol[members[k]]*sol[members[k]];
+      }
+      r = sqrt(r);
+      if (r < tol) {
+        // support is not unique at the apex
+        delete[] ind;
+        delete[] val;
+        continue;
+      }
+      val[0] = 1.0;
+      for (int k=1; k<size; ++k) {
+        val[k] = -sol[members[k]]/r;
+      }
+    }
+    else {
+      double u = (sol[members[0]] - sol[members[1]])/sqrt(2.0);
+      double r = u*u;
+      for (int k=2; k<size; ++k) {
+        r += sol[members[k]]*sol[members[k]];
+      }
+      r = sqrt(r);
+      if (r < tol) {
+        delete[] ind;
+        delete[] val;
+        continue;
+      }
+      val[0] = 1.0 - u/r;
+      val[1] = 1.0 + u/r;
+      for (int k=2; k<size; ++k) {
+        val[k] = -sqrt(2.0)*sol[members[k]]/r;
+      }
+    }
+    // activity of the support at the LP solution
+    double activity = 0.0;
+    for (int k=0; k<size; ++k) {
+      activity += val[k]*lp_sol[ind[k]];
+    }
+    if (activity < -tol) {
+      OsiRowCut cut;
+      cut.setRow(size, ind, val);
+      cut.setLb(0.0);
+      cut.setUb(DISCO_INFINITY);
+      cuts.insert(cut);
+      num_cuts++;
+    }
+    delete[] ind;
+    delete[] val;
+  }
+  return num_cuts;
+}
+
+#if defined(__OA__)
+OsiSolverInterface * DcoModel::cloneSolver(bool copy_data) const {
+  OsiSolverInterface * solver = solver_->clone(copy_data);
+#else
+OsiConicSolverInterface * DcoModel::cloneSolver(bool copy_data) const {
+  OsiConicSolverInterface * solver =
+    dynamic_cast<OsiConicSolverInterface*>(solver_->clone(copy_data));
+#endif
+  solver->messageHandler()->setLogLevel(0);
+  return solver;
+}
+
+bool DcoModel::relaxationInfeasible(OsiSolverInterface const * solver) const {
+  return !solver->isProvenOptimal() or solver->getObjValue()>=1e+30;
+}
+
+DcoSolution * DcoModel::repairSolution(OsiSolverInterface * solver,
+                                       double const * point,
+                                       double cutoff) const {
+  // fix integer columns
+  for (int i=0; i<numIntegerCols_; ++i) {
+    int col = integerCols_[i];
+    double value = floor(point[col]+0.5);
+    value = CoinMax(solver->getColLower()[col],
+                    CoinMin(solver->getColUpper()[col], value));
+    solver->setColBounds(col, value, value);
+  }
+  solver->resolve();
+  bool feasible = false;
+#if defined(__OA__)
+  // add supports of violated cones until the solution is cone feasible
+  for (int round=0; round<DISCO_REPAIR_MAX_ROUNDS; ++round) {
+    if (relaxationInfeasible(solver)) {
+      break;
+    }
+    OsiCuts supports;
+    double const * sol = solver->getColSolution();
+    if (coneSupports(sol, sol, supports)==0) {
+      feasible = true;
+      break;
+    }
+    solver->applyCuts(supports);
+    solver->resolve();
+  }
+#else
+  feasible = !relaxationInfeasible(solver);
+#endif
+  if (!feasible) {
+    return NULL;
+  }
+  double quality = solver->getObjSense()*solver->getObjValue();
+  if (quality>=cutoff) {
+    return NULL;
+  }
+  DcoSolution * dco_sol = new DcoSolution(solver->getNumCols(),
+                                          solver->getColSolution(), quality);
+  dco_sol->setBroker(broker_);
+  return dco_sol;
+}
+
 //todo(aykut) why does this return to bool?
 // should be fixed in Alps level.
 
@@ -618,6 +1110,39 @@ bool DcoModel::setupSelf() {
 
   // create disco variables
   setupAddVariables();
+  // model data in the shared memory segment of the host, the solvers are
+  // loaded already and keep their own copy.
+  if (sharedModel_==NULL and dcoPar_->entry(DcoParams::sharedModel)) {
+    sharedModel_ = new DcoSharedModel(this);
+    if (sharedModel_->setup()) {
+      // free the copy of this process, the segment is mapped read only.
+      delete matrix_;
+      matrix_ = const_cast<CoinPackedMatrix*>(sharedModel_->matrixByRow());
+      if (matrixByCol_) {
+        delete matrixByCol_;
+      }
+      matrixByCol_ =
+        const_cast<CoinPackedMatrix*>(sharedModel_->matrixByCol());
+      delete[] rowLB_;
+      rowLB_ = const_cast<double*>(sharedModel_->rowLB());
+      delete[] rowUB_;
+      rowUB_ = const_cast<double*>(sharedModel_->rowUB());
+      delete[] objCoef_;
+      objCoef_ = const_cast<double*>(sharedModel_->objCoef());
+      if (numConicRows_) {
+        delete[] coneStart_;
+        coneStart_ = const_cast<int*>(sharedModel_->coneStart());
+        delete[] coneMembers_;
+        coneMembers_ = const_cast<int*>(sharedModel_->coneMembers());
+        delete[] coneType_;
+        coneType_ = const_cast<int*>(sharedModel_->coneType());
+      }
+    }
+    else {
+      delete sharedModel_;
+      sharedModel_ = NULL;
+    }
+  }
   // create disco constraints, linear
   setupAddLinearConstraints();
   // create disco constraints, conic
@@ -632,6 +1157,24 @@ bool DcoModel::setupSelf() {
   // add heuristics
   addHeuristics();
 
+  // statistics of this process
+  if (processStats_) {
+    delete processStats_;
+  }
+  processStats_ = new DcoProcessStats(this);
+
+  // checkpoints of the search
+  if (checkpoint_) {
+    delete checkpoint_;
+  }
+  checkpoint_ = new DcoCheckpoint(this);
+
+  // spilling open nodes to disk
+  if (nodeSpill_) {
+    delete nodeSpill_;
+  }
+  nodeSpill_ = new DcoNodeSpill(this);
+
   // free redundant data
   // delete matrix_;
   // matrix_ = NULL;
@@ -1038,14 +1581,125 @@ void DcoModel::addHeuristics() {
     (dcoPar_->entry(DcoParams::heurRoundStrategy));
   // get rounding heuristic frequency from parameters
   int roundingFreq = dcoPar_->entry(DcoParams::heurRoundFreq);
+  // get feasibility pump strategy, frequency and iteration limit
+  DcoHeurStrategy fpStrategy = static_cast<DcoHeurStrategy>
+    (dcoPar_->entry(DcoParams::heurFpStrategy));
+  int fpFreq = dcoPar_->entry(DcoParams::heurFpFreq);
+  int fpMaxIter = dcoPar_->entry(DcoParams::heurFpMaxIter);
+  // get diving strategies, frequency and iteration budget
+  DcoHeurStrategy diveFracStrategy = static_cast<DcoHeurStrategy>
+    (dcoPar_->entry(DcoParams::heurDiveFracStrategy));
+  DcoHeurStrategy divePseudoStrategy = static_cast<DcoHeurStrategy>
+    (dcoPar_->entry(DcoParams::heurDivePseudoStrategy));
+  DcoHeurStrategy diveVecLenStrategy = static_cast<DcoHeurStrategy>
+    (dcoPar_->entry(DcoParams::heurDiveVecLenStrategy));
+  DcoHeurStrategy diveGuidedStrategy = static_cast<DcoHeurStrategy>
+    (dcoPar_->entry(DcoParams::heurDiveGuidedStrategy));
+  int diveFreq = dcoPar_->entry(DcoParams::heurDiveFreq);
+  double diveIterRatio = dcoPar_->entry(DcoParams::heurDiveIterRatio);
+  // get large neighborhood search strategies and frequency
+  DcoHeurStrategy rinsStrategy = static_cast<DcoHeurStrategy>
+    (dcoPar_->entry(DcoParams::heurRinsStrategy));
+  int rinsFreq = dcoPar_->entry(DcoParams::heurRinsFreq);
+  DcoHeurStrategy rensStrategy = static_cast<DcoHeurStrategy>
+    (dcoPar_->entry(DcoParams::heurRensStrategy));
+  // get conic repair strategy and frequency
+  DcoHeurStrategy repairStrategy = static_cast<DcoHeurStrategy>
+    (dcoPar_->entry(DcoParams::heurRepairStrategy));
+  int repairFreq = dcoPar_->entry(DcoParams::heurRepairFreq);
+  // get pool heuristics strategies and frequencies
+  DcoHeurStrategy crossoverStrategy = static_cast<DcoHeurStrategy>
+    (dcoPar_->entry(DcoParams::heurCrossoverStrategy));
+  int crossoverFreq = dcoPar_->entry(DcoParams::heurCrossoverFreq);
+  DcoHeurStrategy localBranchStrategy = static_cast<DcoHeurStrategy>
+    (dcoPar_->entry(DcoParams::heurLocalBranchStrategy));
+  int localBranchFreq = dcoPar_->entry(DcoParams::heurLocalBranchFreq);
 
   // add heuristics
+  // == add start solution, before root heuristics use its cutoff
+  std::string startFile = dcoPar_->entry(DcoParams::startSolutionFile);
+  if (!startFile.empty()) {
+    DcoHeuristic * start = new DcoHeurStartSolution(this, "start solution",
+                                                    DcoHeurStrategyBeforeRoot,
+                                                    -1);
+    heuristics_.push_back(start);
+  }
   // == add rounding heuristics
   if (roundingStrategy != DcoHeurStrategyNone) {
     DcoHeuristic * round = new DcoHeurRounding(this, "rounding",
                                                roundingStrategy, roundingFreq);
     heuristics_.push_back(round);
   }
+  // == add feasibility pump
+  if (fpStrategy != DcoHeurStrategyNone) {
+    DcoHeuristic * fp = new DcoHeurFeasibilityPump(this, "feasibility pump",
+                                                   fpStrategy, fpFreq,
+                                                   fpMaxIter);
+    heuristics_.push_back(fp);
+  }
+  // == add diving heuristics
+  if (diveFracStrategy != DcoHeurStrategyNone) {
+    DcoHeuristic * dive = new DcoHeurDivingFractional(this,
+                                                      "fractional diving",
+                                                      diveFracStrategy,
+                                                      diveFreq,
+                                                      diveIterRatio);
+    heuristics_.push_back(dive);
+  }
+  if (divePseudoStrategy != DcoHeurStrategyNone) {
+    DcoHeuristic * dive = new DcoHeurDivingPseudocost(this,
+                                                      "pseudocost diving",
+                                                      divePseudoStrategy,
+                                                      diveFreq,
+                                                      diveIterRatio);
+    heuristics_.push_back(dive);
+  }
+  if (diveVecLenStrategy != DcoHeurStrategyNone) {
+    DcoHeuristic * dive = new DcoHeurDivingVectorLength(this,
+                                                        "vector length diving",
+                                                        diveVecLenStrategy,
+                                                        diveFreq,
+                                                        diveIterRatio);
+    heuristics_.push_back(dive);
+  }
+  if (diveGuidedStrategy != DcoHeurStrategyNone) {
+    DcoHeuristic * dive = new DcoHeurDivingGuided(this,
+                                                  "guided diving",
+                                                  diveGuidedStrategy,
+                                                  diveFreq,
+                                                  diveIterRatio);
+    heuristics_.push_back(dive);
+  }
+  // == add large neighborhood search heuristics
+  if (rinsStrategy != DcoHeurStrategyNone) {
+    DcoHeuristic * rins = new DcoHeurRins(this, "RINS", rinsStrategy,
+                                          rinsFreq);
+    heuristics_.push_back(rins);
+  }
+  if (rensStrategy != DcoHeurStrategyNone) {
+    DcoHeuristic * rens = new DcoHeurRens(this, "RENS", rensStrategy, -1);
+    heuristics_.push_back(rens);
+  }
+  // == add heuristics working on the solution pool
+  if (crossoverStrategy != DcoHeurStrategyNone) {
+    DcoHeuristic * crossover = new DcoHeurCrossover(this, "crossover",
+                                                    crossoverStrategy,
+                                                    crossoverFreq);
+    heuristics_.push_back(crossover);
+  }
+  if (localBranchStrategy != DcoHeurStrategyNone) {
+    DcoHeuristic * local = new DcoHeurLocalBranching(this, "local branching",
+                                                     localBranchStrategy,
+                                                     localBranchFreq);
+    heuristics_.push_back(local);
+  }
+  // == add conic repair, rounding uses it to repair its points
+  if (repairStrategy != DcoHeurStrategyNone) {
+    DcoHeuristic * repair = new DcoHeurConicRepair(this, "conic repair",
+                                                   repairStrategy,
+                                                   repairFreq);
+    heuristics_.push_back(repair);
+  }
 
 
   // Adjust heurStrategy_ according to the strategies/frequencies of each
@@ -1060,11 +1714,11 @@ void DcoModel::addHeuristics() {
   std::vector<DcoHeuristic*>::iterator it;
   for (it=heuristics_.begin(); it!=heuristics_.end(); ++it) {
     DcoHeurStrategy curr = (*it)->strategy();
-    if (curr==DcoHeurStrategyPeriodic) {
+    if (curr==DcoHeurStrategyPeriodic or curr==DcoHeurStrategyAuto) {
       periodic_exists = true;
       break;
     }
-    else if (curr==DcoHeurStrategyRoot) {
+    else if (curr==DcoHeurStrategyRoot or curr==DcoHeurStrategyBeforeRoot) {
       root_exists = true;
     }
   }
@@ -1077,6 +1731,77 @@ void DcoModel::addHeuristics() {
     // this is not relevant, since we will generate only in root.
     heurFrequency_ = -1;
   }
+
+  // create scheduler for the heuristics
+  if (heurScheduler_) {
+    delete heurScheduler_;
+  }
+  heurScheduler_ = new DcoHeurScheduler(this);
+
+  // create solution pool
+  if (solutionPool_) {
+    delete solutionPool_;
+  }
+  solutionPool_ = new DcoSolutionPool(this,
+                                      dcoPar_->entry(DcoParams::solPoolSize));
+}
+
+CoinPackedMatrix const * DcoModel::matrixByCol() {
+  // the shared memory segment has a column ordered copy.
+  if (matrixByCol_==NULL) {
+    matrixByCol_ = new CoinPackedMatrix();
+    matrixByCol_->reverseOrderedCopyOf(*matrix_);
+  }
+  return matrixByCol_;
+}
+
+void DcoModel::addCoreLinearRow(int size, int const * ind,
+                                double const * val, double lb, double ub) {
+  int starts[2] = {0, size};
+  addCoreLinearRows(1, starts, ind, val, &lb, &ub);
+}
+
+void DcoModel::addCoreLinearRows(int num_rows, int const * starts,
+                                 int const * ind, double const * val,
+                                 double const * lb, double const * ub) {
+  if (sharedModel_) {
+    throw CoinError("Rows can not be added to a model in shared memory.",
+                    "addCoreLinearRows", "DcoModel");
+  }
+  if (num_rows==0) {
+    return;
+  }
+  std::vector<CoinBigIndex> row_starts(starts, starts+num_rows+1);
+  matrix_->appendRows(num_rows, &row_starts[0], ind, val);
+  if (matrixByCol_) {
+    // created again when it is asked for
+    delete matrixByCol_;
+    matrixByCol_ = NULL;
+  }
+  // conic row bounds follow linear row bounds
+  double * row_lb = new double[numRows_+num_rows];
+  double * row_ub = new double[numRows_+num_rows];
+  std::copy(rowLB_, rowLB_+numLinearRows_, row_lb);
+  std::copy(rowUB_, rowUB_+numLinearRows_, row_ub);
+  std::copy(lb, lb+num_rows, row_lb+numLinearRows_);
+  std::copy(ub, ub+num_rows, row_ub+numLinearRows_);
+  std::copy(rowLB_+numLinearRows_, rowLB_+numRows_,
+            row_lb+numLinearRows_+num_rows);
+  std::copy(rowUB_+numLinearRows_, rowUB_+numRows_,
+            row_ub+numLinearRows_+num_rows);
+  delete[] rowLB_;
+  delete[] rowUB_;
+  rowLB_ = row_lb;
+  rowUB_ = row_ub;
+  numLinearRows_ += num_rows;
+  numRows_ += num_rows;
+}
+
+void DcoModel::startHeurWorker() {
+  if (heurWorker_) {
+    delete heurWorker_;
+  }
+  heurWorker_ = new DcoHeurWorker(this);
 }
 
 void DcoModel::setBranchingStrategy() {
@@ -1130,6 +1855,122 @@ void DcoModel::setBranchingStrategy() {
     throw std::exception();
     throw CoinError("Unknown branch strategy.", "setupSelf","DcoModel");
   }
+
+#if !defined(__OA__)
+  // create LP used for strong branching, it is not needed by other
+  // strategies. resetStrategies() may change the strategy.
+  bool strong =
+    dcoPar_->entry(DcoParams::branchStrategy)==DcoBranchingStrategyStrong or
+    dcoPar_->entry(DcoParams::branchStrategyRampUp)==DcoBranchingStrategyStrong;
+  if (strong and dcoPar_->entry(DcoParams::strongBranchOa)) {
+    if (oaSolver_==NULL) {
+      setupOaSolver();
+    }
+  }
+  else if (oaSolver_) {
+    delete oaSolver_;
+    oaSolver_ = NULL;
+  }
+#endif
+
+  // warm start pseudocosts from history of previous runs
+  readBranchHistory();
+}
+
+void DcoModel::resetStrategies() {
+  if (branchStrategy_) {
+    delete branchStrategy_;
+    branchStrategy_=NULL;
+  }
+  if (rampUpBranchStrategy_) {
+    delete rampUpBranchStrategy_;
+    rampUpBranchStrategy_=NULL;
+  }
+  for (std::vector<DcoConGenerator*>::iterator it=conGenerators_.begin();
+       it!=conGenerators_.end(); ++it) {
+    delete *it;
+  }
+  conGenerators_.clear();
+  for (std::vector<DcoHeuristic*>::iterator it=heuristics_.begin();
+       it!=heuristics_.end(); ++it) {
+    delete *it;
+  }
+  heuristics_.clear();
+  setBranchingStrategy();
+  addConstraintGenerators();
+  addHeuristics();
+}
+
+void DcoModel::readBranchHistory() {
+  std::string file_name = dcoPar_->entry(DcoParams::branchHistoryFile);
+  if (file_name.empty()) {
+    return;
+  }
+  double decay = dcoPar_->entry(DcoParams::branchHistoryDecay);
+  BcpsBranchStrategy * strategies[2] = {branchStrategy_,
+                                        rampUpBranchStrategy_};
+  for (int k=0; k<2; ++k) {
+    DcoBranchStrategyPseudo * pseudo =
+      dynamic_cast<DcoBranchStrategyPseudo*>(strategies[k]);
+    if (pseudo==NULL) {
+      continue;
+    }
+    int num_read = pseudo->readHistory(file_name.c_str(), decay);
+    if (num_read<0) {
+      // file does not exist yet in the first run, this is not an error.
+      dcoMessageHandler_->message(DISCO_BRANCH_HISTORY_FAILED,
+                                  *dcoMessages_)
+        << file_name.c_str() << CoinMessageEol;
+      return;
+    }
+    dcoMessageHandler_->message(DISCO_BRANCH_HISTORY_READ, *dcoMessages_)
+      << num_read << file_name.c_str() << decay << CoinMessageEol;
+  }
+}
+
+void DcoModel::writeBranchHistory() {
+  std::string file_name = dcoPar_->entry(DcoParams::branchHistoryFile);
+  if (file_name.empty()) {
+    return;
+  }
+  // in parallel mode every worker has its own statistics.
+  if (broker_->getProcType()!=AlpsProcessTypeSerial) {
+    dcoMessageHandler_->message(0, "Dco",
+                                "Branching history is written in serial "
+                                "mode only.",
+                                'G', DISCO_DLOG_MPI)
+      << CoinMessageEol;
+    return;
+  }
+  DcoBranchStrategyPseudo * pseudo =
+    dynamic_cast<DcoBranchStrategyPseudo*>(branchStrategy_);
+  if (pseudo==NULL) {
+    return;
+  }
+  int num_written = pseudo->writeHistory(file_name.c_str());
+  if (num_written<0) {
+    dcoMessageHandler_->message(DISCO_BRANCH_HISTORY_FAILED, *dcoMessages_)
+      << file_name.c_str() << CoinMessageEol;
+    return;
+  }
+  dcoMessageHandler_->message(DISCO_BRANCH_HISTORY_WRITE, *dcoMessages_)
+    << num_written << file_name.c_str() << CoinMessageEol;
+}
+
+void DcoModel::getPoolNodes(std::vector<AlpsTreeNode*> & nodes) {
+  AlpsSubTree * tree = broker_->getWorkingSubTree();
+  if (tree==NULL) {
+    return;
+  }
+  AlpsNodePool * pools[2] = {tree->nodePool(), tree->diveNodePool()};
+  for (int k=0; k<2; ++k) {
+    if (pools[k]==NULL) {
+      continue;
+    }
+    std::vector<AlpsTreeNode*> const & candidates =
+      pools[k]->getCandidateList().getContainer();
+    nodes.insert(nodes.end(), candidates.begin(), candidates.end());
+  }
 }
 
 void DcoModel::postprocess() {
@@ -1137,6 +1978,10 @@ void DcoModel::postprocess() {
 
 
 AlpsTreeNode * DcoModel::createRoot() {
+  // open nodes of the checkpoint are given to the root when it branches
+  if (dcoPar_->entry(DcoParams::checkpointRestart)) {
+    checkpoint_->read();
+  }
   DcoTreeNode * root = new DcoTreeNode();
   DcoNodeDesc * desc = new DcoNodeDesc(this);
   root->setDesc(desc);
@@ -1200,6 +2045,34 @@ AlpsTreeNode * DcoModel::createRoot() {
 }
 
 
+int DcoModel::fractionality(double const * sol, double * frac) const {
+  double tolerance = dcoPar_->entry(DcoParams::integerTol);
+  int num_frac = 0;
+  for (int i=0; i<numRelaxedCols_; ++i) {
+    double value = sol[relaxedCols_[i]];
+    double dist_to_lower = value - floor(value);
+    double dist_to_upper = 1.0 - dist_to_lower;
+    double infeas = (dist_to_upper>dist_to_lower) ? dist_to_lower :
+      dist_to_upper;
+    frac[i] = (infeas<tolerance) ? 0.0 : infeas;
+    num_frac += (frac[i]!=0.0);
+  }
+  return num_frac;
+}
+
+int DcoModel::solverFractionality(double & sum_frac) {
+  fracBuffer_.resize(numRelaxedCols_);
+  sum_frac = 0.0;
+  if (numRelaxedCols_==0) {
+    return 0;
+  }
+  int num_frac = fractionality(solver_->getColSolution(), &fracBuffer_[0]);
+  for (int i=0; i<numRelaxedCols_; ++i) {
+    sum_frac += fracBuffer_[i];
+  }
+  return num_frac;
+}
+
 DcoSolution * DcoModel::feasibleSolution(int & numInfColumns,
                                          double  & colInf,
                                          int & numInfRows,
@@ -1245,6 +2118,19 @@ DcoSolution * DcoModel::feasibleSolution(int & numInfColumns,
       }
     }
   }
+  // check feasibility of SOS sets, they are resolved by branching as
+  // integrality, count them as infeasible columns.
+  if (numSos_) {
+    double const * sol = solver()->getColSolution();
+    for (int i=0; i<numSos_; ++i) {
+      int first;
+      int last;
+      if (!sosFeasible(i, sol, first, last)) {
+        numInfColumns++;
+      }
+    }
+  }
+
   // report largest column and row infeasibilities
   dcoMessageHandler_->message(DISCO_INFEAS_REPORT, *dcoMessages_)
     << broker()->getProcRank()
@@ -1358,6 +2244,22 @@ void DcoModel::nodeLog(AlpsTreeNode * node, bool force) {
 /// This is called at the end of the AlpsKnowledgeBroker::rootSearch
 /// Prints solution statistics
 void DcoModel::modelLog() {
+  // stop heuristic thread, search is over.
+  if (heurWorker_) {
+    heurWorker_->stop();
+  }
+  // nodes sent to other processes by this one
+  for (int k=1; k>=0; --k) {
+    if (numEncodedNodes_[k]>0) {
+      dcoMessageHandler_->message(DISCO_NODE_ENCODE_STATS, *dcoMessages_)
+        << broker_->getProcRank()
+        << numEncodedNodes_[k]
+        << (k ? "explicit" : "differenced")
+        << static_cast<double>(numEncodedBytes_[k])
+        << static_cast<double>(numEncodedBytes_[k])/numEncodedNodes_[k]
+        << CoinMessageEol;
+    }
+  }
   if (broker_->getProcType() == AlpsProcessTypeSerial) {
     for (unsigned int k=0; k<conGenerators_.size(); ++k) {
       if (conGenerators(k)->stats().numCalls() > 0) {
@@ -1383,13 +2285,52 @@ void DcoModel::modelLog() {
           << CoinMessageEol;
       }
     }
+    if (heurWorker_) {
+      dcoMessageHandler_->message(DISCO_HEUR_THREAD_STATS, *dcoMessages_)
+        << heurWorker_->numPosted()
+        << heurWorker_->numDropped()
+        << heurWorker_->numSolutions()
+        << heurWorker_->time()
+        << CoinMessageEol;
+    }
   }
-  else if (broker_->getProcType()==AlpsProcessTypeMaster) {
-    dcoMessageHandler_->message(0, "Dco",
-                                "Don't know how to log in parallel mode.",
-                                'G', DISCO_DLOG_MPI)
-      << CoinMessageEol;
+  // in parallel runs statistics of all processes are logged by
+  // DcoProcessStats::report() once the search is over.
+}
+
+bool DcoModel::sosFeasible(int i, double const * sol, int & first,
+                           int & last) const {
+  double tol = dcoPar_->entry(DcoParams::integerTol);
+  int num_nonzero = 0;
+  first = -1;
+  last = -1;
+  int size = sosStart_[i+1]-sosStart_[i];
+  int const * members = sosMembers_+sosStart_[i];
+  for (int k=0; k<size; ++k) {
+    if (fabs(sol[members[k]])>tol) {
+      if (first==-1) {
+        first = k;
+      }
+      last = k;
+      num_nonzero++;
+    }
   }
+  if (sosType_[i]==1) {
+    return num_nonzero<=1;
+  }
+  // SOS2, at most two nonzero members and they should be consecutive.
+  return last-first<=1;
+}
+
+bool DcoModel::sosFeasible(double const * sol) const {
+  for (int i=0; i<numSos_; ++i) {
+    int first;
+    int last;
+    if (!sosFeasible(i, sol, first, last)) {
+      return false;
+    }
+  }
+  return true;
 }
 
 void DcoModel::reportFeasibility() {
@@ -1470,6 +2411,10 @@ void DcoModel::reportFeasibility() {
 /// The method that encodes the this instance of model into the given
 /// #AlpsEncoded object.
 AlpsReturnStatus DcoModel::encode(AlpsEncoded * encoded) const {
+  return encode(encoded, dcoPar_->entry(DcoParams::lazyModel));
+}
+
+AlpsReturnStatus DcoModel::encode(AlpsEncoded * encoded, bool lazy) const {
   AlpsReturnStatus status;
   // encode Alps parts
   status = AlpsModel::encode(encoded);
@@ -1477,6 +2422,32 @@ AlpsReturnStatus DcoModel::encode(AlpsEncoded * encoded) const {
     dcoMessageHandler_->message(DISCO_UNEXPECTED_ENCODE_STATUS, *dcoMessages_)
       << __FILE__ << __LINE__ << CoinMessageEol;
   }
+  char lazy_flag = lazy ? 1 : 0;
+  encoded->writeRep(lazy_flag);
+  encoded->writeRep(numInstanceRows_);
+  encoded->writeRep(instanceHash_);
+  if (lazy) {
+    // parameters first, readInstance() needs them.
+    dcoPar_->pack(*encoded);
+    // rows added after reading the input file, i.e. cone approximation.
+    int num_added = numLinearRows_-numInstanceRows_;
+    encoded->writeRep(num_added);
+    encoded->writeRep(rowLB_+numInstanceRows_, num_added);
+    encoded->writeRep(rowUB_+numInstanceRows_, num_added);
+    for (int i=numInstanceRows_; i<numLinearRows_; ++i) {
+      CoinShallowPackedVector row = matrix_->getVector(i);
+      encoded->writeRep(row.getIndices(), row.getNumElements());
+      encoded->writeRep(row.getElements(), row.getNumElements());
+    }
+    std::stringstream debug_msg;
+    debug_msg << "Proc[" << broker_->getProcRank() << "]"
+              << " model " << this << " encoded lazily, "
+              << num_added << " rows." << std::endl;
+    dcoMessageHandler_->message(0, "Dco", debug_msg.str().c_str(),
+                                'G', DISCO_DLOG_MPI)
+      << CoinMessageEol;
+    return status;
+  }
   // encode number of constraints
   encoded->writeRep(numCols_);
   encoded->writeRep(colLB_, numCols_);
@@ -1490,12 +2461,26 @@ AlpsReturnStatus DcoModel::encode(AlpsEncoded * encoded) const {
   encoded->writeRep(numIntegerCols_);
   encoded->writeRep(integerCols_, numIntegerCols_);
   encoded->writeRep(isInteger_, numCols_);
+  // encode column names
+  int num_names = static_cast<int>(colNames_.size());
+  encoded->writeRep(num_names);
+  for (int i=0; i<num_names; ++i) {
+    encoded->writeRep(colNames_[i]);
+  }
   // encode cone info
   if (numConicRows_) {
     encoded->writeRep(coneStart_, numConicRows_+1);
     encoded->writeRep(coneType_, numConicRows_);
     encoded->writeRep(coneMembers_, coneStart_[numConicRows_]);
   }
+  // encode SOS info
+  encoded->writeRep(numSos_);
+  if (numSos_) {
+    encoded->writeRep(sosStart_, numSos_+1);
+    encoded->writeRep(sosType_, numSos_);
+    encoded->writeRep(sosMembers_, sosStart_[numSos_]);
+    encoded->writeRep(sosWeights_, sosStart_[numSos_]);
+  }
   // encode matrix
   encoded->writeRep(matrix_->getNumElements());
   encoded->writeRep(matrix_->getVectorStarts(), numLinearRows_);
@@ -1517,6 +2502,49 @@ AlpsReturnStatus DcoModel::encode(AlpsEncoded * encoded) const {
   return status;
 }
 
+DcoModel * DcoModel::createSubModel(double const * lb,
+                                    double const * ub) const {
+  AlpsEncoded encoded(AlpsKnowledgeTypeModel);
+  // input file is not read again
+  encode(&encoded, false);
+  DcoModel * sub = new DcoModel();
+  // decodeToSelf() logs using the broker, it is replaced by the broker of
+  // the nested search.
+  sub->setBroker(broker_);
+  sub->decodeToSelf(encoded);
+  std::copy(lb, lb+numCols_, sub->colLB_);
+  std::copy(ub, ub+numCols_, sub->colUB_);
+  sub->AlpsPar()->setEntry(AlpsParams::instance, "NONE");
+  // nested searches do not write or read checkpoints
+  sub->dcoPar()->setEntry(DcoParams::checkpointInterval, 0.0);
+  sub->dcoPar()->setEntry(DcoParams::checkpointRestart, false);
+  // nor spill nodes
+  sub->dcoPar()->setEntry(DcoParams::nodeMemoryLimit, 0.0);
+  // data of nested searches is private, rows are added to it.
+  sub->dcoPar()->setEntry(DcoParams::sharedModel, false);
+  sub->setSolver(cloneSolver(false));
+  return sub;
+}
+
+void DcoModel::setSubSearchParams(int node_limit, double time_limit,
+                                  double cutoff, bool keep_lns) {
+  AlpsPar()->setEntry(AlpsParams::msgLevel, 0);
+  AlpsPar()->setEntry(AlpsParams::nodeLimit, node_limit);
+  AlpsPar()->setEntry(AlpsParams::timeLimit, time_limit);
+  dcoPar_->setEntry(DcoParams::logLevel, 0);
+  dcoPar_->setEntry(DcoParams::heurThread, false);
+  dcoPar_->setEntry(DcoParams::branchHistoryFile, "");
+  dcoPar_->setEntry(DcoParams::startSolutionFile, "");
+  dcoPar_->setEntry(DcoParams::cutoff, cutoff);
+  if (!keep_lns) {
+    dcoPar_->setEntry(DcoParams::heurRinsStrategy, DcoHeurStrategyNone);
+    dcoPar_->setEntry(DcoParams::heurRensStrategy, DcoHeurStrategyNone);
+    dcoPar_->setEntry(DcoParams::heurCrossoverStrategy, DcoHeurStrategyNone);
+    dcoPar_->setEntry(DcoParams::heurLocalBranchStrategy,
+                      DcoHeurStrategyNone);
+  }
+}
+
 /// The method that decodes the given #AlpsEncoded object into a new #DcoModel
 /// instance and returns a pointer to it.
 AlpsKnowledge * DcoModel::decode(AlpsEncoded & encoded) const {
@@ -1532,6 +2560,65 @@ AlpsReturnStatus DcoModel::decodeToSelf(AlpsEncoded & encoded) {
     dcoMessageHandler_->message(DISCO_UNEXPECTED_DECODE_STATUS, *dcoMessages_)
       << __FILE__ << __LINE__ << CoinMessageEol;
   }
+  char lazy_flag;
+  int num_instance_rows;
+  unsigned long long instance_hash;
+  encoded.readRep(lazy_flag);
+  encoded.readRep(num_instance_rows);
+  encoded.readRep(instance_hash);
+  if (lazy_flag) {
+    dcoPar_->unpack(encoded);
+    setMessageLevel();
+    // read the input file, it should be the one the master read.
+    std::string instance = AlpsPar()->entry(AlpsParams::instance);
+    readInstance(instance.c_str());
+    if (num_instance_rows!=numInstanceRows_ or
+        instance_hash!=instanceHash_) {
+      dcoMessageHandler_->message(DISCO_LAZY_MODEL_MISMATCH, *dcoMessages_)
+        << broker_->getProcRank()
+        << instance.c_str()
+        << CoinMessageEol;
+      throw CoinError("Input file differs from the one of the master.",
+                      "decodeToSelf", "DcoModel");
+    }
+    // append rows added by the master after reading.
+    int num_added;
+    double * added_lb;
+    double * added_ub;
+    encoded.readRep(num_added);
+    encoded.readRep(added_lb, num_added);
+    encoded.readRep(added_ub, num_added);
+    // collect the rows, bounds are copied once for all of them.
+    std::vector<int> starts(1, 0);
+    std::vector<int> indices;
+    std::vector<double> elements;
+    for (int i=0; i<num_added; ++i) {
+      int size;
+      int * row_indices;
+      double * row_elements;
+      encoded.readRep(row_indices, size);
+      encoded.readRep(row_elements, size);
+      indices.insert(indices.end(), row_indices, row_indices+size);
+      elements.insert(elements.end(), row_elements, row_elements+size);
+      starts.push_back(starts.back()+size);
+      delete[] row_indices;
+      delete[] row_elements;
+    }
+    addCoreLinearRows(num_added, &starts[0],
+                      indices.empty() ? NULL : &indices[0],
+                      elements.empty() ? NULL : &elements[0],
+                      added_lb, added_ub);
+    delete[] added_lb;
+    delete[] added_ub;
+    dcoMessageHandler_->message(DISCO_LAZY_MODEL_READ, *dcoMessages_)
+      << broker_->getProcRank()
+      << instance.c_str()
+      << num_added
+      << CoinMessageEol;
+    return status;
+  }
+  numInstanceRows_ = num_instance_rows;
+  instanceHash_ = instance_hash;
   encoded.readRep(numCols_);
   encoded.readRep(colLB_, numCols_);
   encoded.readRep(colUB_, numCols_);
@@ -1545,6 +2632,13 @@ AlpsReturnStatus DcoModel::decodeToSelf(AlpsEncoded & encoded) {
   encoded.readRep(numIntegerCols_);
   encoded.readRep(integerCols_, numIntegerCols_);
   encoded.readRep(isInteger_, numCols_);
+  // decode column names
+  int num_names;
+  encoded.readRep(num_names);
+  colNames_.resize(num_names);
+  for (int i=0; i<num_names; ++i) {
+    encoded.readRep(colNames_[i]);
+  }
   // decode cone info
   if (numConicRows_) {
     int cone_start_size;
@@ -1553,6 +2647,16 @@ AlpsReturnStatus DcoModel::decodeToSelf(AlpsEncoded & encoded) {
     encoded.readRep(coneType_, numConicRows_);
     encoded.readRep(coneMembers_, coneStart_[numConicRows_]);
   }
+  // decode SOS info
+  encoded.readRep(numSos_);
+  if (numSos_) {
+    int sos_start_size;
+    encoded.readRep(sosStart_, sos_start_size);
+    assert(sos_start_size==numSos_+1);
+    encoded.readRep(sosType_, numSos_);
+    encoded.readRep(sosMembers_, sosStart_[numSos_]);
+    encoded.readRep(sosWeights_, sosStart_[numSos_]);
+  }
   // decode matrix
   int num_elem;
   int * starts;
@@ -5,6 +5,7 @@
 #include <OsiConicSolverInterface.hpp>
 #include <OsiLorentzCone.hpp>
 #include <BcpsBranchStrategy.h>
+#include <CoinHelperFunctions.hpp>
 
 
 #include "DcoParams.hpp"
@@ -13,9 +14,18 @@
 class DcoConGenerator;
 class DcoSolution;
 class DcoHeuristic;
+class DcoHeurScheduler;
+class DcoHeurWorker;
+class DcoSolutionPool;
+class DcoThreadSearch;
+class DcoProcessStats;
+class DcoCheckpoint;
+class DcoNodeSpill;
+class DcoSharedModel;
 
 class CglCutGenerator;
 class CglConicCutGenerator;
+class OsiCuts;
 
 /**
    Represents a discrete conic optimization problem (master problem).
@@ -80,6 +90,21 @@ class DcoModel: public BcpsModel {
 #else
   OsiConicSolverInterface * solver_;
 #endif
+  ///@name Outer approximation LP
+  //@{
+  /// LP solver keeping the outer approximation of the node relaxation, used
+  /// for strong branching when the subproblem solver is conic. It is NULL in
+  /// OA builds and when strong branching is not used. Rows are core linear
+  /// rows and the initial approximation of the cones (numOaBaseRows_ rows),
+  /// followed by numOaRows_ supports of cones, followed by the rows of the
+  /// current node (cuts and branching constraints).
+  OsiSolverInterface * oaSolver_;
+  /// Number of rows of oaSolver_ kept for the whole search.
+  int numOaBaseRows_;
+  /// Number of cone supports in oaSolver_, at most
+  /// DcoParams::strongBranchOaMaxSupports.
+  int numOaRows_;
+  //@}
 
   ///==========================================================================
   /// Fields that will be set by ::readInstance() and sent to other processors
@@ -105,6 +130,8 @@ class DcoModel: public BcpsModel {
   //@{
   /// Constraint matrix.
   CoinPackedMatrix * matrix_;
+  /// Column ordered copy of matrix_, set in ::setupSelf().
+  CoinPackedMatrix * matrixByCol_;
   /// We keep cones in basic form for now, it is easier to send/receive
   int * coneStart_;
   int * coneMembers_;
@@ -138,6 +165,36 @@ class DcoModel: public BcpsModel {
   int * integerCols_;
   int * isInteger_;
   //@}
+
+  ///@name Special ordered sets
+  //@{
+  /// Number of SOS sets.
+  int numSos_;
+  /// Start positions of sets in sosMembers_, size numSos_+1.
+  int * sosStart_;
+  /// Members of sets, sorted with respect to their weights in each set.
+  int * sosMembers_;
+  /// Weights of members.
+  double * sosWeights_;
+  /// Type of sets, 1 or 2.
+  int * sosType_;
+  //@}
+
+  ///@name Column names
+  //@{
+  /// Column names given in the input file. Used to match columns of
+  /// different instances of the same model (see branchHistoryFile).
+  std::vector<std::string> colNames_;
+  //@}
+
+  ///@name Instance identity, see DcoParams::lazyModel.
+  //@{
+  /// Number of linear rows read from the input file. Rows after these are
+  /// added in preprocessing (cone approximation).
+  int numInstanceRows_;
+  /// Hash of the data read from the input file, computed by readInstance().
+  unsigned long long instanceHash_;
+  //@}
   ///==========================================================================
 
   ///==========================================================================
@@ -175,6 +232,42 @@ class DcoModel: public BcpsModel {
   DcoHeurStrategy heurStrategy_;
   int heurFrequency_;
   std::vector<DcoHeuristic*> heuristics_;
+  /// Decides which heuristics are called at a node.
+  DcoHeurScheduler * heurScheduler_;
+  /// Background heuristic thread, NULL if it is not started.
+  DcoHeurWorker * heurWorker_;
+  /// Good and diverse solutions found by this process.
+  DcoSolutionPool * solutionPool_;
+  /// Threaded search this model is a worker of, NULL otherwise. Not owned.
+  DcoThreadSearch * threadSearch_;
+  /// Search statistics of this process.
+  DcoProcessStats * processStats_;
+  /// Checkpoints of the search.
+  DcoCheckpoint * checkpoint_;
+  /// Spills open nodes to disk under DcoParams::nodeMemoryLimit.
+  DcoNodeSpill * nodeSpill_;
+  /// Model data in shared memory, NULL if DcoParams::sharedModel is not
+  /// set or the segment can not be used. If it is set matrix_,
+  /// matrixByCol_, rowLB_, rowUB_, objCoef_ and the cone arrays are in the
+  /// segment, read only.
+  DcoSharedModel * sharedModel_;
+  /// Total number of solver iterations spent solving node subproblems.
+  /// Heuristics bound their own iterations with a fraction of it.
+  long long numRelaxIterations_;
+  /// Random numbers of heuristics. Each model has its own, models of
+  /// different threads do not share a state.
+  CoinThreadRandom randomGenerator_;
+  /// Fractionality of relaxed columns, buffer of solverFractionality().
+  std::vector<double> fracBuffer_;
+  //@}
+
+  ///@name Node encoding statistics. Index 0 is for differenced nodes, 1 for
+  /// explicit nodes.
+  //@{
+  /// Number of nodes encoded.
+  int numEncodedNodes_[2];
+  /// Total size of encoded nodes in bytes.
+  long long numEncodedBytes_[2];
   //@}
 
   ///@name Cut generator related.
@@ -214,6 +307,10 @@ class DcoModel: public BcpsModel {
   void addConstraintGenerators();
   /// Add heuristics
   void addHeuristics();
+  /// Read branching history to the pseudocost branching strategies.
+  void readBranchHistory();
+  /// Create OA LP solver, conic solver builds only.
+  void setupOaSolver();
   //@}
 
   /// write parameters to oustream
@@ -250,16 +347,74 @@ public:
 #else
   OsiConicSolverInterface * solver() {return solver_;}
 #endif
+  /// Get LP solver for strong branching. This is solver() in OA builds. In
+  /// conic builds it is the OA LP if DcoParams::strongBranchOa is set,
+  /// solver() otherwise. updateOaSolver() should be called before it is used
+  /// at a node.
+  OsiSolverInterface * lpSolver();
+  /// Install the subproblem in solver() to the OA LP and solve it. Column
+  /// bounds and rows of the node are copied, supports of cones at the solution
+  /// of solver() are added. Does nothing if there is no OA LP.
+  void updateOaSolver();
+  /// Generate supports of cones at sol, keep the ones violated by lp_sol.
+  /// Returns number of supports added to cuts.
+  int coneSupports(double const * sol, double const * lp_sol,
+                   OsiCuts & cuts) const;
+  /// Copy of solver() with logging turned off, caller owns it. Problem data
+  /// is not copied if copy_data is false.
+#if defined(__OA__)
+  OsiSolverInterface * cloneSolver(bool copy_data=true) const;
+#else
+  OsiConicSolverInterface * cloneSolver(bool copy_data=true) const;
+#endif
+  /// Returns true if the relaxation solved by solver is not optimal.
+  /// Objective values larger than 1e+30 mean infeasible, see
+  /// DcoTreeNode::bound().
+  bool relaxationInfeasible(OsiSolverInterface const * solver) const;
+  /// Fix integer columns of solver to their values in point, rounded and
+  /// kept in the bounds of solver, and solve for the continuous columns. OA
+  /// builds add supports of the violated cones until the solution is cone
+  /// feasible or DISCO_REPAIR_MAX_ROUNDS rounds are done (Kelley's cutting
+  /// plane method), the supports are left in solver. Returns the solution
+  /// if it is feasible and its quality is less than cutoff, NULL otherwise.
+  /// Does not change the model, solver can be a copy used by another
+  /// thread.
+  DcoSolution * repairSolution(OsiSolverInterface * solver,
+                               double const * point,
+                               double cutoff=COIN_DBL_MAX) const;
   //@}
 
   ///@name Other functions
   //@{
+  /// Create a copy of the model with column bounds lb and ub for a nested
+  /// search. The copy is created through encode() and decodeToSelf() and
+  /// gets an empty solver of the same type as solver(). Caller owns both the
+  /// model and its solver. Used by large neighborhood search heuristics.
+  DcoModel * createSubModel(double const * lb, double const * ub) const;
+  /// Set parameters of a nested search on a model created by
+  /// createSubModel(), node and time limits and cutoff. Logs, the heuristic
+  /// thread, branch history and start solution files are turned off. Large
+  /// neighborhood search heuristics, which would start nested searches of
+  /// their own, are turned off unless keep_lns is true.
+  void setSubSearchParams(int node_limit, double time_limit, double cutoff,
+                          bool keep_lns=false);
   /// Approximate cones.
   void approximateCones();
+  /// Hash of the data read from the input file (bounds, objective,
+  /// integrality, instance rows, cones and SOS sets).
+  unsigned long long computeInstanceHash() const;
+  /// Hash computed when the input file is read.
+  unsigned long long instanceHash() const { return instanceHash_; }
   /// return to branch strategy.
   BcpsBranchStrategy * branchStrategy() {return branchStrategy_;}
   /// return Dco Parameter
   DcoParams const * dcoPar() const {return dcoPar_;}
+  /// return Dco Parameter, parameters of models created by createSubModel()
+  /// are set through this.
+  DcoParams * dcoPar() {return dcoPar_;}
+  /// Recreate branching strategies, constraint generators and heuristics
+  /// from the current parameters. Statistics of the old ones are lost.
+  void resetStrategies();
   /// get upper bound of the objective value for minimization
   double bestQuality();
   //@}
@@ -280,6 +435,24 @@ public:
   double * rowLB() {return rowLB_;}
   /// Get row upper bounds.
   double * rowUB() {return rowUB_;}
+  /// Get objective coefficients.
+  double const * objCoef() const {return objCoef_;}
+  /// Get row ordered matrix of core linear rows.
+  CoinPackedMatrix const * matrixByRow() const {return matrix_;}
+  /// Get column ordered matrix of core linear rows. It is created at the
+  /// first call, only heuristics use it.
+  CoinPackedMatrix const * matrixByCol();
+  /// Append a core linear row. Should be called before setupSelf(), used to
+  /// restrict models created by createSubModel(). Throws if the model data
+  /// is in shared memory.
+  void addCoreLinearRow(int size, int const * ind, double const * val,
+                        double lb, double ub);
+  /// Append core linear rows, row k has entries starts[k] to
+  /// starts[k+1]-1 of ind and val. Same as addCoreLinearRow() for each row,
+  /// row bounds are copied once.
+  void addCoreLinearRows(int num_rows, int const * starts, int const * ind,
+                         double const * val, double const * lb,
+                         double const * ub);
   /// Get objective sense, 1 for min, -1 for max
   double objSense() const { return objSense_; }
   /// Get number of integer variables.
@@ -289,6 +462,24 @@ public:
   int const * coneStart() const { return coneStart_; }
   int const * coneMembers() const { return coneMembers_; }
   int const * coneType() const { return coneType_; }
+  /// Get number of SOS sets.
+  int numSos() const { return numSos_; }
+  /// Get start positions of SOS sets in sosMembers(), size numSos()+1.
+  int const * sosStart() const { return sosStart_; }
+  /// Get members of SOS sets, sorted with respect to weights in each set.
+  int const * sosMembers() const { return sosMembers_; }
+  /// Get weights of SOS set members.
+  double const * sosWeights() const { return sosWeights_; }
+  /// Get types of SOS sets, 1 or 2.
+  int const * sosType() const { return sosType_; }
+  /// Check feasibility of SOS set i for the given solution. Returns true if
+  /// feasible. first and last are set to the positions of the first and last
+  /// nonzero members.
+  bool sosFeasible(int i, double const * sol, int & first, int & last) const;
+  /// Check feasibility of all SOS sets for the given solution.
+  bool sosFeasible(double const * sol) const;
+  /// Get column names. Empty if the input file does not have names.
+  std::vector<std::string> const & colNames() const { return colNames_; }
   //@}
 
   ///@name Querry relaxed problem objects
@@ -331,13 +522,53 @@ public:
   //@{
   // get number of heuristics
   long unsigned int numHeuristics() const { return heuristics_.size(); }
+  /// Get total number of solver iterations spent solving node subproblems.
+  long long numRelaxIterations() const { return numRelaxIterations_; }
+  /// Add to number of solver iterations spent solving node subproblems.
+  void addNumRelaxIterations(int n) { numRelaxIterations_ += n; }
+  /// Record an encoded node of size bytes.
+  void addEncodedNode(bool is_explicit, int bytes) {
+    numEncodedNodes_[is_explicit]++;
+    numEncodedBytes_[is_explicit] += bytes;
+  }
   // get a constant specific heuristic, for reading statistics.
   DcoHeuristic const * heuristics(long unsigned int i) const { return heuristics_[i]; }
   // get a specific heuristic, for solution search
   DcoHeuristic * heuristics(long unsigned int i) { return heuristics_[i]; }
+  // get heuristic scheduler
+  DcoHeurScheduler * heurScheduler() { return heurScheduler_; }
+  // get background heuristic thread, NULL if it is not started
+  DcoHeurWorker * heurWorker() { return heurWorker_; }
+  /// Start background heuristic thread with a copy of solver(). Should be
+  /// called after the root relaxation is solved.
+  void startHeurWorker();
+  // get solution pool
+  DcoSolutionPool * solutionPool() { return solutionPool_; }
+  /// Get search statistics of this process, set in setupSelf().
+  DcoProcessStats * processStats() { return processStats_; }
+  /// Get checkpoints of the search, set in setupSelf().
+  DcoCheckpoint * checkpoint() { return checkpoint_; }
+  /// Get node spilling of this process, set in setupSelf().
+  DcoNodeSpill * nodeSpill() { return nodeSpill_; }
+  // get threaded search this model is a worker of, NULL if there is none
+  DcoThreadSearch * threadSearch() { return threadSearch_; }
+  // set threaded search this model is a worker of
+  void setThreadSearch(DcoThreadSearch * search) { threadSearch_ = search; }
+  /// Get random number generator of this model, used by heuristics.
+  CoinThreadRandom * randomGenerator() { return &randomGenerator_; }
   //@}
 
 
+  /// Compute fractionality of relaxed columns for the given solution in one
+  /// pass. frac[i] is the distance of column relaxedCols()[i] to the nearest
+  /// integer, 0.0 if it is within integer tolerance. frac should have
+  /// numRelaxedCols() entries. Returns number of fractional columns.
+  int fractionality(double const * sol, double * frac) const;
+  /// Number of fractional relaxed columns of the solver solution, sum_frac
+  /// is set to the sum of their fractionality. Reuses a buffer of the
+  /// model.
+  int solverFractionality(double & sum_frac);
+
   /// Check feasiblity of subproblem solution, store number of infeasible
   /// columns and rows.
   virtual DcoSolution * feasibleSolution(int & numInfColumns, double & colInf,
@@ -389,8 +620,13 @@ public:
   // since we declare "#AlpsEncoded * encode() const" here.
   using AlpsKnowledge::encode;
   /// The method that encodes the this instance of model into the given
-  /// #AlpsEncoded object.
+  /// #AlpsEncoded object. Encodes only the rows added after reading the
+  /// input file if DcoParams::lazyModel is set.
   virtual AlpsReturnStatus encode(AlpsEncoded * encoded) const;
+  /// Encode model, problem data is left out if lazy is true. The decoding
+  /// process reads the input file given by AlpsParams::instance, checks it
+  /// against instanceHash_ and appends the rows added after reading.
+  AlpsReturnStatus encode(AlpsEncoded * encoded, bool lazy) const;
   /// The method that decodes the given #AlpsEncoded object into a new #DcoModel
   /// instance and returns a pointer to it.
   virtual AlpsKnowledge * decode(AlpsEncoded & encoded) const;
@@ -400,6 +636,12 @@ public:
 
   /// report feasibility of the best solution
   void reportFeasibility();
+  /// Write branching history of the pseudocost branching strategy to
+  /// DcoParams::branchHistoryFile. Serial mode only.
+  void writeBranchHistory();
+  /// Get open nodes in the node pools of the working subtree of the broker.
+  /// The node being processed is not in the pools.
+  void getPoolNodes(std::vector<AlpsTreeNode*> & nodes);
 
 };
 
@@ -1,5 +1,16 @@
 #include "DcoNodeDesc.hpp"
 #include "DcoMessage.hpp"
+#include "DcoLinearConstraint.hpp"
+#include "DcoEncoding.hpp"
+#include "DcoNodeSpill.hpp"
+
+#include <vector>
+#include <algorithm>
+#include <CoinUtilsConfig.h>
+#include <CoinError.hpp>
+#ifdef COIN_HAS_ZLIB
+#include <zlib.h>
+#endif
 
 DcoNodeDesc::DcoNodeDesc() {
   // set if as down branch by default
@@ -8,6 +19,9 @@ DcoNodeDesc::DcoNodeDesc() {
   // set to 0.0 by default.
   branchedVal_ = 0.0;
   basis_ = NULL;
+  solEstimate_ = ALPS_OBJ_MAX;
+  spillPos_ = -1;
+  spillSize_ = 0;
 }
 
 DcoNodeDesc::DcoNodeDesc(DcoModel * model): BcpsNodeDesc(model) {
@@ -17,12 +31,27 @@ DcoNodeDesc::DcoNodeDesc(DcoModel * model): BcpsNodeDesc(model) {
   // set to 0.0 by default.
   branchedVal_ = 0.0;
   basis_ = NULL;
+  solEstimate_ = ALPS_OBJ_MAX;
+  spillPos_ = -1;
+  spillSize_ = 0;
 }
 
 DcoNodeDesc::~DcoNodeDesc() {
+  if (spillPos_>=0) {
+    // deleted without being read back, free its space in the spill file
+    DcoModel * model = dynamic_cast<DcoModel*>(getModel());
+    if (model and model->nodeSpill()) {
+      model->nodeSpill()->release(spillPos_, spillSize_);
+    }
+  }
   if (basis_) {
     delete basis_;
   }
+  for (std::vector<DcoLinearConstraint*>::iterator it=branchCons_.begin();
+       it!=branchCons_.end(); ++it) {
+    delete *it;
+  }
+  branchCons_.clear();
 }
 
 DcoNodeBranchDir DcoNodeDesc::getBranchedDir() const {
@@ -58,19 +87,287 @@ void DcoNodeDesc::setBasis(CoinWarmStartBasis *& ws) {
   ws = NULL;
 }
 
+double DcoNodeDesc::getSolEstimate() const {
+  return solEstimate_;
+}
+
+void DcoNodeDesc::setSolEstimate(double est) {
+  solEstimate_ = est;
+}
+
 /** Get warm start basis. */
 CoinWarmStartBasis * DcoNodeDesc::getBasis() const {
   return basis_;
 }
 
+void DcoNodeDesc::addBranchCon(DcoLinearConstraint * con) {
+  branchCons_.push_back(con);
+}
+
+void DcoNodeDesc::addAncestorBranchCons(
+    std::vector<DcoLinearConstraint*> const & cons) {
+  branchCons_.insert(branchCons_.begin(), cons.begin(), cons.end());
+}
+
+int DcoNodeDesc::memoryUsage() const {
+  int usage = sizeof(*this);
+  BcpsObjectListMod const * lists[2] = {getVars(), getCons()};
+  for (int k=0; k<2; ++k) {
+    int num_modify = lists[k]->lbHard.numModify + lists[k]->ubHard.numModify +
+      lists[k]->lbSoft.numModify + lists[k]->ubSoft.numModify;
+    usage += num_modify*(sizeof(int)+sizeof(double));
+  }
+  for (int i=0; i<getCons()->numAdd; ++i) {
+    DcoLinearConstraint const * cut =
+      dynamic_cast<DcoLinearConstraint const *>(getCons()->objects[i]);
+    if (cut) {
+      usage += sizeof(*cut) + cut->getSize()*(sizeof(int)+sizeof(double));
+    }
+  }
+  for (int i=0; i<numBranchCons(); ++i) {
+    usage += sizeof(*branchCons_[i]) +
+      branchCons_[i]->getSize()*(sizeof(int)+sizeof(double));
+  }
+  if (basis_) {
+    // 2 bits a status
+    usage += sizeof(*basis_) +
+      (basis_->getNumStructural()+basis_->getNumArtificial())/4;
+  }
+  return usage;
+}
+
+void DcoNodeDesc::releaseSpilled(long long pos, int size) {
+  spillPos_ = pos;
+  spillSize_ = size;
+  if (basis_) {
+    delete basis_;
+    basis_ = NULL;
+  }
+  for (std::vector<DcoLinearConstraint*>::iterator it=branchCons_.begin();
+       it!=branchCons_.end(); ++it) {
+    delete *it;
+  }
+  branchCons_.clear();
+  // bound modifications and cuts are freed with an empty description.
+  DcoNodeDesc empty(dynamic_cast<DcoModel*>(getModel()));
+  std::swap(vars_, empty.vars_);
+  std::swap(cons_, empty.cons_);
+}
+
+void DcoNodeDesc::restoreSpilled(DcoNodeDesc * other) {
+  std::swap(vars_, other->vars_);
+  std::swap(cons_, other->cons_);
+  setBasis(other->basis_);
+  branchCons_.insert(branchCons_.end(), other->branchCons_.begin(),
+                     other->branchCons_.end());
+  other->branchCons_.clear();
+  spillPos_ = -1;
+  spillSize_ = 0;
+}
+
+// Encode a bound modification list. Dense lists (an entry for every object,
+// in order, e.g. explicit nodes) are written as changes with respect to the
+// root bounds of objects. Other lists are written as they are.
+template <class T>
+static void encodeBoundMod(AlpsEncoded * encoded,
+                           BcpsFieldListMod<double> const & mod,
+                           std::vector<T*> const & objects, bool lower) {
+  int num_objects = static_cast<int>(objects.size());
+  char relative = mod.relative ? 1 : 0;
+  char dense = (!mod.relative and mod.numModify==num_objects) ? 1 : 0;
+  for (int i=0; dense and i<mod.numModify; ++i) {
+    if (mod.posModify[i]!=i) {
+      dense = 0;
+    }
+  }
+  encoded->writeRep(relative);
+  encoded->writeRep(dense);
+  if (!dense) {
+    encoded->writeRep(mod.numModify);
+    DcoEncodeIndices(encoded, mod.numModify, mod.posModify);
+    encoded->writeRep(mod.entries, mod.numModify);
+    return;
+  }
+  std::vector<int> pos;
+  std::vector<double> values;
+  for (int i=0; i<num_objects; ++i) {
+    double root = lower ? objects[i]->getLbHard() : objects[i]->getUbHard();
+    if (mod.entries[i]!=root) {
+      pos.push_back(i);
+      values.push_back(mod.entries[i]);
+    }
+  }
+  int num_changed = static_cast<int>(pos.size());
+  encoded->writeRep(num_changed);
+  DcoEncodeIndices(encoded, num_changed, num_changed ? &pos[0] : NULL);
+  encoded->writeRep(num_changed ? &values[0] : NULL, num_changed);
+}
+
+// Decode a list written by encodeBoundMod(), dense lists are expanded back
+// using the root bounds of objects.
+template <class T>
+static void decodeBoundMod(AlpsEncoded & encoded,
+                           std::vector<T*> const & objects, bool lower,
+                           bool & relative, int & size, int *& pos,
+                           double *& values) {
+  char rel;
+  char dense;
+  int num;
+  encoded.readRep(rel);
+  encoded.readRep(dense);
+  encoded.readRep(num);
+  relative = rel!=0;
+  int * num_pos = new int[num];
+  if (!DcoDecodeIndices(encoded, num, num_pos)) {
+    delete[] num_pos;
+    throw CoinError("Can not decode bound positions.", "decodeBoundMod",
+                    "DcoNodeDesc");
+  }
+  double * num_values = NULL;
+  int num_read;
+  encoded.readRep(num_values, num_read);
+  if (!dense) {
+    size = num;
+    pos = num_pos;
+    values = num_values;
+    return;
+  }
+  size = static_cast<int>(objects.size());
+  pos = new int[size];
+  values = new double[size];
+  for (int i=0; i<size; ++i) {
+    pos[i] = i;
+    values[i] = lower ? objects[i]->getLbHard() : objects[i]->getUbHard();
+  }
+  for (int i=0; i<num; ++i) {
+    values[num_pos[i]] = num_values[i];
+  }
+  delete[] num_pos;
+  if (num_values) {
+    delete[] num_values;
+  }
+}
+
+// Encode a basis status array run length encoded. Runs are given by their
+// statuses and end positions, end positions are increasing.
+static void encodeStatusRuns(AlpsEncoded * encoded,
+                             CoinWarmStartBasis const * ws, bool structural) {
+  int size = structural ? ws->getNumStructural() : ws->getNumArtificial();
+  std::vector<char> status;
+  std::vector<int> end;
+  for (int i=0; i<size; ++i) {
+    char curr = static_cast<char>(structural ? ws->getStructStatus(i) :
+                                  ws->getArtifStatus(i));
+    if (status.empty() or status.back()!=curr) {
+      status.push_back(curr);
+      end.push_back(i+1);
+    }
+    else {
+      end.back() = i+1;
+    }
+  }
+  int num_runs = static_cast<int>(status.size());
+  encoded->writeRep(num_runs);
+  encoded->writeRep(num_runs ? &status[0] : NULL, num_runs);
+  DcoEncodeIndices(encoded, num_runs, num_runs ? &end[0] : NULL);
+}
+
+// Decode runs written by encodeStatusRuns() into ws.
+static void decodeStatusRuns(AlpsEncoded & encoded, CoinWarmStartBasis * ws,
+                             bool structural) {
+  int num_runs;
+  encoded.readRep(num_runs);
+  char * status = NULL;
+  int num_status;
+  encoded.readRep(status, num_status);
+  int * end = new int[num_runs];
+  if (!DcoDecodeIndices(encoded, num_runs, end)) {
+    if (status) {
+      delete[] status;
+    }
+    delete[] end;
+    throw CoinError("Can not decode basis status runs.", "decodeStatusRuns",
+                    "DcoNodeDesc");
+  }
+  int start = 0;
+  for (int k=0; k<num_runs; ++k) {
+    CoinWarmStartBasis::Status curr =
+      static_cast<CoinWarmStartBasis::Status>(status[k]);
+    for (int i=start; i<end[k]; ++i) {
+      if (structural) {
+        ws->setStructStatus(i, curr);
+      }
+      else {
+        ws->setArtifStatus(i, curr);
+      }
+    }
+    start = end[k];
+  }
+  delete[] end;
+  if (status) {
+    delete[] status;
+  }
+}
+
 /// Encode this to an AlpsEncoded object.
 AlpsReturnStatus DcoNodeDesc::encode(AlpsEncoded * encoded) const {
   // return value
   AlpsReturnStatus status;
   status = AlpsNodeDesc::encode(encoded);
-  // todo(aykut) rename this function in Bcps level?
-  status = BcpsNodeDesc::encodeBcps(encoded);
-  assert(status==AlpsReturnStatusOk);
+  DcoModel * model = dynamic_cast<DcoModel*>(getModel());
+  char compress = 0;
+#ifdef COIN_HAS_ZLIB
+  compress = model->dcoPar()->entry(DcoParams::nodeCompress) ? 1 : 0;
+#endif
+  encoded->writeRep(compress);
+  if (!compress) {
+    return encodeData(encoded, model);
+  }
+#ifdef COIN_HAS_ZLIB
+  AlpsEncoded data(AlpsKnowledgeTypeNode);
+  status = encodeData(&data, model);
+  uLongf size = compressBound(data.size());
+  Bytef * buffer = new Bytef[size];
+  int res = compress2(buffer, &size,
+                      reinterpret_cast<Bytef const *>(data.data()),
+                      data.size(), Z_BEST_SPEED);
+  assert(res==Z_OK);
+  int data_size = data.size();
+  int buffer_size = static_cast<int>(size);
+  encoded->writeRep(data_size);
+  encoded->writeRep(reinterpret_cast<char*>(buffer), buffer_size);
+  delete[] buffer;
+#endif
+  return status;
+}
+
+AlpsReturnStatus DcoNodeDesc::encodeData(AlpsEncoded * encoded,
+                                         DcoModel * model) const {
+  // Bcps part. Columns are never added, rows added are cuts. Status
+  // modifications are not used by DisCO and are not encoded.
+  BcpsObjectListMod const * vars = getVars();
+  BcpsObjectListMod const * cons = getCons();
+  std::vector<BcpsVariable*> const & cols = model->getVariables();
+  std::vector<BcpsConstraint*> const & rows = model->getConstraints();
+  assert(vars->numAdd==0);
+  encodeBoundMod(encoded, vars->lbHard, cols, true);
+  encodeBoundMod(encoded, vars->ubHard, cols, false);
+  encodeBoundMod(encoded, vars->lbSoft, cols, true);
+  encodeBoundMod(encoded, vars->ubSoft, cols, false);
+  encoded->writeRep(cons->numRemove);
+  DcoEncodeIndices(encoded, cons->numRemove, cons->posRemove);
+  encoded->writeRep(cons->numAdd);
+  for (int i=0; i<cons->numAdd; ++i) {
+    DcoLinearConstraint * cut =
+      dynamic_cast<DcoLinearConstraint*>(cons->objects[i]);
+    assert(cut);
+    cut->encode(encoded);
+  }
+  encodeBoundMod(encoded, cons->lbHard, rows, true);
+  encodeBoundMod(encoded, cons->ubHard, rows, false);
+  encodeBoundMod(encoded, cons->lbSoft, rows, true);
+  encodeBoundMod(encoded, cons->ubSoft, rows, false);
+  // Dco part
   encoded->writeRep(branchedDir_);
   encoded->writeRep(branchedInd_);
   encoded->writeRep(branchedVal_);
@@ -79,21 +376,23 @@ AlpsReturnStatus DcoNodeDesc::encode(AlpsEncoded * encoded) const {
   if (basis_) {
     available = 1;
     encoded->writeRep(available);
-    int numCols = basis_->getNumStructural();
-    int numRows = basis_->getNumArtificial();
-    encoded->writeRep(numCols);
-    encoded->writeRep(numRows);
-    // Pack structural.
-    int nint = (basis_->getNumStructural() + 15) >> 4;
-    encoded->writeRep(basis_->getStructuralStatus(), nint * 4);
-    // Pack artificial.
-    nint = (basis_->getNumArtificial() + 15) >> 4;
-    encoded->writeRep(basis_->getArtificialStatus(), nint * 4);
+    int num_cols = basis_->getNumStructural();
+    int num_rows = basis_->getNumArtificial();
+    encoded->writeRep(num_cols);
+    encoded->writeRep(num_rows);
+    encodeStatusRuns(encoded, basis_, true);
+    encodeStatusRuns(encoded, basis_, false);
   }
   else {
     encoded->writeRep(available);
   }
-  return status;
+  // Encode rows created by branching
+  int num_cons = numBranchCons();
+  encoded->writeRep(num_cons);
+  for (int i=0; i<num_cons; ++i) {
+    branchCons_[i]->encode(encoded);
+  }
+  return AlpsReturnStatusOk;
 }
 
 /// Decode a given AlpsEncoded object to an AlpsKnowledge object and return a
@@ -101,7 +400,7 @@ AlpsReturnStatus DcoNodeDesc::encode(AlpsEncoded * encoded) const {
 AlpsNodeDesc * DcoNodeDesc::decode(AlpsEncoded & encoded) const {
   // get pointers for message logging
   AlpsReturnStatus status;
-  DcoNodeDesc * new_desc = new DcoNodeDesc();
+  DcoNodeDesc * new_desc = new DcoNodeDesc(dynamic_cast<DcoModel*>(getModel()));
   status = new_desc->decodeToSelf(encoded);
   assert(status==AlpsReturnStatusOk);
   return new_desc;
@@ -111,46 +410,111 @@ AlpsNodeDesc * DcoNodeDesc::decode(AlpsEncoded & encoded) const {
 AlpsReturnStatus DcoNodeDesc::decodeToSelf(AlpsEncoded & encoded) {
   AlpsReturnStatus status = AlpsReturnStatusOk;
   status = AlpsNodeDesc::decodeToSelf(encoded);
-  // todo(aykut) rename this function in Bcps level?
-  status = BcpsNodeDesc::decodeBcps(encoded);
+  DcoModel * model = dynamic_cast<DcoModel*>(getModel());
+  char compress;
+  encoded.readRep(compress);
+  if (!compress) {
+    return decodeData(encoded, model);
+  }
+#ifdef COIN_HAS_ZLIB
+  int data_size;
+  int buffer_size;
+  char * buffer = NULL;
+  encoded.readRep(data_size);
+  encoded.readRep(buffer, buffer_size);
+  char * data = new char[data_size];
+  uLongf size = data_size;
+  int res = uncompress(reinterpret_cast<Bytef*>(data), &size,
+                       reinterpret_cast<Bytef*>(buffer), buffer_size);
+  delete[] buffer;
+  if (res!=Z_OK or static_cast<int>(size)!=data_size) {
+    delete[] data;
+    return AlpsReturnStatusErr;
+  }
+  // data is owned by the encoded object.
+  AlpsEncoded data_encoded(AlpsKnowledgeTypeNode, data_size, data);
+  status = decodeData(data_encoded, model);
+#else
+  status = AlpsReturnStatusErr;
+#endif
+  return status;
+}
 
-  assert(status==AlpsReturnStatusOk);
+AlpsReturnStatus DcoNodeDesc::decodeData(AlpsEncoded & encoded,
+                                         DcoModel * model) {
+  std::vector<BcpsVariable*> const & cols = model->getVariables();
+  std::vector<BcpsConstraint*> const & rows = model->getConstraints();
+  // variable bounds
+  bool rel[4];
+  int size[4];
+  int * pos[4];
+  double * values[4];
+  decodeBoundMod(encoded, cols, true, rel[0], size[0], pos[0], values[0]);
+  decodeBoundMod(encoded, cols, false, rel[1], size[1], pos[1], values[1]);
+  decodeBoundMod(encoded, cols, true, rel[2], size[2], pos[2], values[2]);
+  decodeBoundMod(encoded, cols, false, rel[3], size[3], pos[3], values[3]);
+  int * no_pos = NULL;
+  BcpsObject ** no_objects = NULL;
+  assignVars(0, no_pos, 0, no_objects,
+             rel[0], size[0], pos[0], values[0],
+             rel[1], size[1], pos[1], values[1],
+             rel[2], size[2], pos[2], values[2],
+             rel[3], size[3], pos[3], values[3]);
+  // constraints, cuts added at this node
+  int num_remove;
+  encoded.readRep(num_remove);
+  int * pos_remove = new int[num_remove];
+  if (!DcoDecodeIndices(encoded, num_remove, pos_remove)) {
+    delete[] pos_remove;
+    throw CoinError("Can not decode positions of removed cuts.", "decodeData",
+                    "DcoNodeDesc");
+  }
+  int num_add;
+  encoded.readRep(num_add);
+  BcpsObject ** cuts = new BcpsObject*[num_add];
+  for (int i=0; i<num_add; ++i) {
+    DcoLinearConstraint * cut = new DcoLinearConstraint();
+    cut->decodeToSelf(encoded);
+    cut->setBroker(model->broker());
+    cuts[i] = cut;
+  }
+  decodeBoundMod(encoded, rows, true, rel[0], size[0], pos[0], values[0]);
+  decodeBoundMod(encoded, rows, false, rel[1], size[1], pos[1], values[1]);
+  decodeBoundMod(encoded, rows, true, rel[2], size[2], pos[2], values[2]);
+  decodeBoundMod(encoded, rows, false, rel[3], size[3], pos[3], values[3]);
+  assignCons(num_remove, pos_remove, num_add, cuts,
+             rel[0], size[0], pos[0], values[0],
+             rel[1], size[1], pos[1], values[1],
+             rel[2], size[2], pos[2], values[2],
+             rel[3], size[3], pos[3], values[3]);
+  // Dco part
   encoded.readRep(branchedDir_);
   encoded.readRep(branchedInd_);
   encoded.readRep(branchedVal_);
   // decode basis if available
   int available;
   encoded.readRep(available);
+  if (basis_) {
+    delete basis_;
+    basis_ = NULL;
+  }
   if (available==1) {
-    if (basis_) {
-      delete basis_;
-    }
-    int numCols;
-    int numRows;
-    encoded.readRep(numCols);
-    encoded.readRep(numRows);
-    int tempInt;
-    // Structural
-    int nint = (numCols + 15) >> 4;
-    char * structuralStatus = new char[4 * nint];
-    encoded.readRep(structuralStatus, tempInt);
-    assert(tempInt == nint*4);
-    // Artificial
-    nint = (numRows + 15) >> 4;
-    char * artificialStatus = new char[4 * nint];
-    encoded.readRep(artificialStatus, tempInt);
-    assert(tempInt == nint*4);
+    int num_cols;
+    int num_rows;
+    encoded.readRep(num_cols);
+    encoded.readRep(num_rows);
     basis_ = new CoinWarmStartBasis();
-    if (!basis_) {
-        throw CoinError("Out of memory", "BlisDecodeWarmStart", "HELP");
-    }
-    basis_->assignBasisStatus(numCols, numRows,
-                              structuralStatus, artificialStatus);
-    assert(!structuralStatus);
-    assert(!artificialStatus);
+    basis_->setSize(num_cols, num_rows);
+    decodeStatusRuns(encoded, basis_, true);
+    decodeStatusRuns(encoded, basis_, false);
   }
-  else {
-    basis_ = NULL;
+  // decode rows created by branching
+  int num_cons;
+  encoded.readRep(num_cons);
+  for (int i=0; i<num_cons; ++i) {
+    DcoLinearConstraint * con = new DcoLinearConstraint();
+    con->decodeToSelf(encoded);
+    branchCons_.push_back(con);
   }
-  return status;
+  return AlpsReturnStatusOk;
 }
@@ -7,6 +7,8 @@
 #include "DcoModel.hpp"
 #include "Dco.hpp"
 
+class DcoLinearConstraint;
+
 /*!
 
   Represents subproblem data, ie. tree node data. This class stores a branch
@@ -55,6 +57,34 @@
   <li> entries, template class T pointer.
   </ul>
 
+  # Branching constraints
+
+  Rows added by branching on split disjunctions (see
+  DcoDisjunctionBranchObject) are kept in branchCons_. They are valid for the
+  subtree rooted at this node only. When a subproblem is installed, rows of
+  all nodes on the path to the closest explicit node are added to the solver.
+  Explicit nodes store rows of all their ancestors.
+
+  # Encoding
+
+  Descriptions are encoded in a compact format when nodes are sent to other
+  processes. Bound lists of explicit nodes, which have an entry for every
+  column, are written as changes with respect to the root bounds and
+  expanded back when decoded. Index lists are varint encoded (see
+  DcoEncoding.hpp), basis statuses are run length encoded. If
+  DcoParams::nodeCompress is set the whole description is compressed with
+  zlib.
+
+  # Spilling
+
+  Descriptions of open nodes can be spilled to a file when their memory goes
+  over DcoParams::nodeMemoryLimit (see DcoNodeSpill). The whole description
+  is written with encode() and released from memory, only the spill position
+  and size are kept. Position of the description in the spill file is kept
+  in spillPos_, it is -1 if the description is not spilled. A spilled
+  description that is deleted without being read back frees its space in
+  the spill file.
+
  */
 
 class DcoNodeDesc: public BcpsNodeDesc {
@@ -66,6 +96,19 @@ class DcoNodeDesc: public BcpsNodeDesc {
   double branchedVal_;
   /** Warm start. */
   CoinWarmStartBasis * basis_;
+  /** Solution estimate computed by the parent when branching. It is set to
+      the tree node created from this description. */
+  double solEstimate_;
+  /** Rows added by branching. Owned by this. */
+  std::vector<DcoLinearConstraint*> branchCons_;
+  /** Position of this in the spill file, -1 if not spilled. */
+  long long spillPos_;
+  /** Size of this in the spill file. */
+  int spillSize_;
+  /** Encode description, everything after the compression flag. */
+  AlpsReturnStatus encodeData(AlpsEncoded * encoded, DcoModel * model) const;
+  /** Decode data written by encodeData(). */
+  AlpsReturnStatus decodeData(AlpsEncoded & encoded, DcoModel * model);
 public:
   DcoNodeDesc();
   DcoNodeDesc(DcoModel * model);
@@ -77,10 +120,41 @@ public:
   void setBranchedDir(DcoNodeBranchDir dir);
   void setBranchedInd(int ind);
   void setBranchedVal(double val);
+  /** Get solution estimate given by the parent. */
+  double getSolEstimate() const;
+  /** Set solution estimate. */
+  void setSolEstimate(double est);
   /** Set basis. */
   void setBasis(CoinWarmStartBasis *& ws);
   /** Get warm start basis. */
   CoinWarmStartBasis * getBasis() const;
+  /** Add a row created by branching. Takes ownership of the row. */
+  void addBranchCon(DcoLinearConstraint * con);
+  /** Add rows of the ancestors before the rows of this node, in the order
+      DcoTreeNode::installSubProblem() adds them. Takes ownership of the
+      rows. */
+  void addAncestorBranchCons(std::vector<DcoLinearConstraint*> const & cons);
+  /** Get number of rows created by branching. */
+  int numBranchCons() const { return static_cast<int>(branchCons_.size()); }
+  /** Get a row created by branching. */
+  DcoLinearConstraint const * branchCon(int i) const { return branchCons_[i]; }
+  /** Estimate of the memory used by this in bytes. */
+  int memoryUsage() const;
+
+  ///@name Spilling, see DcoNodeSpill
+  //@{
+  /** Position in the spill file, -1 if this is not spilled. */
+  long long spillPos() const { return spillPos_; }
+  /** Size in the spill file. */
+  int spillSize() const { return spillSize_; }
+  /** Mark this as written to the spill file at pos and release bound
+      modifications, cuts, the basis and the branching rows. */
+  void releaseSpilled(long long pos, int size);
+  /** Take bound modifications, cuts, the basis and the branching rows of
+      other, a description decoded from the spill file, and mark this as not
+      spilled. */
+  void restoreSpilled(DcoNodeDesc * other);
+  //@}
 
   ///@name Encode and Decode functions
   //@{
@@ -0,0 +1,216 @@
+#include <cstdio>
+#include <vector>
+#include <sstream>
+#include <algorithm>
+#include <functional>
+#include <unistd.h>
+
+#include <CoinMessageHandler.hpp>
+#include <CoinError.hpp>
+
+#include <AlpsEncoded.h>
+
+#include "DcoNodeSpill.hpp"
+#include "DcoModel.hpp"
+#include "DcoMessage.hpp"
+#include "DcoNodeDesc.hpp"
+
+// Memory of open nodes is checked every this many nodes.
+#define DISCO_SPILL_CHECK_FREQ 100
+
+DcoNodeSpill::DcoNodeSpill(DcoModel * model) {
+  model_ = model;
+  fileSize_ = 0;
+  numSpilled_ = 0;
+  numNodesSinceCheck_ = 0;
+  disabled_ = false;
+}
+
+DcoNodeSpill::~DcoNodeSpill() {
+  if (file_.is_open()) {
+    file_.close();
+  }
+  if (!fileName_.empty()) {
+    std::remove(fileName_.c_str());
+  }
+}
+
+void DcoNodeSpill::checkMemory() {
+  double limit = model_->dcoPar()->entry(DcoParams::nodeMemoryLimit);
+  if (limit<=0.0 or disabled_) {
+    return;
+  }
+  if (++numNodesSinceCheck_ < DISCO_SPILL_CHECK_FREQ) {
+    return;
+  }
+  numNodesSinceCheck_ = 0;
+  // limit is in megabytes
+  double limit_bytes = limit*1024.0*1024.0;
+  std::vector<AlpsTreeNode*> nodes;
+  model_->getPoolNodes(nodes);
+  double usage = 0.0;
+  std::vector<std::pair<double, DcoNodeDesc*> > candidates;
+  for (long unsigned int i=0; i<nodes.size(); ++i) {
+    DcoNodeDesc * desc = dynamic_cast<DcoNodeDesc*>(nodes[i]->getDesc());
+    usage += desc->memoryUsage();
+    if (desc->spillPos()<0 and desc->getCons()->numAdd==0) {
+      candidates.push_back(std::make_pair(nodes[i]->getQuality(), desc));
+    }
+  }
+  if (usage <= limit_bytes) {
+    return;
+  }
+  // worst bounds first
+  std::sort(candidates.begin(), candidates.end(),
+            std::greater<std::pair<double, DcoNodeDesc*> >());
+  int num_spilled = 0;
+  for (long unsigned int i=0; i<candidates.size() and usage>0.8*limit_bytes;
+       ++i) {
+    DcoNodeDesc * desc = candidates[i].second;
+    int usage_before = desc->memoryUsage();
+    if (!spill(desc)) {
+      disabled_ = true;
+      model_->dcoMessageHandler_->message(DISCO_NODE_SPILL_FAILED,
+                                          *model_->dcoMessages_)
+        << model_->broker()->getProcRank()
+        << fileName_.c_str()
+        << CoinMessageEol;
+      break;
+    }
+    usage -= usage_before - desc->memoryUsage();
+    num_spilled++;
+  }
+  model_->dcoMessageHandler_->message(DISCO_NODE_SPILL,
+                                      *model_->dcoMessages_)
+    << model_->broker()->getProcRank()
+    << num_spilled
+    << fileName_.c_str()
+    << numSpilled_
+    << usage/(1024.0*1024.0)
+    << CoinMessageEol;
+}
+
+bool DcoNodeSpill::spill(DcoNodeDesc * desc) {
+  if (!file_.is_open()) {
+    if (fileName_.empty()) {
+      std::stringstream name;
+      name << model_->dcoPar()->entry(DcoParams::nodeSpillFile);
+      if (model_->broker()->getProcType()!=AlpsProcessTypeSerial) {
+        name << "." << model_->broker()->getProcRank();
+      }
+      fileName_ = name.str();
+    }
+    file_.open(fileName_.c_str(), std::ios::in | std::ios::out |
+               std::ios::binary | std::ios::trunc);
+    fileSize_ = 0;
+    if (!file_.is_open()) {
+      return false;
+    }
+  }
+  AlpsEncoded encoded(AlpsKnowledgeTypeNodeDesc);
+  desc->encode(&encoded);
+  int size = encoded.size();
+  long long pos = allocate(size);
+  file_.seekp(pos);
+  file_.write(encoded.data(), size);
+  if (!file_) {
+    file_.clear();
+    holes_[pos] = size;
+    return false;
+  }
+  desc->releaseSpilled(pos, size);
+  numSpilled_++;
+  return true;
+}
+
+long long DcoNodeSpill::allocate(int size) {
+  for (std::map<long long, int>::iterator it=holes_.begin();
+       it!=holes_.end(); ++it) {
+    if (it->second < size) {
+      continue;
+    }
+    long long pos = it->first;
+    int rest = it->second - size;
+    holes_.erase(it);
+    if (rest>0) {
+      holes_[pos+size] = rest;
+    }
+    return pos;
+  }
+  long long pos = fileSize_;
+  fileSize_ += size;
+  return pos;
+}
+
+void DcoNodeSpill::release(long long pos, int size) {
+  numSpilled_--;
+  if (numSpilled_==0) {
+    // all released, the file is truncated when it is opened again.
+    file_.close();
+    fileSize_ = 0;
+    holes_.clear();
+    return;
+  }
+  // merge with the adjacent holes
+  std::map<long long, int>::iterator next = holes_.lower_bound(pos);
+  if (next!=holes_.end() and next->first==pos+size) {
+    size += next->second;
+    holes_.erase(next++);
+  }
+  if (next!=holes_.begin()) {
+    std::map<long long, int>::iterator prev = next;
+    --prev;
+    if (prev->first+prev->second==pos) {
+      pos = prev->first;
+      size += prev->second;
+      holes_.erase(prev);
+    }
+  }
+  if (pos+size==fileSize_) {
+    // hole at the end, shrink the file
+    fileSize_ = pos;
+    file_.flush();
+    if (truncate(fileName_.c_str(), fileSize_)!=0) {
+      // space is reused by later spills anyway
+      holes_[pos] = size;
+      fileSize_ = pos+size;
+    }
+    return;
+  }
+  holes_[pos] = size;
+}
+
+DcoNodeDesc * DcoNodeSpill::read(DcoNodeDesc const * desc) {
+  int size = desc->spillSize();
+  char * buffer = new char[size];
+  file_.seekg(desc->spillPos());
+  file_.read(buffer, size);
+  if (!file_) {
+    file_.clear();
+    delete[] buffer;
+    model_->dcoMessageHandler_->message(DISCO_NODE_SPILL_READ_FAILED,
+                                        *model_->dcoMessages_)
+      << model_->broker()->getProcRank()
+      << fileName_.c_str()
+      << CoinMessageEol;
+    throw CoinError("Can not read spilled node.", "read", "DcoNodeSpill");
+  }
+  // buffer is owned by the encoded object.
+  AlpsEncoded encoded(AlpsKnowledgeTypeNodeDesc, size, buffer);
+  DcoNodeDesc * spilled = new DcoNodeDesc(model_);
+  spilled->setBroker(model_->broker());
+  spilled->decodeToSelf(encoded);
+  return spilled;
+}
+
+void DcoNodeSpill::restore(DcoNodeDesc * desc) {
+  if (desc->spillPos()<0) {
+    return;
+  }
+  long long pos = desc->spillPos();
+  int size = desc->spillSize();
+  DcoNodeDesc * spilled = read(desc);
+  desc->restoreSpilled(spilled);
+  delete spilled;
+  release(pos, size);
+}
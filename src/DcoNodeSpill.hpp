@@ -0,0 +1,90 @@
+#ifndef DcoNodeSpill_hpp_
+#define DcoNodeSpill_hpp_
+
+#include <map>
+#include <fstream>
+#include <string>
+
+class DcoModel;
+class DcoNodeDesc;
+
+/*!
+  Keeps memory of open nodes under DcoParams::nodeMemoryLimit by spilling
+  node descriptions to a file.
+
+  Every DISCO_SPILL_CHECK_FREQ nodes checkMemory() sums the memory of the
+  descriptions of the nodes in the node pools (DcoNodeDesc::memoryUsage()).
+  If it is over the limit, descriptions of the nodes with the worst bounds
+  are written to the spill file with DcoNodeDesc::encode() until the memory
+  is below 80% of the limit. Spilled descriptions are released from memory
+  (see DcoNodeDesc::releaseSpilled()), the tree nodes stay in the pool with
+  their bounds. Nodes with cuts, processed nodes put back to the pool, are
+  not spilled.
+
+  A spilled description is read back with restore() when its node is taken
+  from the pool, processed, branched or sent to another process. Best first
+  search takes the spilled nodes last, they are read back when the nodes in
+  memory are exhausted or pruned without being read back. Either way the
+  space of the description is released with release(). Released space is
+  kept as holes and reused by later spills (first fit), adjacent holes are
+  merged and the file is truncated when a hole reaches its end, so the file
+  is not larger than the descriptions on disk and the holes between them.
+  Every process has its own file, rank is appended to
+  DcoParams::nodeSpillFile in parallel runs.
+*/
+
+class DcoNodeSpill {
+  /// Model of this process.
+  DcoModel * model_;
+  /// Spill file.
+  std::fstream file_;
+  /// Name of the spill file.
+  std::string fileName_;
+  /// Size of the spill file.
+  long long fileSize_;
+  /// Number of descriptions in the spill file.
+  int numSpilled_;
+  /// Unused space in the spill file, sizes keyed by positions.
+  std::map<long long, int> holes_;
+  /// Position to write size bytes, a hole or the end of the file.
+  long long allocate(int size);
+  /// Number of nodes processed since the last memory check.
+  int numNodesSinceCheck_;
+  /// Spilling is disabled when the spill file can not be written.
+  bool disabled_;
+  /// Write desc to the spill file and release it. Returns false if the file
+  /// can not be written.
+  bool spill(DcoNodeDesc * desc);
+public:
+  ///@name Constructors and Destructor.
+  //@{
+  /// Useful constructor.
+  DcoNodeSpill(DcoModel * model);
+  /// Destructor, removes the spill file.
+  virtual ~DcoNodeSpill();
+  //@}
+
+  /// Spill descriptions of the worst nodes if memory of open nodes is over
+  /// DcoParams::nodeMemoryLimit. Called for every node processed, checks
+  /// memory every DISCO_SPILL_CHECK_FREQ calls.
+  void checkMemory();
+  /// Read spilled parts of desc back from the spill file. Does nothing if
+  /// desc is not spilled.
+  void restore(DcoNodeDesc * desc);
+  /// Decode spilled desc from the spill file to a new description, desc is
+  /// not changed. Caller owns the returned description.
+  DcoNodeDesc * read(DcoNodeDesc const * desc);
+  /// Release the space of a description in the spill file. Called when a
+  /// description is read back or deleted while spilled.
+  void release(long long pos, int size);
+
+private:
+  /// Disable default constructor.
+  DcoNodeSpill();
+  /// Disable copy constructor.
+  DcoNodeSpill(DcoNodeSpill const & other);
+  /// Disable copy assignment operator.
+  DcoNodeSpill & operator=(DcoNodeSpill const & rhs);
+};
+
+#endif
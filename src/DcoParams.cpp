@@ -25,6 +25,30 @@ void DcoParams::createKeywordList() {
   keys_.push_back(make_pair(std::string("Dco_sharePseudocostSearch"),
                             AlpsParameter(AlpsBoolPar,
                                           sharePseudocostSearch)));
+  keys_.push_back(make_pair(std::string("Dco_branchDisjunction"),
+                            AlpsParameter(AlpsBoolPar,
+                                          branchDisjunction)));
+  keys_.push_back(make_pair(std::string("Dco_strongBranchOa"),
+                            AlpsParameter(AlpsBoolPar,
+                                          strongBranchOa)));
+  keys_.push_back(make_pair(std::string("Dco_heurThread"),
+                            AlpsParameter(AlpsBoolPar,
+                                          heurThread)));
+  keys_.push_back(make_pair(std::string("Dco_lazyModel"),
+                            AlpsParameter(AlpsBoolPar,
+                                          lazyModel)));
+  keys_.push_back(make_pair(std::string("Dco_nodeCompress"),
+                            AlpsParameter(AlpsBoolPar,
+                                          nodeCompress)));
+  keys_.push_back(make_pair(std::string("Dco_rampUpRace"),
+                            AlpsParameter(AlpsBoolPar,
+                                          rampUpRace)));
+  keys_.push_back(make_pair(std::string("Dco_checkpointRestart"),
+                            AlpsParameter(AlpsBoolPar,
+                                          checkpointRestart)));
+  keys_.push_back(make_pair(std::string("Dco_sharedModel"),
+                            AlpsParameter(AlpsBoolPar,
+                                          sharedModel)));
   //--------------------------------------------------------
   // BoolArrayPar
   //--------------------------------------------------------
@@ -100,6 +124,54 @@ void DcoParams::createKeywordList() {
                             AlpsParameter(AlpsIntPar, heurRoundStrategy)));
   keys_.push_back(make_pair(std::string("Dco_heurRoundFreq"),
                             AlpsParameter(AlpsIntPar, heurRoundFreq)));
+  keys_.push_back(make_pair(std::string("Dco_heurFpStrategy"),
+                            AlpsParameter(AlpsIntPar, heurFpStrategy)));
+  keys_.push_back(make_pair(std::string("Dco_heurFpFreq"),
+                            AlpsParameter(AlpsIntPar, heurFpFreq)));
+  keys_.push_back(make_pair(std::string("Dco_heurFpMaxIter"),
+                            AlpsParameter(AlpsIntPar, heurFpMaxIter)));
+  keys_.push_back(make_pair(std::string("Dco_heurDiveFracStrategy"),
+                            AlpsParameter(AlpsIntPar, heurDiveFracStrategy)));
+  keys_.push_back(make_pair(std::string("Dco_heurDivePseudoStrategy"),
+                            AlpsParameter(AlpsIntPar, heurDivePseudoStrategy)));
+  keys_.push_back(make_pair(std::string("Dco_heurDiveVecLenStrategy"),
+                            AlpsParameter(AlpsIntPar, heurDiveVecLenStrategy)));
+  keys_.push_back(make_pair(std::string("Dco_heurDiveGuidedStrategy"),
+                            AlpsParameter(AlpsIntPar, heurDiveGuidedStrategy)));
+  keys_.push_back(make_pair(std::string("Dco_heurDiveFreq"),
+                            AlpsParameter(AlpsIntPar, heurDiveFreq)));
+  keys_.push_back(make_pair(std::string("Dco_heurRinsStrategy"),
+                            AlpsParameter(AlpsIntPar, heurRinsStrategy)));
+  keys_.push_back(make_pair(std::string("Dco_heurRinsFreq"),
+                            AlpsParameter(AlpsIntPar, heurRinsFreq)));
+  keys_.push_back(make_pair(std::string("Dco_heurRensStrategy"),
+                            AlpsParameter(AlpsIntPar, heurRensStrategy)));
+  keys_.push_back(make_pair(std::string("Dco_heurLnsNodeLimit"),
+                            AlpsParameter(AlpsIntPar, heurLnsNodeLimit)));
+  keys_.push_back(make_pair(std::string("Dco_heurCrossoverStrategy"),
+                            AlpsParameter(AlpsIntPar, heurCrossoverStrategy)));
+  keys_.push_back(make_pair(std::string("Dco_heurCrossoverFreq"),
+                            AlpsParameter(AlpsIntPar, heurCrossoverFreq)));
+  keys_.push_back(make_pair(std::string("Dco_heurCrossoverNumSols"),
+                            AlpsParameter(AlpsIntPar, heurCrossoverNumSols)));
+  keys_.push_back(make_pair(std::string("Dco_heurLocalBranchStrategy"),
+                            AlpsParameter(AlpsIntPar, heurLocalBranchStrategy)));
+  keys_.push_back(make_pair(std::string("Dco_heurLocalBranchFreq"),
+                            AlpsParameter(AlpsIntPar, heurLocalBranchFreq)));
+  keys_.push_back(make_pair(std::string("Dco_heurLocalBranchRadius"),
+                            AlpsParameter(AlpsIntPar, heurLocalBranchRadius)));
+  keys_.push_back(make_pair(std::string("Dco_heurStallNodes"),
+                            AlpsParameter(AlpsIntPar, heurStallNodes)));
+  keys_.push_back(make_pair(std::string("Dco_solPoolSize"),
+                            AlpsParameter(AlpsIntPar, solPoolSize)));
+  keys_.push_back(make_pair(std::string("Dco_numThreads"),
+                            AlpsParameter(AlpsIntPar, numThreads)));
+  keys_.push_back(make_pair(std::string("Dco_raceNodeLimit"),
+                            AlpsParameter(AlpsIntPar, raceNodeLimit)));
+  keys_.push_back(make_pair(std::string("Dco_heurRepairStrategy"),
+                            AlpsParameter(AlpsIntPar, heurRepairStrategy)));
+  keys_.push_back(make_pair(std::string("Dco_heurRepairFreq"),
+                            AlpsParameter(AlpsIntPar, heurRepairFreq)));
   keys_.push_back(make_pair(std::string("Dco_lookAhead"),
                             AlpsParameter(AlpsIntPar, lookAhead)));
   keys_.push_back(make_pair(std::string("Dco_pseudoReliability"),
@@ -137,6 +209,9 @@ void DcoParams::createKeywordList() {
                             AlpsParameter(AlpsIntPar, presolveNumPass)));
   keys_.push_back(make_pair(std::string("Dco_approxNumPass"),
                             AlpsParameter(AlpsIntPar, approxNumPass)));
+  keys_.push_back(make_pair(std::string("Dco_strongBranchOaMaxSupports"),
+                            AlpsParameter(AlpsIntPar,
+                                          strongBranchOaMaxSupports)));
   //--------------------------------------------------------
   // Double Parameters.
   //--------------------------------------------------------
@@ -168,9 +243,35 @@ void DcoParams::createKeywordList() {
                             AlpsParameter(AlpsDoublePar, presolveTolerance)));
   keys_.push_back(make_pair(std::string("Dco_approxFactor"),
                             AlpsParameter(AlpsDoublePar, approxFactor)));
+  keys_.push_back(make_pair(std::string("Dco_branchHistoryDecay"),
+                            AlpsParameter(AlpsDoublePar, branchHistoryDecay)));
+  keys_.push_back(make_pair(std::string("Dco_heurDiveIterRatio"),
+                            AlpsParameter(AlpsDoublePar, heurDiveIterRatio)));
+  keys_.push_back(make_pair(std::string("Dco_heurLnsTimeLimit"),
+                            AlpsParameter(AlpsDoublePar, heurLnsTimeLimit)));
+  keys_.push_back(make_pair(std::string("Dco_heurLnsMinFixRatio"),
+                            AlpsParameter(AlpsDoublePar, heurLnsMinFixRatio)));
+  keys_.push_back(make_pair(std::string("Dco_heurTimeShare"),
+                            AlpsParameter(AlpsDoublePar, heurTimeShare)));
+  keys_.push_back(make_pair(std::string("Dco_statsInterval"),
+                            AlpsParameter(AlpsDoublePar, statsInterval)));
+  keys_.push_back(make_pair(std::string("Dco_raceTimeLimit"),
+                            AlpsParameter(AlpsDoublePar, raceTimeLimit)));
+  keys_.push_back(make_pair(std::string("Dco_checkpointInterval"),
+                            AlpsParameter(AlpsDoublePar, checkpointInterval)));
+  keys_.push_back(make_pair(std::string("Dco_nodeMemoryLimit"),
+                            AlpsParameter(AlpsDoublePar, nodeMemoryLimit)));
 //--------------------------------------------------------
   // String Parameters.
   //--------------------------------------------------------
+  keys_.push_back(make_pair(std::string("Dco_branchHistoryFile"),
+                            AlpsParameter(AlpsStringPar, branchHistoryFile)));
+  keys_.push_back(make_pair(std::string("Dco_startSolutionFile"),
+                            AlpsParameter(AlpsStringPar, startSolutionFile)));
+  keys_.push_back(make_pair(std::string("Dco_checkpointFile"),
+                            AlpsParameter(AlpsStringPar, checkpointFile)));
+  keys_.push_back(make_pair(std::string("Dco_nodeSpillFile"),
+                            AlpsParameter(AlpsStringPar, nodeSpillFile)));
 }
 
 //#############################################################################
@@ -188,6 +289,14 @@ void DcoParams::setDefaultEntries() {
   // presolve parameters
   setEntry(presolveKeepIntegers, true);
   setEntry(presolveTransform, true);
+  setEntry(branchDisjunction, false);
+  setEntry(strongBranchOa, true);
+  setEntry(heurThread, false);
+  setEntry(lazyModel, false);
+  setEntry(nodeCompress, false);
+  setEntry(rampUpRace, false);
+  setEntry(checkpointRestart, false);
+  setEntry(sharedModel, false);
   //-------------------------------------------------------------
   // Int Parameters.
   //-------------------------------------------------------------
@@ -224,8 +333,32 @@ void DcoParams::setDefaultEntries() {
   setEntry(difference, -1);
   setEntry(heurStrategy, DcoHeurStrategyPeriodic);
   setEntry(heurCallFrequency, 1);
-  setEntry(heurRoundStrategy, DcoHeurStrategyPeriodic);
+  setEntry(heurRoundStrategy, DcoHeurStrategyAuto);
   setEntry(heurRoundFreq, 1);
+  setEntry(heurFpStrategy, DcoHeurStrategyBeforeRoot);
+  setEntry(heurFpFreq, 100);
+  setEntry(heurFpMaxIter, 50);
+  setEntry(heurDiveFracStrategy, DcoHeurStrategyNone);
+  setEntry(heurDivePseudoStrategy, DcoHeurStrategyNone);
+  setEntry(heurDiveVecLenStrategy, DcoHeurStrategyNone);
+  setEntry(heurDiveGuidedStrategy, DcoHeurStrategyNone);
+  setEntry(heurDiveFreq, 10);
+  setEntry(heurRinsStrategy, DcoHeurStrategyNone);
+  setEntry(heurRinsFreq, 100);
+  setEntry(heurRensStrategy, DcoHeurStrategyNone);
+  setEntry(heurLnsNodeLimit, 500);
+  setEntry(heurCrossoverStrategy, DcoHeurStrategyNone);
+  setEntry(heurCrossoverFreq, 100);
+  setEntry(heurCrossoverNumSols, 3);
+  setEntry(heurLocalBranchStrategy, DcoHeurStrategyNone);
+  setEntry(heurLocalBranchFreq, 100);
+  setEntry(heurLocalBranchRadius, 10);
+  setEntry(heurStallNodes, 1000);
+  setEntry(solPoolSize, 10);
+  setEntry(numThreads, 1);
+  setEntry(raceNodeLimit, 200);
+  setEntry(heurRepairStrategy, DcoHeurStrategyPeriodic);
+  setEntry(heurRepairFreq, 1);
   setEntry(lookAhead, 4);
   setEntry(pseudoReliability, 8);
   setEntry(sharePcostDepth, 30);
@@ -245,6 +378,7 @@ void DcoParams::setDefaultEntries() {
   setEntry(logLevel, 2);
   setEntry(presolveNumPass, 5);
   setEntry(approxNumPass, 50);
+  setEntry(strongBranchOaMaxSupports, 1000);
   //-------------------------------------------------------------
   // Double Parameters
   //-------------------------------------------------------------
@@ -263,8 +397,21 @@ void DcoParams::setDefaultEntries() {
   setEntry(presolveTolerance, 0.0);
   // approximation factor, used in OA
   setEntry(approxFactor, 1.0);
+  setEntry(branchHistoryDecay, 0.5);
+  setEntry(heurDiveIterRatio, 0.05);
+  setEntry(heurLnsTimeLimit, 30.0);
+  setEntry(heurLnsMinFixRatio, 0.3);
+  setEntry(heurTimeShare, 0.1);
+  setEntry(statsInterval, 0.0);
+  setEntry(raceTimeLimit, 60.0);
+  setEntry(checkpointInterval, 0.0);
+  setEntry(nodeMemoryLimit, 0.0);
 
   //-------------------------------------------------------------
   // String Parameters
   //-------------------------------------------------------------
+  setEntry(branchHistoryFile, "");
+  setEntry(startSolutionFile, "");
+  setEntry(checkpointFile, "disco.ckpt");
+  setEntry(nodeSpillFile, "disco.spill");
 }
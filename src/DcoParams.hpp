@@ -26,6 +26,33 @@ public:
     /// presolve boolean parameters
     presolveKeepIntegers,
     presolveTransform,
+    /// Branch on split disjunctions of integral rows. Default: false
+    branchDisjunction,
+    /// Use an LP keeping the outer approximation of the node relaxation for
+    /// strong branching in conic solver builds. The LP is built only when
+    /// branchStrategy or branchStrategyRampUp is strong branching.
+    /// Default: true
+    strongBranchOa,
+    /// Run heuristics in a background thread on a copy of the solver, see
+    /// DcoHeurWorker. Default: false
+    heurThread,
+    /// Processes other than the master read the input file themselves, the
+    /// master sends only the rows it adds in preprocessing. The input file
+    /// should be readable by all processes. Default: false
+    lazyModel,
+    /// Compress encoded node descriptions with zlib, ignored if DisCO is
+    /// built without zlib (COIN_HAS_ZLIB). Default: false
+    nodeCompress,
+    /// Race parameter variants before the search in MPI builds, see
+    /// DcoRacing. Default: false
+    rampUpRace,
+    /// Resume the search from DcoParams::checkpointFile, serial builds only,
+    /// see DcoCheckpoint. Default: false
+    checkpointRestart,
+    /// Constraint matrix, row bounds, objective and cones are kept in a
+    /// shared memory segment, one copy for all processes of a host, see
+    /// DcoSharedModel. Default: false
+    sharedModel,
     //
     endOfChrParams
   };
@@ -85,6 +112,53 @@ public:
     heurCallFrequency,
     heurRoundStrategy,
     heurRoundFreq,
+    /** Feasibility pump, strategy and frequency are as above,
+        DcoHeurStrategyBeforeRoot calls it before the root relaxation is
+        solved. */
+    heurFpStrategy,
+    heurFpFreq,
+    /** Maximum number of feasibility pump iterations. */
+    heurFpMaxIter,
+    /** Diving heuristics, strategies of fractional, pseudocost, vector
+        length and guided diving and their common frequency. Dives are
+        disabled by default, DcoHeurStrategyPeriodic dives every
+        heurDiveFreq nodes. */
+    heurDiveFracStrategy,
+    heurDivePseudoStrategy,
+    heurDiveVecLenStrategy,
+    heurDiveGuidedStrategy,
+    heurDiveFreq,
+    /** Large neighborhood search heuristics, strategies of RINS and RENS,
+        frequency of RINS and node limit of the nested search. They are
+        disabled by default. */
+    heurRinsStrategy,
+    heurRinsFreq,
+    heurRensStrategy,
+    heurLnsNodeLimit,
+    /** Crossover of pool solutions, strategy, frequency and number of pool
+        solutions crossed. Disabled by default. */
+    heurCrossoverStrategy,
+    heurCrossoverFreq,
+    heurCrossoverNumSols,
+    /** Local branching around the best pool solution, strategy, frequency
+        and radius of the neighborhood. Disabled by default. */
+    heurLocalBranchStrategy,
+    heurLocalBranchFreq,
+    heurLocalBranchRadius,
+    /** Crossover and local branching search when the incumbent is not
+        improved for this many nodes. */
+    heurStallNodes,
+    /** Maximum number of solutions in the solution pool. */
+    solPoolSize,
+    /** Number of threads of the shared memory tree search, serial builds
+        only. The search is not threaded if it is 1. */
+    numThreads,
+    /** Node limit of each parameter variant in the race before the search,
+        see DcoRacing. */
+    raceNodeLimit,
+    /** Conic repair of integer feasible points that violate cones. */
+    heurRepairStrategy,
+    heurRepairFreq,
     /** The look ahead of pseudocost. */
     lookAhead,
     /** The reliability of pseudocost. */
@@ -117,6 +191,10 @@ public:
     presolveNumPass,
     // approximation passes, used in OA, overwrites approxFactor
     approxNumPass,
+    /// Maximum number of cone supports kept in the LP used for strong
+    /// branching with DcoParams::strongBranchOa. Supports slack at the LP
+    /// solution are removed first, oldest first. Default: 1000
+    strongBranchOaMaxSupports,
     ///
     endOfIntParams
   };
@@ -155,12 +233,54 @@ public:
     presolveTolerance,
     // approximation factor, used in OA
     approxFactor,
+    /** Weight of the branching history read from branchHistoryFile. Number of
+        observations read are multiplied with this. Default: 0.5 */
+    branchHistoryDecay,
+    /** Solver iterations of each diving heuristic are limited by this
+        times the iterations spent in node relaxations. Default: 0.05 */
+    heurDiveIterRatio,
+    /** Time limit of the nested search of large neighborhood search
+        heuristics in seconds. Default: 30.0 */
+    heurLnsTimeLimit,
+    /** Large neighborhood search is not done if less than this ratio of the
+        integer columns are fixed. Default: 0.3 */
+    heurLnsMinFixRatio,
+    /** Periodic and auto heuristics are not called when the time spent in
+        heuristics exceeds this ratio of the search time. Default: 0.1 */
+    heurTimeShare,
+    /** Every process logs its search statistics (see DcoProcessStats) in
+        this many seconds. Not logged if 0. Default: 0.0 */
+    statsInterval,
+    /** Time limit of each parameter variant in the race before the search
+        in seconds, see DcoRacing. Default: 60.0 */
+    raceTimeLimit,
+    /** The search state is written to checkpointFile every this many
+        seconds, serial builds only. Not written if 0. Default: 0.0 */
+    checkpointInterval,
+    /** Memory limit of open nodes in megabytes, descriptions of the worst
+        nodes are spilled to nodeSpillFile over the limit, see DcoNodeSpill.
+        No limit if 0. Default: 0.0 */
+    nodeMemoryLimit,
     ///
     endOfDblParams
   };
   /** String parameters. */
   enum strParams{
     strDummy,
+    /** File to read pseudocost statistics from at setup and to write them to
+        at the end of the search. Statistics are keyed by column names. Not
+        used if empty. Default: empty */
+    branchHistoryFile,
+    /** File to read a start solution from, column names and values. The
+        start is installed as the incumbent before the root. Not used if
+        empty. Default: empty */
+    startSolutionFile,
+    /** Checkpoint file, see checkpointInterval and checkpointRestart.
+        Default: disco.ckpt */
+    checkpointFile,
+    /** Spill file of node descriptions, see nodeMemoryLimit. Rank is
+        appended in parallel runs. Default: disco.spill */
+    nodeSpillFile,
     //
     endOfStrParams
   };
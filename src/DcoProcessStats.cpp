@@ -0,0 +1,207 @@
+#include <algorithm>
+
+#include <CoinMessageHandler.hpp>
+#include <CoinTime.hpp>
+
+#include "DcoProcessStats.hpp"
+#include "DcoModel.hpp"
+#include "DcoMessage.hpp"
+#include "DcoConGenerator.hpp"
+#include "DcoHeuristic.hpp"
+
+#ifdef COIN_HAS_MPI
+#include <mpi.h>
+#endif
+
+// Number of entries of a process before generator and heuristic entries,
+// see pack().
+#define DISCO_PROC_STATS_HEADER 6
+
+DcoProcessStats::DcoProcessStats(DcoModel * model) {
+  model_ = model;
+  startTime_ = CoinWallclockTime();
+  nodeTime_ = 0.0;
+  relaxTime_ = 0.0;
+  lastLogTime_ = startTime_;
+}
+
+DcoProcessStats::~DcoProcessStats() {
+}
+
+int DcoProcessStats::numCuts() const {
+  int num_cuts = 0;
+  for (long unsigned int k=0; k<model_->numConGenerators(); ++k) {
+    num_cuts += model_->conGenerators(k)->stats().numConsGenerated();
+  }
+  return num_cuts;
+}
+
+int DcoProcessStats::numSolutions() const {
+  int num_sols = 0;
+  for (long unsigned int k=0; k<model_->numHeuristics(); ++k) {
+    num_sols += model_->heuristics(k)->stats().numSolutions();
+  }
+  return num_sols;
+}
+
+// Layout: number of nodes, wall clock time, node time, relaxation time,
+// number of generators, number of heuristics, then calls, cuts and time of
+// each generator, then calls, solutions and time of each heuristic.
+void DcoProcessStats::pack(std::vector<double> & data) const {
+  data.clear();
+  data.push_back(model_->broker()->getNumNodesProcessed());
+  data.push_back(CoinWallclockTime()-startTime_);
+  data.push_back(nodeTime_);
+  data.push_back(relaxTime_);
+  data.push_back(model_->numConGenerators());
+  data.push_back(model_->numHeuristics());
+  for (long unsigned int k=0; k<model_->numConGenerators(); ++k) {
+    DcoConGeneratorStats const & stats = model_->conGenerators(k)->stats();
+    data.push_back(stats.numCalls());
+    data.push_back(stats.numConsGenerated());
+    data.push_back(stats.time());
+  }
+  for (long unsigned int k=0; k<model_->numHeuristics(); ++k) {
+    DcoHeurStats const & stats = model_->heuristics(k)->stats();
+    data.push_back(stats.numCalls());
+    data.push_back(stats.numSolutions());
+    data.push_back(stats.time());
+  }
+}
+
+void DcoProcessStats::periodicLog() {
+  double interval = model_->dcoPar()->entry(DcoParams::statsInterval);
+  if (interval<=0.0) {
+    return;
+  }
+  double now = CoinWallclockTime();
+  if (now-lastLogTime_ < interval) {
+    return;
+  }
+  lastLogTime_ = now;
+  double wall_time = now-startTime_;
+  model_->dcoMessageHandler_->message(DISCO_PROC_STATS,
+                                      *model_->dcoMessages_)
+    << model_->broker()->getProcRank()
+    << model_->broker()->getNumNodesProcessed()
+    << nodeTime_
+    << relaxTime_
+    << wall_time-nodeTime_
+    << numCuts()
+    << numSolutions()
+    << CoinMessageEol;
+}
+
+void DcoProcessStats::report() {
+#ifdef COIN_HAS_MPI
+  // Alps master is rank 0.
+  int rank;
+  int num_procs;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+  std::vector<double> data;
+  pack(data);
+  int size = static_cast<int>(data.size());
+  std::vector<int> sizes(num_procs);
+  MPI_Gather(&size, 1, MPI_INT, &sizes[0], 1, MPI_INT, 0, MPI_COMM_WORLD);
+  std::vector<int> displs(num_procs, 0);
+  for (int p=1; p<num_procs; ++p) {
+    displs[p] = displs[p-1] + sizes[p-1];
+  }
+  std::vector<double> all_data;
+  if (rank==0) {
+    all_data.resize(displs[num_procs-1]+sizes[num_procs-1]);
+  }
+  MPI_Gatherv(&data[0], size, MPI_DOUBLE,
+              rank==0 ? &all_data[0] : NULL, &sizes[0], &displs[0],
+              MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  if (rank!=0) {
+    return;
+  }
+  CoinMessageHandler * handler = model_->dcoMessageHandler_;
+  CoinMessages * messages = model_->dcoMessages_;
+  int num_gens = static_cast<int>(model_->numConGenerators());
+  int num_heurs = static_cast<int>(model_->numHeuristics());
+  std::vector<double> gen_sum(3*num_gens, 0.0);
+  std::vector<double> heur_sum(3*num_heurs, 0.0);
+  int min_nodes = 0;
+  int max_nodes = 0;
+  double total_nodes = 0.0;
+  double total_wall = 0.0;
+  double total_idle = 0.0;
+  handler->message(DISCO_PAR_STATS_HEADER, *messages) << CoinMessageEol;
+  for (int p=0; p<num_procs; ++p) {
+    double const * proc = &all_data[displs[p]];
+    int num_nodes = static_cast<int>(proc[0]);
+    double idle = proc[1]-proc[2];
+    // cuts and solutions of this process
+    int p_gens = static_cast<int>(proc[4]);
+    int p_heurs = static_cast<int>(proc[5]);
+    double const * gens = proc+DISCO_PROC_STATS_HEADER;
+    double const * heurs = gens+3*p_gens;
+    int num_cuts = 0;
+    for (int k=0; k<p_gens; ++k) {
+      num_cuts += static_cast<int>(gens[3*k+1]);
+    }
+    int num_sols = 0;
+    for (int k=0; k<p_heurs; ++k) {
+      num_sols += static_cast<int>(heurs[3*k+1]);
+    }
+    // processes set up the same generators and heuristics in the same order
+    if (p_gens==num_gens) {
+      for (int k=0; k<3*num_gens; ++k) {
+        gen_sum[k] += gens[k];
+      }
+    }
+    if (p_heurs==num_heurs) {
+      for (int k=0; k<3*num_heurs; ++k) {
+        heur_sum[k] += heurs[k];
+      }
+    }
+    handler->message(DISCO_PAR_STATS_PROC, *messages)
+      << p
+      << num_nodes
+      << proc[2]
+      << proc[3]
+      << idle
+      << num_cuts
+      << num_sols
+      << CoinMessageEol;
+    if (p==0 or num_nodes<min_nodes) {
+      min_nodes = num_nodes;
+    }
+    max_nodes = std::max(max_nodes, num_nodes);
+    total_nodes += num_nodes;
+    total_wall += proc[1];
+    total_idle += idle;
+  }
+  handler->message(DISCO_PAR_STATS_BALANCE, *messages)
+    << min_nodes
+    << max_nodes
+    << total_nodes/num_procs
+    << (total_wall>0.0 ? 100.0*total_idle/total_wall : 0.0)
+    << CoinMessageEol;
+  for (int k=0; k<num_gens; ++k) {
+    if (gen_sum[3*k]>0.0) {
+      handler->message(DISCO_CUT_STATS_FINAL, *messages)
+        << model_->conGenerators(k)->name()
+        << static_cast<int>(gen_sum[3*k])
+        << static_cast<int>(gen_sum[3*k+1])
+        << gen_sum[3*k+2]
+        << model_->conGenerators(k)->strategy()
+        << CoinMessageEol;
+    }
+  }
+  for (int k=0; k<num_heurs; ++k) {
+    if (heur_sum[3*k]>0.0) {
+      handler->message(DISCO_HEUR_STATS_FINAL, *messages)
+        << model_->heuristics(k)->name()
+        << static_cast<int>(heur_sum[3*k])
+        << static_cast<int>(heur_sum[3*k+1])
+        << heur_sum[3*k+2]
+        << model_->heuristics(k)->strategy()
+        << CoinMessageEol;
+    }
+  }
+#endif
+}
@@ -0,0 +1,72 @@
+#ifndef DcoProcessStats_hpp_
+#define DcoProcessStats_hpp_
+
+#include <vector>
+
+class DcoModel;
+
+/*!
+  Search statistics of a process: nodes processed, time spent in nodes and
+  in relaxations, and the yield of constraint generators and heuristics.
+
+  Every process logs its own statistics every DcoParams::statsInterval
+  seconds of wall clock time. In MPI builds report() gathers the statistics
+  of all processes at the master at the end of the search. The master logs
+  a line for each process, the spread of node counts and idle time, and the
+  generator and heuristic statistics summed over processes.
+
+  Idle time of a process is the wall clock time it did not spend processing
+  nodes, i.e. waiting for work and communicating.
+*/
+
+class DcoProcessStats {
+  /// Model of this process.
+  DcoModel * model_;
+  /// Wall clock time statistics started.
+  double startTime_;
+  /// Wall clock time spent processing nodes.
+  double nodeTime_;
+  /// Wall clock time spent solving relaxations of nodes.
+  double relaxTime_;
+  /// Wall clock time of the last periodic log.
+  double lastLogTime_;
+  /// Number of cuts generated by this process.
+  int numCuts() const;
+  /// Number of solutions found by heuristics of this process.
+  int numSolutions() const;
+  /// Write statistics to data, see report() for the layout.
+  void pack(std::vector<double> & data) const;
+public:
+  ///@name Constructors and Destructor.
+  //@{
+  /// Useful constructor.
+  DcoProcessStats(DcoModel * model);
+  /// Destructor.
+  virtual ~DcoProcessStats();
+  //@}
+
+  ///@name Update statistics
+  //@{
+  /// Add time spent processing a node.
+  void addNodeTime(double t) { nodeTime_ += t; }
+  /// Add time spent solving a relaxation.
+  void addRelaxTime(double t) { relaxTime_ += t; }
+  //@}
+
+  /// Log statistics of this process if DcoParams::statsInterval seconds
+  /// passed since the last log.
+  void periodicLog();
+  /// Gather statistics of all processes at the master and log them. All
+  /// processes should call this, does nothing in serial builds.
+  void report();
+
+private:
+  /// Disable default constructor.
+  DcoProcessStats();
+  /// Disable copy constructor.
+  DcoProcessStats(DcoProcessStats const & other);
+  /// Disable copy assignment operator.
+  DcoProcessStats & operator=(DcoProcessStats const & rhs);
+};
+
+#endif
@@ -0,0 +1,214 @@
+#include <cmath>
+#include <algorithm>
+
+#include <CoinMessageHandler.hpp>
+
+#include <AlpsKnowledgeBrokerSerial.h>
+
+#include "DcoRacing.hpp"
+#include "DcoModel.hpp"
+#include "DcoMessage.hpp"
+#include "DcoSolution.hpp"
+
+#ifdef COIN_HAS_MPI
+#include <mpi.h>
+#endif
+
+// Number of entries of a process in the race results, variant, number of
+// nodes, bound, incumbent value and gap.
+#define DISCO_RACE_STATS_SIZE 5
+
+static char const * variantNames[] = {
+  "default",
+  "strong branching",
+  "no cuts",
+  "periodic cuts",
+  "periodic OA cuts",
+  "no heuristics",
+  "heuristic emphasis"
+};
+
+DcoRacing::DcoRacing(DcoModel * model) {
+  model_ = model;
+  incumbentQuality_ = ALPS_OBJ_MAX;
+}
+
+DcoRacing::~DcoRacing() {
+}
+
+int DcoRacing::numVariants() {
+  return sizeof(variantNames)/sizeof(variantNames[0]);
+}
+
+char const * DcoRacing::variantName(int variant) {
+  return variantNames[variant];
+}
+
+void DcoRacing::setVariant(DcoParams * par, int variant) {
+  switch (variant) {
+  case 0:
+    break;
+  case 1:
+    par->setEntry(DcoParams::branchStrategy, DcoBranchingStrategyStrong);
+    break;
+  case 2:
+    par->setEntry(DcoParams::cutStrategy, DcoCutStrategyNone);
+    break;
+  case 3:
+    par->setEntry(DcoParams::cutStrategy, DcoCutStrategyPeriodic);
+    break;
+  case 4:
+    // outer approximation cuts every 10 nodes, in OA builds they are most
+    // of the bounding effort.
+    par->setEntry(DcoParams::cutOaStrategy, DcoCutStrategyPeriodic);
+    par->setEntry(DcoParams::cutOaFreq, 10);
+    break;
+  case 5:
+    par->setEntry(DcoParams::heurRoundStrategy, DcoHeurStrategyNone);
+    par->setEntry(DcoParams::heurFpStrategy, DcoHeurStrategyNone);
+    par->setEntry(DcoParams::heurDiveFracStrategy, DcoHeurStrategyNone);
+    par->setEntry(DcoParams::heurDivePseudoStrategy, DcoHeurStrategyNone);
+    par->setEntry(DcoParams::heurDiveVecLenStrategy, DcoHeurStrategyNone);
+    par->setEntry(DcoParams::heurDiveGuidedStrategy, DcoHeurStrategyNone);
+    par->setEntry(DcoParams::heurRinsStrategy, DcoHeurStrategyNone);
+    par->setEntry(DcoParams::heurRensStrategy, DcoHeurStrategyNone);
+    par->setEntry(DcoParams::heurCrossoverStrategy, DcoHeurStrategyNone);
+    par->setEntry(DcoParams::heurLocalBranchStrategy, DcoHeurStrategyNone);
+    par->setEntry(DcoParams::heurRepairStrategy, DcoHeurStrategyNone);
+    break;
+  case 6:
+    par->setEntry(DcoParams::heurTimeShare, 0.3);
+    par->setEntry(DcoParams::heurFpStrategy, DcoHeurStrategyPeriodic);
+    par->setEntry(DcoParams::heurFpFreq, 20);
+    par->setEntry(DcoParams::heurDiveGuidedStrategy, DcoHeurStrategyPeriodic);
+    par->setEntry(DcoParams::heurDiveFreq, 10);
+    par->setEntry(DcoParams::heurRinsStrategy, DcoHeurStrategyPeriodic);
+    par->setEntry(DcoParams::heurRinsFreq, 20);
+    par->setEntry(DcoParams::heurRensStrategy, DcoHeurStrategyRoot);
+    break;
+  default:
+    break;
+  }
+}
+
+void DcoRacing::runVariant(int variant, double * stats) {
+#if defined(__OA__)
+  OsiSolverInterface * solver = model_->solver();
+#else
+  OsiConicSolverInterface * solver = model_->solver();
+#endif
+  int num_cols = model_->getNumCoreVariables();
+  std::vector<double> lb(solver->getColLower(),
+                         solver->getColLower()+num_cols);
+  std::vector<double> ub(solver->getColUpper(),
+                         solver->getColUpper()+num_cols);
+  DcoModel * sub = model_->createSubModel(&lb[0], &ub[0]);
+  // variants run the heuristics of the search they stand for.
+  sub->setSubSearchParams(model_->dcoPar()->entry(DcoParams::raceNodeLimit),
+                          model_->dcoPar()->entry(DcoParams::raceTimeLimit),
+                          model_->dcoPar()->entry(DcoParams::cutoff), true);
+  setVariant(sub->dcoPar(), variant);
+
+  char prog_name[] = "disco";
+  char * argv[] = {prog_name};
+  {
+    AlpsKnowledgeBrokerSerial sub_broker(1, argv, *sub);
+    sub_broker.search(sub);
+    double incumbent = sub_broker.getIncumbentValue();
+    double bound;
+    switch (sub_broker.getSolStatus()) {
+    case AlpsExitStatusOptimal:
+      bound = incumbent;
+      break;
+    case AlpsExitStatusInfeasible:
+      bound = ALPS_OBJ_MAX;
+      break;
+    default:
+      bound = std::min(sub_broker.getBestQuality(), incumbent);
+      break;
+    }
+    if (incumbent < ALPS_INC_MAX) {
+      DcoSolution * sol = dynamic_cast<DcoSolution*>
+        (sub_broker.getBestKnowledge(AlpsKnowledgeTypeSolution).first);
+      if (sol) {
+        incumbent_.assign(sol->getValues(), sol->getValues()+num_cols);
+        incumbentQuality_ = sol->getQuality();
+      }
+    }
+    stats[0] = variant;
+    stats[1] = sub_broker.getNumNodesProcessed();
+    stats[2] = bound;
+    stats[3] = incumbent_.empty() ? ALPS_INC_MAX : incumbent;
+    stats[4] = ALPS_INC_MAX;
+    if (!incumbent_.empty()) {
+      stats[4] = (incumbent-bound)/std::max(fabs(incumbent), 1e-10);
+    }
+  }
+  delete sub->solver();
+  delete sub;
+}
+
+void DcoRacing::race() {
+#ifdef COIN_HAS_MPI
+  int rank;
+  int num_procs;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &num_procs);
+  double stats[DISCO_RACE_STATS_SIZE];
+  runVariant(rank%numVariants(), stats);
+  std::vector<double> all_stats(DISCO_RACE_STATS_SIZE*num_procs);
+  MPI_Allgather(stats, DISCO_RACE_STATS_SIZE, MPI_DOUBLE, &all_stats[0],
+                DISCO_RACE_STATS_SIZE, MPI_DOUBLE, MPI_COMM_WORLD);
+
+  // every process picks the same winner from the same results
+  int winner = 0;
+  int sol_owner = 0;
+  for (int p=0; p<num_procs; ++p) {
+    double const * proc = &all_stats[DISCO_RACE_STATS_SIZE*p];
+    double const * best = &all_stats[DISCO_RACE_STATS_SIZE*winner];
+    if (proc[4] < best[4] or (proc[4]==best[4] and proc[2] > best[2])) {
+      winner = p;
+    }
+    if (proc[3] < all_stats[DISCO_RACE_STATS_SIZE*sol_owner+3]) {
+      sol_owner = p;
+    }
+    if (rank==0) {
+      model_->dcoMessageHandler_->message(DISCO_RACE_RESULT,
+                                          *model_->dcoMessages_)
+        << p
+        << variantName(static_cast<int>(proc[0]))
+        << static_cast<int>(proc[1])
+        << proc[2]
+        << proc[3]
+        << (proc[4] < ALPS_INC_MAX ? 100.0*proc[4] : 100.0)
+        << CoinMessageEol;
+    }
+  }
+  int variant = static_cast<int>(all_stats[DISCO_RACE_STATS_SIZE*winner]);
+  if (rank==0) {
+    model_->dcoMessageHandler_->message(DISCO_RACE_WINNER,
+                                        *model_->dcoMessages_)
+      << variantName(variant)
+      << CoinMessageEol;
+  }
+  setVariant(model_->dcoPar(), variant);
+  model_->resetStrategies();
+
+  // share the best solution of the race
+  double value = all_stats[DISCO_RACE_STATS_SIZE*sol_owner+3];
+  if (value < ALPS_INC_MAX) {
+    int num_cols = model_->getNumCoreVariables();
+    if (rank!=sol_owner) {
+      incumbent_.resize(num_cols);
+    }
+    MPI_Bcast(&incumbent_[0], num_cols, MPI_DOUBLE, sol_owner,
+              MPI_COMM_WORLD);
+    MPI_Bcast(&incumbentQuality_, 1, MPI_DOUBLE, sol_owner, MPI_COMM_WORLD);
+    DcoSolution * sol = new DcoSolution(num_cols, &incumbent_[0],
+                                        incumbentQuality_);
+    sol->setBroker(model_->broker_);
+    model_->broker()->addKnowledge(AlpsKnowledgeTypeSolution, sol, value);
+    model_->dcoPar()->setEntry(DcoParams::cutoff, value);
+  }
+#endif
+}
@@ -0,0 +1,68 @@
+#ifndef DcoRacing_hpp_
+#define DcoRacing_hpp_
+
+#include <vector>
+
+class DcoModel;
+class DcoParams;
+
+/*!
+  Racing ramp-up, MPI builds only (DcoParams::rampUpRace).
+
+  Before the search every process runs a parameter variant on the root
+  problem, process p runs variant p modulo the number of variants, so groups
+  of processes share a variant when there are more processes than variants.
+  Variants differ in branching strategy, cut strategy, frequency of the
+  outer approximation cuts and heuristic strategies, see setVariant(). Each
+  variant searches a copy of the model created by DcoModel::createSubModel()
+  with a serial broker for DcoParams::raceNodeLimit nodes and
+  DcoParams::raceTimeLimit seconds.
+
+  The variant with the smallest relative gap wins, ties (for example no
+  variant found a solution) are broken by the bound. All processes set the
+  parameters of the winner and recreate their strategies with
+  DcoModel::resetStrategies(). The best solution found by any variant is
+  broadcast and installed as the incumbent. The trees of the race are
+  discarded, the search starts from the root.
+*/
+
+class DcoRacing {
+  /// Model of this process.
+  DcoModel * model_;
+  /// Best solution of the race, empty if none found.
+  std::vector<double> incumbent_;
+  /// Quality of incumbent_.
+  double incumbentQuality_;
+  /// Run variant on the root problem, write number of nodes, bound and
+  /// incumbent value to stats.
+  void runVariant(int variant, double * stats);
+public:
+  ///@name Constructors and Destructor.
+  //@{
+  /// Useful constructor.
+  DcoRacing(DcoModel * model);
+  /// Destructor.
+  virtual ~DcoRacing();
+  //@}
+
+  /// Number of parameter variants.
+  static int numVariants();
+  /// Name of variant, used in logs.
+  static char const * variantName(int variant);
+  /// Set parameters of variant.
+  static void setVariant(DcoParams * par, int variant);
+  /// Run the race and set up the model of this process with the winning
+  /// variant. All processes should call this before the search, does
+  /// nothing in serial builds.
+  void race();
+
+private:
+  /// Disable default constructor.
+  DcoRacing();
+  /// Disable copy constructor.
+  DcoRacing(DcoRacing const & other);
+  /// Disable copy assignment operator.
+  DcoRacing & operator=(DcoRacing const & rhs);
+};
+
+#endif
@@ -0,0 +1,120 @@
+#include <CoinHelperFunctions.hpp>
+
+#include "DcoRowActivity.hpp"
+#include "DcoModel.hpp"
+
+DcoRowActivity::DcoRowActivity(DcoModel * model, double tol) {
+  byCol_ = model->matrixByCol();
+  byRow_ = model->matrixByRow();
+  rowLb_ = model->rowLB();
+  rowUb_ = model->rowUB();
+  numRows_ = model->getNumCoreLinearConstraints();
+  numCols_ = model->getNumCoreVariables();
+  tol_ = tol;
+  sol_ = new double[numCols_]();
+  activity_ = new double[numRows_]();
+  violated_ = new int[numRows_];
+  numViolated_ = 0;
+  position_ = new int[numRows_];
+  CoinFillN(position_, numRows_, -1);
+}
+
+DcoRowActivity::~DcoRowActivity() {
+  if (sol_) {
+    delete[] sol_;
+    sol_ = NULL;
+  }
+  if (activity_) {
+    delete[] activity_;
+    activity_ = NULL;
+  }
+  if (violated_) {
+    delete[] violated_;
+    violated_ = NULL;
+  }
+  if (position_) {
+    delete[] position_;
+    position_ = NULL;
+  }
+}
+
+void DcoRowActivity::reset(double const * sol) {
+  if (sol!=sol_) {
+    CoinDisjointCopyN(sol, numCols_, sol_);
+  }
+  CoinZeroN(activity_, numRows_);
+  double const * element = byCol_->getElements();
+  int const * row = byCol_->getIndices();
+  int const * start = byCol_->getVectorStarts();
+  int const * length = byCol_->getVectorLengths();
+  for (int i=0; i<numCols_; ++i) {
+    if (sol_[i]) {
+      for (int j=start[i]; j<start[i]+length[i]; ++j) {
+        activity_[row[j]] += sol_[i]*element[j];
+      }
+    }
+  }
+  numViolated_ = 0;
+  CoinFillN(position_, numRows_, -1);
+  for (int i=0; i<numRows_; ++i) {
+    updateViolated(i);
+  }
+}
+
+void DcoRowActivity::move(int col, double delta) {
+  if (delta==0.0) {
+    return;
+  }
+  sol_[col] += delta;
+  double const * element = byCol_->getElements();
+  int const * row = byCol_->getIndices();
+  int start = byCol_->getVectorStarts()[col];
+  int end = start + byCol_->getVectorLengths()[col];
+  for (int j=start; j<end; ++j) {
+    activity_[row[j]] += delta*element[j];
+    updateViolated(row[j]);
+  }
+}
+
+bool DcoRowActivity::canMove(int col, double delta) const {
+  double const * element = byCol_->getElements();
+  int const * row = byCol_->getIndices();
+  int start = byCol_->getVectorStarts()[col];
+  int end = start + byCol_->getVectorLengths()[col];
+  for (int j=start; j<end; ++j) {
+    int i = row[j];
+    if (position_[i]>=0) {
+      continue;
+    }
+    double value = activity_[i] + delta*element[j];
+    if (value < rowLb_[i]-tol_ or value > rowUb_[i]+tol_) {
+      return false;
+    }
+  }
+  return true;
+}
+
+double DcoRowActivity::violation(int row) const {
+  if (activity_[row] > rowUb_[row]+tol_) {
+    return activity_[row] - rowUb_[row];
+  }
+  if (activity_[row] < rowLb_[row]-tol_) {
+    return activity_[row] - rowLb_[row];
+  }
+  return 0.0;
+}
+
+void DcoRowActivity::updateViolated(int row) {
+  bool is_violated = (violation(row)!=0.0);
+  if (is_violated and position_[row]<0) {
+    position_[row] = numViolated_;
+    violated_[numViolated_++] = row;
+  }
+  else if (!is_violated and position_[row]>=0) {
+    // move last entry to the place of row
+    int last = violated_[--numViolated_];
+    violated_[position_[row]] = last;
+    position_[last] = position_[row];
+    position_[row] = -1;
+  }
+}
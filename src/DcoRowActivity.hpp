@@ -0,0 +1,96 @@
+#ifndef DcoRowActivity_hpp_
+#define DcoRowActivity_hpp_
+
+#include <CoinPackedMatrix.hpp>
+
+class DcoModel;
+
+/*!
+  Keeps a point and activities of the core linear rows at the point.
+  Activities are computed once by reset() and updated in O(nnz(column)) when
+  a column moves, see move(). Rows violated more than the tolerance are kept
+  in a set, numViolated() and violated() give the set.
+
+  Row and column views are the ones cached by DcoModel, see
+  DcoModel::matrixByRow() and DcoModel::matrixByCol(), no matrix is copied.
+  The model creates the column ordered matrix when the first DcoRowActivity
+  is created. Rounding, shifting, diving and repair heuristics use this
+  class to check rows.
+*/
+
+class DcoRowActivity {
+  /// Column ordered core matrix.
+  CoinPackedMatrix const * byCol_;
+  /// Row ordered core matrix.
+  CoinPackedMatrix const * byRow_;
+  /// Row bounds.
+  double const * rowLb_;
+  double const * rowUb_;
+  /// Number of core linear rows.
+  int numRows_;
+  /// Number of core columns.
+  int numCols_;
+  /// Feasibility tolerance.
+  double tol_;
+  /// Current point.
+  double * sol_;
+  /// Row activities at the current point.
+  double * activity_;
+  /// Violated rows, first numViolated_ entries are valid.
+  int * violated_;
+  int numViolated_;
+  /// Position of a row in violated_, -1 if the row is not violated.
+  int * position_;
+  /// Add or remove row from the violated set.
+  void updateViolated(int row);
+public:
+  ///@name Constructors and Destructor.
+  //@{
+  /// Useful constructor.
+  DcoRowActivity(DcoModel * model, double tol);
+  /// Destructor.
+  virtual ~DcoRowActivity();
+  //@}
+
+  ///@name Updates
+  //@{
+  /// Set point to sol and compute activities from scratch.
+  void reset(double const * sol);
+  /// Move column col by delta.
+  void move(int col, double delta);
+  /// Returns true if moving column col by delta does not violate rows that
+  /// are not violated now.
+  bool canMove(int col, double delta) const;
+  //@}
+
+  ///@name Querry
+  //@{
+  /// Current point.
+  double const * solution() const { return sol_; }
+  /// Activity of row.
+  double activity(int row) const { return activity_[row]; }
+  /// Violation of row, positive if the activity is above the upper bound,
+  /// negative if it is below the lower bound, 0 if the row is feasible.
+  double violation(int row) const;
+  /// Number of violated rows.
+  int numViolated() const { return numViolated_; }
+  /// Violated rows, size numViolated().
+  int const * violated() const { return violated_; }
+  /// Number of core linear rows.
+  int numRows() const { return numRows_; }
+  /// Column ordered core matrix.
+  CoinPackedMatrix const * byCol() const { return byCol_; }
+  /// Row ordered core matrix.
+  CoinPackedMatrix const * byRow() const { return byRow_; }
+  //@}
+
+private:
+  /// Disable default constructor.
+  DcoRowActivity();
+  /// Disable copy constructor.
+  DcoRowActivity(const DcoRowActivity & other);
+  /// Disable copy assignment operator
+  DcoRowActivity & operator=(const DcoRowActivity & rhs);
+};
+
+#endif
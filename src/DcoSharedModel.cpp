@@ -0,0 +1,385 @@
+#include <algorithm>
+#include <vector>
+#include <sstream>
+#include <cerrno>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <CoinMessageHandler.hpp>
+#include <CoinPackedMatrix.hpp>
+#include <CoinTime.hpp>
+
+#include "DcoSharedModel.hpp"
+#include "DcoModel.hpp"
+#include "DcoMessage.hpp"
+
+// Format version of the segment, increase when the layout changes.
+#define DISCO_SHARED_MODEL_VERSION 2
+// Seconds to wait for the process creating the segment.
+#define DISCO_SHARED_MODEL_WAIT 60.0
+// Seconds to wait for the creator to set the size and write its process id.
+// The creator does it right after opening the segment.
+#define DISCO_SHARED_MODEL_START 1.0
+
+// Layout: header, doubles (row bounds, objective, row values, column
+// values), CoinBigIndex (row starts, column starts), int (row lengths, row
+// indices, column lengths, column indices, cone starts, cone types, cone
+// members). The header has an even number of ints, doubles are aligned.
+// ready is set last by the creator.
+struct DcoSharedModelHeader {
+  int version;
+  int ready;
+  int pid;
+  int numRows;
+  int numCols;
+  int numElements;
+  int numCones;
+  int numConeMembers;
+};
+
+// Write the vectors of matrix packed, starts has size major dimension+1.
+static void writeMatrix(CoinPackedMatrix const & matrix, CoinBigIndex * starts,
+                        int * lengths, int * indices, double * values) {
+  int num_vectors = matrix.getMajorDim();
+  starts[0] = 0;
+  for (int i=0; i<num_vectors; ++i) {
+    CoinShallowPackedVector vec = matrix.getVector(i);
+    int size = vec.getNumElements();
+    lengths[i] = size;
+    starts[i+1] = starts[i] + size;
+    std::copy(vec.getIndices(), vec.getIndices()+size, indices+starts[i]);
+    std::copy(vec.getElements(), vec.getElements()+size, values+starts[i]);
+  }
+}
+
+// False if no process with id pid is running.
+static bool processRunning(int pid) {
+  return kill(pid, 0)==0 or errno!=ESRCH;
+}
+
+DcoSharedModel::DcoSharedModel(DcoModel * model) {
+  model_ = model;
+  segment_ = NULL;
+  size_ = 0;
+  creator_ = false;
+  numRows_ = 0;
+  numCols_ = 0;
+  numElements_ = 0;
+  numCones_ = 0;
+  numConeMembers_ = 0;
+  rowLB_ = NULL;
+  rowUB_ = NULL;
+  objCoef_ = NULL;
+  rowStarts_ = NULL;
+  rowLengths_ = NULL;
+  rowIndices_ = NULL;
+  rowValues_ = NULL;
+  colStarts_ = NULL;
+  colLengths_ = NULL;
+  colIndices_ = NULL;
+  colValues_ = NULL;
+  coneStart_ = NULL;
+  coneMembers_ = NULL;
+  coneType_ = NULL;
+  byRow_ = NULL;
+  byCol_ = NULL;
+}
+
+DcoSharedModel::~DcoSharedModel() {
+  // matrices do not own the arrays in the segment.
+  if (byRow_) {
+    byRow_->releasePackedMatrix();
+    delete byRow_;
+    byRow_ = NULL;
+  }
+  if (byCol_) {
+    byCol_->releasePackedMatrix();
+    delete byCol_;
+    byCol_ = NULL;
+  }
+  if (segment_) {
+    munmap(segment_, size_);
+    segment_ = NULL;
+  }
+  if (creator_) {
+    // processes that mapped the segment keep their mapping.
+    shm_unlink(name_.c_str());
+  }
+}
+
+long unsigned int DcoSharedModel::segmentSize() const {
+  long unsigned int num_bounds = numRows_+numCones_;
+  long unsigned int num_doubles = 2*num_bounds + numCols_ + 2*numElements_;
+  long unsigned int num_big = numRows_+1 + numCols_+1;
+  long unsigned int num_ints = numRows_ + numElements_ + numCols_ +
+    numElements_ + numCones_+1 + numCones_ + numConeMembers_;
+  return sizeof(DcoSharedModelHeader) + num_doubles*sizeof(double) +
+    num_big*sizeof(CoinBigIndex) + num_ints*sizeof(int);
+}
+
+bool DcoSharedModel::setup() {
+  CoinPackedMatrix const * matrix = model_->matrixByRow();
+  numRows_ = matrix->getMajorDim();
+  numCols_ = model_->getNumCoreVariables();
+  numElements_ = 0;
+  for (int i=0; i<numRows_; ++i) {
+    numElements_ += matrix->getVectorLengths()[i];
+  }
+  numCones_ = model_->getNumCoreConicConstraints();
+  numConeMembers_ = numCones_ ? model_->coneStart()[numCones_] : 0;
+  size_ = segmentSize();
+  std::stringstream name;
+  name << "/disco." << std::hex << model_->instanceHash() << std::dec
+       << "." << numRows_;
+  name_ = name.str();
+
+  int rank = model_->broker()->getProcRank();
+  bool status = false;
+  // a stale segment is removed and created again, once.
+  for (int attempt=0; attempt<2; ++attempt) {
+    bool stale = false;
+    int fd = shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd>=0) {
+      creator_ = true;
+      status = create(fd);
+    }
+    else if (errno==EEXIST) {
+      fd = shm_open(name_.c_str(), O_RDONLY, 0);
+      status = fd>=0 and attach(fd, stale);
+    }
+    if (fd>=0) {
+      close(fd);
+    }
+    if (!stale) {
+      break;
+    }
+    if (segment_) {
+      munmap(segment_, size_);
+      segment_ = NULL;
+    }
+    shm_unlink(name_.c_str());
+    size_ = segmentSize();
+    model_->dcoMessageHandler_->message(DISCO_SHARED_MODEL_STALE,
+                                        *model_->dcoMessages_)
+      << rank
+      << name_.c_str()
+      << CoinMessageEol;
+  }
+  if (!status) {
+    model_->dcoMessageHandler_->message(DISCO_SHARED_MODEL_FAILED,
+                                        *model_->dcoMessages_)
+      << rank
+      << name_.c_str()
+      << CoinMessageEol;
+  }
+  else if (creator_) {
+    model_->dcoMessageHandler_->message(DISCO_SHARED_MODEL_CREATE,
+                                        *model_->dcoMessages_)
+      << rank
+      << name_.c_str()
+      << size_/(1024.0*1024.0)
+      << CoinMessageEol;
+  }
+  else {
+    model_->dcoMessageHandler_->message(DISCO_SHARED_MODEL_ATTACH,
+                                        *model_->dcoMessages_)
+      << rank
+      << name_.c_str()
+      << CoinMessageEol;
+  }
+  return status;
+}
+
+bool DcoSharedModel::create(int fd) {
+  if (ftruncate(fd, size_)!=0) {
+    return false;
+  }
+  segment_ = mmap(NULL, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (segment_==MAP_FAILED) {
+    segment_ = NULL;
+    return false;
+  }
+  DcoSharedModelHeader * header =
+    static_cast<DcoSharedModelHeader*>(segment_);
+  header->version = DISCO_SHARED_MODEL_VERSION;
+  header->numRows = numRows_;
+  header->numCols = numCols_;
+  header->numElements = numElements_;
+  header->numCones = numCones_;
+  header->numConeMembers = numConeMembers_;
+  // other processes read the header once they see the process id.
+  __sync_synchronize();
+  header->pid = static_cast<int>(getpid());
+  setArrays();
+  // arrays are read only for the other processes only.
+  int num_bounds = numRows_+numCones_;
+  std::copy(model_->rowLB(), model_->rowLB()+num_bounds,
+            const_cast<double*>(rowLB_));
+  std::copy(model_->rowUB(), model_->rowUB()+num_bounds,
+            const_cast<double*>(rowUB_));
+  std::copy(model_->objCoef(), model_->objCoef()+numCols_,
+            const_cast<double*>(objCoef_));
+  // matrix may have gaps between rows, write rows packed.
+  CoinPackedMatrix const * matrix = model_->matrixByRow();
+  writeMatrix(*matrix, const_cast<CoinBigIndex*>(rowStarts_),
+              const_cast<int*>(rowLengths_), const_cast<int*>(rowIndices_),
+              const_cast<double*>(rowValues_));
+  CoinPackedMatrix by_col;
+  by_col.reverseOrderedCopyOf(*matrix);
+  writeMatrix(by_col, const_cast<CoinBigIndex*>(colStarts_),
+              const_cast<int*>(colLengths_), const_cast<int*>(colIndices_),
+              const_cast<double*>(colValues_));
+  int * cone_start = const_cast<int*>(coneStart_);
+  cone_start[0] = 0;
+  if (numCones_) {
+    std::copy(model_->coneStart(), model_->coneStart()+numCones_+1,
+              cone_start);
+    std::copy(model_->coneType(), model_->coneType()+numCones_,
+              const_cast<int*>(coneType_));
+    std::copy(model_->coneMembers(), model_->coneMembers()+numConeMembers_,
+              const_cast<int*>(coneMembers_));
+  }
+  // data is complete before other processes see the ready flag.
+  __sync_synchronize();
+  header->ready = 1;
+  mprotect(segment_, size_, PROT_READ);
+  return true;
+}
+
+bool DcoSharedModel::attach(int fd, bool & stale) {
+  stale = false;
+  double start_time = CoinWallclockTime();
+  // size is 0 until the creator sets it.
+  struct stat file_stat;
+  while (true) {
+    if (fstat(fd, &file_stat)!=0) {
+      return false;
+    }
+    if (static_cast<long unsigned int>(file_stat.st_size) >=
+        sizeof(DcoSharedModelHeader)) {
+      break;
+    }
+    if (CoinWallclockTime()-start_time > DISCO_SHARED_MODEL_START) {
+      // creator ended before setting the size.
+      stale = true;
+      return false;
+    }
+    usleep(1000);
+  }
+  long unsigned int expected_size = size_;
+  size_ = file_stat.st_size;
+  segment_ = mmap(NULL, size_, PROT_READ, MAP_SHARED, fd, 0);
+  if (segment_==MAP_FAILED) {
+    segment_ = NULL;
+    return false;
+  }
+  DcoSharedModelHeader const volatile * header =
+    static_cast<DcoSharedModelHeader const volatile *>(segment_);
+  // pid is 0 until the creator writes it.
+  while (header->pid==0) {
+    if (CoinWallclockTime()-start_time > DISCO_SHARED_MODEL_START) {
+      stale = true;
+      return false;
+    }
+    usleep(1000);
+  }
+  if (header->version!=DISCO_SHARED_MODEL_VERSION) {
+    // written by another version, it can not be checked.
+    stale = true;
+    return false;
+  }
+  while (header->ready!=1) {
+    if (!processRunning(header->pid)) {
+      // creator ended while writing.
+      stale = true;
+      return false;
+    }
+    if (CoinWallclockTime()-start_time > DISCO_SHARED_MODEL_WAIT) {
+      return false;
+    }
+    usleep(1000);
+  }
+  __sync_synchronize();
+  if (size_!=expected_size or
+      header->numRows!=numRows_ or
+      header->numCols!=numCols_ or
+      header->numElements!=numElements_ or
+      header->numCones!=numCones_ or
+      header->numConeMembers!=numConeMembers_) {
+    // data of another model, left by a process that ended if its creator
+    // is not running.
+    stale = !processRunning(header->pid);
+    return false;
+  }
+  setArrays();
+  return matches();
+}
+
+void DcoSharedModel::setArrays() {
+  DcoSharedModelHeader const * header =
+    static_cast<DcoSharedModelHeader const *>(segment_);
+  int num_bounds = numRows_+numCones_;
+  rowLB_ = reinterpret_cast<double const *>(header+1);
+  rowUB_ = rowLB_+num_bounds;
+  objCoef_ = rowUB_+num_bounds;
+  rowValues_ = objCoef_+numCols_;
+  colValues_ = rowValues_+numElements_;
+  rowStarts_ = reinterpret_cast<CoinBigIndex const *>(colValues_+numElements_);
+  colStarts_ = rowStarts_+numRows_+1;
+  rowLengths_ = reinterpret_cast<int const *>(colStarts_+numCols_+1);
+  rowIndices_ = rowLengths_+numRows_;
+  colLengths_ = rowIndices_+numElements_;
+  colIndices_ = colLengths_+numCols_;
+  coneStart_ = colIndices_+numElements_;
+  coneType_ = coneStart_+numCones_+1;
+  coneMembers_ = coneType_+numCones_;
+  // matrices refer to the arrays, assignMatrix() resets the pointers given
+  // to it.
+  double * values = const_cast<double*>(rowValues_);
+  int * indices = const_cast<int*>(rowIndices_);
+  CoinBigIndex * starts = const_cast<CoinBigIndex*>(rowStarts_);
+  int * lengths = const_cast<int*>(rowLengths_);
+  byRow_ = new CoinPackedMatrix();
+  byRow_->assignMatrix(false, numCols_, numRows_, numElements_, values,
+                       indices, starts, lengths);
+  values = const_cast<double*>(colValues_);
+  indices = const_cast<int*>(colIndices_);
+  starts = const_cast<CoinBigIndex*>(colStarts_);
+  lengths = const_cast<int*>(colLengths_);
+  byCol_ = new CoinPackedMatrix();
+  byCol_->assignMatrix(true, numRows_, numCols_, numElements_, values,
+                       indices, starts, lengths);
+}
+
+bool DcoSharedModel::matches() const {
+  CoinPackedMatrix const * matrix = model_->matrixByRow();
+  for (int i=0; i<numRows_; ++i) {
+    CoinShallowPackedVector row = matrix->getVector(i);
+    int size = row.getNumElements();
+    if (size!=rowSize(i) or
+        !std::equal(row.getIndices(), row.getIndices()+size,
+                    rowIndices(i)) or
+        !std::equal(row.getElements(), row.getElements()+size,
+                    rowValues(i))) {
+      return false;
+    }
+  }
+  int num_bounds = numRows_+numCones_;
+  if (!std::equal(rowLB_, rowLB_+num_bounds, model_->rowLB()) or
+      !std::equal(rowUB_, rowUB_+num_bounds, model_->rowUB()) or
+      !std::equal(objCoef_, objCoef_+numCols_, model_->objCoef())) {
+    return false;
+  }
+  if (numCones_ and
+      (!std::equal(coneStart_, coneStart_+numCones_+1, model_->coneStart()) or
+       !std::equal(coneType_, coneType_+numCones_, model_->coneType()) or
+       !std::equal(coneMembers_, coneMembers_+numConeMembers_,
+                   model_->coneMembers()))) {
+    return false;
+  }
+  return true;
+}
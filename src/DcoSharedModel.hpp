@@ -0,0 +1,139 @@
+#ifndef DcoSharedModel_hpp_
+#define DcoSharedModel_hpp_
+
+#include <string>
+
+#include <CoinTypes.hpp>
+
+class DcoModel;
+class CoinPackedMatrix;
+
+/*!
+  Read only model data in a POSIX shared memory segment, used when
+  DcoParams::sharedModel is set.
+
+  Without it every process keeps the constraint matrix in row and column
+  order, the row bounds, the objective and the cones of the model. With it
+  the segment holds one copy of them for all processes of a host. The first
+  process of a host creating the segment writes the data, the others map it
+  read only. DcoModel::setupSelf() frees the copies of the process and
+  points DcoModel::matrixByRow(), DcoModel::matrixByCol(), DcoModel::rowLB(),
+  DcoModel::rowUB(), DcoModel::objCoef() and the cone arrays to the segment,
+  the DcoLinearConstraint objects refer to the rows in the segment. No MPI
+  calls are made, processes are not synchronized when DcoModel::setupSelf()
+  is called. The segment is named after the instance hash and the number of
+  rows, processes mapping it compare the data to their own before using it.
+  The process that created the segment removes it when it is done,
+  processes that mapped it keep their mapping.
+
+  Data that processes change, i.e. column bounds, stays in the model. The
+  solvers keep their own copy of the matrix, it is owned by the solver.
+
+  # Stale segments
+
+  The creator writes its process id to the segment. A segment whose creator
+  is not running, that has no process id shortly after it is opened or that
+  has another format version is left by a process that ended before
+  removing it. It is removed and created again.
+*/
+
+class DcoSharedModel {
+  /// Model of this process.
+  DcoModel * model_;
+  /// Name of the segment.
+  std::string name_;
+  /// Start of the mapped segment, NULL if not mapped.
+  void * segment_;
+  /// Size of the segment in bytes.
+  long unsigned int size_;
+  /// True if this process created the segment.
+  bool creator_;
+  ///@name Dimensions of the data in the segment.
+  //@{
+  /// Number of linear rows.
+  int numRows_;
+  /// Number of columns.
+  int numCols_;
+  /// Number of nonzeros of linear rows.
+  int numElements_;
+  /// Number of cones.
+  int numCones_;
+  /// Sum of cone sizes.
+  int numConeMembers_;
+  //@}
+  ///@name Arrays in the segment.
+  //@{
+  /// Bounds of linear rows followed by bounds of conic rows.
+  double const * rowLB_;
+  double const * rowUB_;
+  /// Objective coefficients.
+  double const * objCoef_;
+  /// Row ordered matrix, rows are packed.
+  CoinBigIndex const * rowStarts_;
+  int const * rowLengths_;
+  int const * rowIndices_;
+  double const * rowValues_;
+  /// Column ordered matrix, columns are packed.
+  CoinBigIndex const * colStarts_;
+  int const * colLengths_;
+  int const * colIndices_;
+  double const * colValues_;
+  /// Cones, as DcoModel::coneStart(), coneMembers() and coneType().
+  int const * coneStart_;
+  int const * coneMembers_;
+  int const * coneType_;
+  //@}
+  /// Matrices using the arrays in the segment, they do not own them.
+  CoinPackedMatrix * byRow_;
+  CoinPackedMatrix * byCol_;
+  /// Size of the segment for the dimensions above.
+  long unsigned int segmentSize() const;
+  /// Create segment and write data of the model to it.
+  bool create(int fd);
+  /// Map segment created by another process. stale is set if the segment
+  /// is left by a process that is not running.
+  bool attach(int fd, bool & stale);
+  /// Set array pointers into the mapped segment and create the matrices.
+  void setArrays();
+  /// Check whether the data in the segment is the data of the model.
+  bool matches() const;
+public:
+  ///@name Constructors and Destructor.
+  //@{
+  /// Useful constructor.
+  DcoSharedModel(DcoModel * model);
+  /// Destructor, unmaps segment. Removes it if it is created by this.
+  virtual ~DcoSharedModel();
+  //@}
+
+  /// Create or map the segment of the model. Returns false if the segment
+  /// can not be used.
+  bool setup();
+  ///@name Data in the segment, read only.
+  //@{
+  /// Number of nonzeros in row i.
+  int rowSize(int i) const { return rowLengths_[i]; }
+  /// Column indices of row i.
+  int const * rowIndices(int i) const { return rowIndices_+rowStarts_[i]; }
+  /// Coefficients of row i.
+  double const * rowValues(int i) const { return rowValues_+rowStarts_[i]; }
+  CoinPackedMatrix const * matrixByRow() const { return byRow_; }
+  CoinPackedMatrix const * matrixByCol() const { return byCol_; }
+  double const * rowLB() const { return rowLB_; }
+  double const * rowUB() const { return rowUB_; }
+  double const * objCoef() const { return objCoef_; }
+  int const * coneStart() const { return coneStart_; }
+  int const * coneMembers() const { return coneMembers_; }
+  int const * coneType() const { return coneType_; }
+  //@}
+
+private:
+  /// Disable default constructor.
+  DcoSharedModel();
+  /// Disable copy constructor.
+  DcoSharedModel(DcoSharedModel const & other);
+  /// Disable copy assignment operator.
+  DcoSharedModel & operator=(DcoSharedModel const & rhs);
+};
+
+#endif
@@ -0,0 +1,86 @@
+#include <cmath>
+
+#include "DcoSolutionPool.hpp"
+#include "DcoModel.hpp"
+#include "DcoSolution.hpp"
+
+DcoSolutionPool::DcoSolutionPool(DcoModel * model, int max_size) {
+  model_ = model;
+  maxSize_ = max_size;
+  version_ = 0;
+  lastImproveNode_ = -1;
+}
+
+DcoSolutionPool::~DcoSolutionPool() {
+  for (std::vector<DcoSolution*>::iterator it=solutions_.begin();
+       it!=solutions_.end(); ++it) {
+    delete *it;
+  }
+  solutions_.clear();
+}
+
+int DcoSolutionPool::distance(DcoSolution const * a,
+                              DcoSolution const * b) const {
+  int num_int = model_->numIntegerCols();
+  int const * int_cols = model_->integerCols();
+  double const * a_values = a->getValues();
+  double const * b_values = b->getValues();
+  int dist = 0;
+  for (int i=0; i<num_int; ++i) {
+    int col = int_cols[i];
+    if (floor(a_values[col]+0.5) != floor(b_values[col]+0.5)) {
+      dist++;
+    }
+  }
+  return dist;
+}
+
+bool DcoSolutionPool::add(DcoSolution const * sol, int node) {
+  if (maxSize_<=0) {
+    return false;
+  }
+  double quality = sol->getQuality();
+  // find the solution to replace, a solution with the same integer part is
+  // replaced if sol is better and sol is rejected otherwise.
+  int replace = -1;
+  int replace_dist = 0;
+  bool duplicate = false;
+  for (int i=0; i<size(); ++i) {
+    int dist = distance(sol, solutions_[i]);
+    if (dist==0) {
+      if (solutions_[i]->getQuality() <= quality) {
+        return false;
+      }
+      replace = i;
+      duplicate = true;
+      break;
+    }
+    if (solutions_[i]->getQuality() > quality and
+        (replace<0 or dist<replace_dist)) {
+      replace = i;
+      replace_dist = dist;
+    }
+  }
+  if (duplicate or size()>=maxSize_) {
+    if (replace<0) {
+      // worse than all solutions
+      return false;
+    }
+    delete solutions_[replace];
+    solutions_.erase(solutions_.begin()+replace);
+  }
+  DcoSolution * copy = new DcoSolution(model_->getNumCoreVariables(),
+                                       sol->getValues(),
+                                       quality);
+  // insert keeping the order
+  std::vector<DcoSolution*>::iterator it = solutions_.begin();
+  while (it!=solutions_.end() and (*it)->getQuality() <= quality) {
+    ++it;
+  }
+  if (it==solutions_.begin()) {
+    lastImproveNode_ = node;
+  }
+  solutions_.insert(it, copy);
+  version_++;
+  return true;
+}
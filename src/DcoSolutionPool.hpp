@@ -0,0 +1,74 @@
+#ifndef DcoSolutionPool_hpp_
+#define DcoSolutionPool_hpp_
+
+#include <vector>
+
+class DcoModel;
+class DcoSolution;
+
+/*!
+  Keeps a bounded number of good and diverse solutions found by this
+  process. Alps keeps the solutions too, but DisCO uses only the incumbent
+  from the broker.
+
+  Solutions are copied, ordered by quality, best first. A solution with the
+  same integer part as a solution in the pool replaces it if it is better
+  and is not added otherwise. When the pool is full, a new solution replaces
+  the solution closest to it in the integer columns (Hamming distance) among
+  the solutions worse than it, this keeps the pool diverse. Solutions worse
+  than all pool solutions are not added to a full pool.
+
+  Crossover and local branching heuristics work on the pool, see
+  DcoHeurCrossover and DcoHeurLocalBranching.
+*/
+
+class DcoSolutionPool {
+  /// Pointer to the model.
+  DcoModel * model_;
+  /// Maximum number of solutions.
+  int maxSize_;
+  /// Solutions, best first.
+  std::vector<DcoSolution*> solutions_;
+  /// Number of times the pool changed.
+  int version_;
+  /// Number of processed nodes when the best solution is added.
+  int lastImproveNode_;
+  /// Number of integer columns with different values in a and b.
+  int distance(DcoSolution const * a, DcoSolution const * b) const;
+public:
+  ///@name Constructors and Destructor.
+  //@{
+  /// Useful constructor.
+  DcoSolutionPool(DcoModel * model, int max_size);
+  /// Destructor.
+  virtual ~DcoSolutionPool();
+  //@}
+
+  /// Add a copy of sol, node is the number of processed nodes. Returns true
+  /// if sol is added.
+  bool add(DcoSolution const * sol, int node);
+
+  ///@name Querry
+  //@{
+  /// Number of solutions.
+  int size() const { return static_cast<int>(solutions_.size()); }
+  /// Solution i, solution 0 is the best.
+  DcoSolution const * solution(int i) const { return solutions_[i]; }
+  /// Number of times the pool changed, heuristics use it to skip a pool
+  /// they searched before.
+  int version() const { return version_; }
+  /// Number of processed nodes when the best solution is added, -1 if the
+  /// pool is empty.
+  int lastImproveNode() const { return lastImproveNode_; }
+  //@}
+
+private:
+  /// Disable default constructor.
+  DcoSolutionPool();
+  /// Disable copy constructor.
+  DcoSolutionPool(const DcoSolutionPool & other);
+  /// Disable copy assignment operator
+  DcoSolutionPool & operator=(const DcoSolutionPool & rhs);
+};
+
+#endif
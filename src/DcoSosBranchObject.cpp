@@ -0,0 +1,88 @@
+#include "DcoSosBranchObject.hpp"
+#include "DcoMessage.hpp"
+
+DcoSosBranchObject::DcoSosBranchObject(int index, int separator,
+                                       double score, double value)
+  : BcpsBranchObject(DcoBranchingObjectTypeSos, index, score, value) {
+  separator_ = separator;
+}
+
+/// Copy constructor.
+DcoSosBranchObject::DcoSosBranchObject(DcoSosBranchObject const & other)
+  : BcpsBranchObject(other) {
+  separator_ = other.separator();
+}
+
+/// Helpful Copy constructor.
+DcoSosBranchObject::DcoSosBranchObject(BcpsBranchObject const * other)
+  : AlpsKnowledge(other->getType(), other->broker_),
+    BcpsBranchObject(*other) {
+  DcoSosBranchObject const * dco_other =
+    dynamic_cast<DcoSosBranchObject const *>(other);
+  if (dco_other==NULL) {
+    std::cerr << "Fatal error!" << std::endl;
+    throw std::exception();
+  }
+  separator_ = dco_other->separator();
+}
+
+/// Copy assignment operator
+DcoSosBranchObject &
+DcoSosBranchObject::operator=(DcoSosBranchObject const & rhs) {
+  BcpsBranchObject::operator=(rhs);
+  separator_ = rhs.separator();
+  return *this;
+}
+
+DcoSosBranchObject::~DcoSosBranchObject() {
+}
+
+void DcoSosBranchObject::downFixed(DcoModel const * model, int & first,
+                                   int & last) const {
+  int set = index();
+  int size = model->sosStart()[set+1] - model->sosStart()[set];
+  first = separator_+1;
+  last = size;
+}
+
+void DcoSosBranchObject::upFixed(DcoModel const * model, int & first,
+                                 int & last) const {
+  int set = index();
+  first = 0;
+  if (model->sosType()[set]==1) {
+    last = separator_+1;
+  }
+  else {
+    last = separator_;
+  }
+}
+
+/// Encode the content of this into the given AlpsEncoded object.
+AlpsReturnStatus DcoSosBranchObject::encode(AlpsEncoded * encoded) const {
+  AlpsReturnStatus status;
+  status = BcpsBranchObject::encode(encoded);
+  assert(status==AlpsReturnStatusOk);
+  encoded->writeRep(separator_);
+  return status;
+}
+
+/// Decode the given AlpsEncoded object into a new AlpsKnowledge object and
+/// return a pointer to it.
+AlpsKnowledge * DcoSosBranchObject::decode(AlpsEncoded & encoded) const {
+  AlpsReturnStatus status;
+  AlpsKnowledge * new_bo = new DcoSosBranchObject(-1, -1, 0.0, 0.0);
+  status = new_bo->decodeToSelf(encoded);
+  assert(status==AlpsReturnStatusOk);
+  return new_bo;
+}
+
+/// Decode the given AlpsEncoded object into this.
+AlpsReturnStatus DcoSosBranchObject::decodeToSelf(AlpsEncoded & encoded) {
+  AlpsReturnStatus status;
+  // decode Bcps part.
+  status = BcpsBranchObject::decodeToSelf(encoded);
+  assert(status==AlpsReturnStatusOk);
+  // decode fields of DcoSosBranchObject
+  encoded.readRep(separator_);
+  return status;
+}
@@ -0,0 +1,85 @@
+#ifndef DcoSosBranchObject_hpp_
+#define DcoSosBranchObject_hpp_
+
+#include <BcpsBranchObject.h>
+#include "DcoModel.hpp"
+
+/*!
+  Represents a branch object for a special ordered set (SOS) of type 1 or 2.
+
+  # DcoSosBranchObject
+
+  Members of the set are ordered with respect to their weights. Let the
+  members be \f$ x_0, \dots, x_{k-1} \f$ and r be the separator position
+  (separator_).
+
+  For SOS1 sets (at most one member is nonzero), down branch fixes members
+  \f$ x_{r+1}, \dots, x_{k-1} \f$ to 0, up branch fixes \f$ x_0, \dots, x_r
+  \f$ to 0.
+
+  For SOS2 sets (at most two consecutive members are nonzero), down branch
+  fixes members \f$ x_{r+1}, \dots, x_{k-1} \f$ to 0, up branch fixes \f$ x_0,
+  \dots, x_{r-1} \f$ to 0. Member \f$ x_r \f$ is free in both branches.
+
+  index() of this object is the index of the set in DcoModel, value() is the
+  weight of the separator.
+
+ */
+
+class DcoSosBranchObject: virtual public BcpsBranchObject {
+  /// Position of the separator in the set.
+  int separator_;
+public:
+  ///@name Constructor and Destructors.
+  //@{
+  /// Constructor.
+  DcoSosBranchObject(int index, int separator, double score, double value);
+  /// Copy constructor.
+  DcoSosBranchObject(DcoSosBranchObject const & other);
+  /// Helpful Copy constructor.
+  DcoSosBranchObject(BcpsBranchObject const * other);
+  /// Copy assignment operator
+  DcoSosBranchObject & operator=(DcoSosBranchObject const & rhs);
+  /// Destructor.
+  virtual ~DcoSosBranchObject();
+  //@}
+
+  ///@name Virtual functions inherited from BcpsBranchObject
+  /// The number of branch arms created for this branch object.
+  virtual int numBranches() const { return 2; }
+  /// The number of branch arms left to be evaluated.
+  virtual int numBranchesLeft() const { return 2; }
+  /// Spit out a branch and, update this or superclass fields if necessary.
+  virtual double branch(bool normalBranch = false) { return 0.0; }
+  //@}
+
+  ///@name Querry functions.
+  //@{
+  /// Get position of the separator.
+  int separator() const { return separator_; }
+  /// Get positions of the members fixed to 0 in the down branch, [first,
+  /// last).
+  void downFixed(DcoModel const * model, int & first, int & last) const;
+  /// Get positions of the members fixed to 0 in the up branch, [first,
+  /// last).
+  void upFixed(DcoModel const * model, int & first, int & last) const;
+  //@}
+
+  ///@name Encode and Decode functions
+  ///@{
+  using AlpsKnowledge::encode;
+  /// Encode the content of this into the given AlpsEncoded object.
+  virtual AlpsReturnStatus encode(AlpsEncoded * encoded) const;
+  /// Decode the given AlpsEncoded object into a new AlpsKnowledge object and
+  /// return a pointer to it.
+  virtual AlpsKnowledge * decode(AlpsEncoded & encoded) const;
+  /// Decode the given AlpsEncoded object into this.
+  virtual AlpsReturnStatus decodeToSelf(AlpsEncoded & encoded);
+  ///@}
+
+private:
+  /// Disable default constructor.
+  DcoSosBranchObject();
+};
+
+#endif
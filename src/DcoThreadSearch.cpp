@@ -0,0 +1,390 @@
+#include <cmath>
+#include <deque>
+#include <algorithm>
+
+#include <CoinMessageHandler.hpp>
+#include <CoinTime.hpp>
+
+#include <AlpsKnowledgeBrokerSerial.h>
+
+#include "DcoThreadSearch.hpp"
+#include "DcoModel.hpp"
+#include "DcoTreeNode.hpp"
+#include "DcoLinearConstraint.hpp"
+#include "DcoMessage.hpp"
+#include "DcoSolution.hpp"
+#include "DcoHeurStartSolution.hpp"
+
+// Number of subtrees created for each thread before the threads start.
+#define DISCO_THREAD_UNITS_PER_THREAD 4
+
+DcoThreadSearch::DcoThreadSearch(DcoModel * model, int num_threads) {
+  model_ = model;
+  numThreads_ = num_threads;
+  numUnits_ = 0;
+  numRampUpLps_ = 0;
+  numPruned_ = 0;
+  numIncomplete_ = 0;
+  openBound_ = ALPS_OBJ_MAX;
+  timeLimitReached_ = false;
+  numNodes_ = 0;
+  nodesLeft_ = model->AlpsPar()->entry(AlpsParams::nodeLimit);
+  numSearched_ = 0;
+  numDonated_ = 0;
+  numBusy_ = 0;
+  numIdle_ = 0;
+  incumbentValue_ = model->dcoPar()->entry(DcoParams::cutoff);
+  incumbentQuality_ = ALPS_INC_MAX;
+  startTime_ = 0.0;
+  pthread_mutex_init(&mutex_, NULL);
+  pthread_cond_init(&poolChanged_, NULL);
+}
+
+DcoThreadSearch::~DcoThreadSearch() {
+  pthread_cond_destroy(&poolChanged_);
+  pthread_mutex_destroy(&mutex_);
+}
+
+void DcoThreadSearch::createUnits() {
+#if defined(__OA__)
+  OsiSolverInterface * solver = model_->cloneSolver();
+#else
+  OsiConicSolverInterface * solver = model_->cloneSolver();
+#endif
+  int num_cols = model_->getNumCoreVariables();
+  int num_relaxed = model_->numRelaxedCols();
+  int const * relaxed = model_->relaxedCols();
+  double * frac = new double[num_relaxed];
+  Unit root;
+  root.lb.assign(solver->getColLower(), solver->getColLower()+num_cols);
+  root.ub.assign(solver->getColUpper(), solver->getColUpper()+num_cols);
+  root.rowStart.push_back(0);
+  root.bound = -ALPS_OBJ_MAX;
+  // split breadth first on the most fractional column
+  std::deque<Unit> open;
+  open.push_back(root);
+  long unsigned int target = numThreads_*DISCO_THREAD_UNITS_PER_THREAD;
+  while (!open.empty() and open.size()+units_.size() < target) {
+    Unit unit = open.front();
+    open.pop_front();
+    for (int i=0; i<num_cols; ++i) {
+      solver->setColBounds(i, unit.lb[i], unit.ub[i]);
+    }
+    solver->resolve();
+    numRampUpLps_++;
+    if (model_->relaxationInfeasible(solver)) {
+      continue;
+    }
+    // bounds are compared with the incumbent, in Alps priority
+    unit.bound = solver->getObjValue()*solver->getObjSense();
+    double const * sol = solver->getColSolution();
+    if (model_->fractionality(sol, frac)==0) {
+      units_.push_back(unit);
+      continue;
+    }
+    int col = -1;
+    double max_frac = 0.0;
+    for (int i=0; i<num_relaxed; ++i) {
+      if (frac[i]>max_frac) {
+        col = relaxed[i];
+        max_frac = frac[i];
+      }
+    }
+    Unit down = unit;
+    down.ub[col] = floor(sol[col]);
+    Unit up = unit;
+    up.lb[col] = ceil(sol[col]);
+    open.push_back(down);
+    open.push_back(up);
+  }
+  units_.insert(units_.end(), open.begin(), open.end());
+  // workers take units from the back, best bound last.
+  std::sort(units_.begin(), units_.end(), boundGreater);
+  numUnits_ = static_cast<int>(units_.size());
+  delete[] frac;
+  delete solver;
+}
+
+void DcoThreadSearch::nodeToUnit(AlpsTreeNode const * node, Unit const & unit,
+                                 Unit & result) const {
+  result = unit;
+  std::vector<DcoLinearConstraint*> rows;
+  dynamic_cast<DcoTreeNode const *>(node)->collectPath(result.lb, result.ub,
+                                                       rows, NULL);
+  for (long unsigned int k=0; k<rows.size(); ++k) {
+    int size = rows[k]->getSize();
+    int const * indices = rows[k]->getIndices();
+    double const * values = rows[k]->getValues();
+    result.rowIndices.insert(result.rowIndices.end(), indices, indices+size);
+    result.rowValues.insert(result.rowValues.end(), values, values+size);
+    result.rowStart.push_back(static_cast<int>(result.rowIndices.size()));
+    result.rowLb.push_back(rows[k]->getLbHard());
+    result.rowUb.push_back(rows[k]->getUbHard());
+    delete rows[k];
+  }
+  result.bound = node->getQuality();
+}
+
+void * DcoThreadSearch::run(void * arg) {
+  DcoThreadSearch * search = static_cast<DcoThreadSearch*>(arg);
+  search->work();
+  return NULL;
+}
+
+void DcoThreadSearch::work() {
+  double time_limit = model_->AlpsPar()->entry(AlpsParams::timeLimit);
+  char prog_name[] = "disco";
+  char * argv[] = {prog_name};
+  pthread_mutex_lock(&mutex_);
+  while (true) {
+    // wait for nodes of busy threads
+    while (units_.empty() and numBusy_>0) {
+      numIdle_++;
+      pthread_cond_wait(&poolChanged_, &mutex_);
+      numIdle_--;
+    }
+    if (units_.empty()) {
+      break;
+    }
+    Unit unit = units_.back();
+    units_.pop_back();
+    if (unit.bound >= incumbentValue_) {
+      numPruned_++;
+      continue;
+    }
+    double remaining_time = time_limit - (CoinWallclockTime()-startTime_);
+    if (remaining_time <= 0.0 or nodesLeft_ <= 0) {
+      numIncomplete_++;
+      openBound_ = std::min(openBound_, unit.bound);
+      timeLimitReached_ = timeLimitReached_ or remaining_time <= 0.0;
+      continue;
+    }
+    // share of the nodes left
+    int node_budget = std::max(1, nodesLeft_/numThreads_);
+    nodesLeft_ -= node_budget;
+    numBusy_++;
+    // createSubModel() clones the master solver, sub models are created one
+    // at a time.
+    DcoModel * sub = model_->createSubModel(&unit.lb[0], &unit.ub[0]);
+    int num_rows = static_cast<int>(unit.rowLb.size());
+    if (num_rows) {
+      sub->addCoreLinearRows(num_rows, &unit.rowStart[0],
+                             &unit.rowIndices[0], &unit.rowValues[0],
+                             &unit.rowLb[0], &unit.rowUb[0]);
+    }
+    // random numbers differ between subtrees
+    sub->randomGenerator()->setSeed(1234567+numSearched_);
+    numSearched_++;
+    sub->setSubSearchParams(node_budget, remaining_time, incumbentValue_);
+    sub->setThreadSearch(this);
+    active_[sub] = &unit;
+    pthread_mutex_unlock(&mutex_);
+
+    int num_nodes = 0;
+    bool failed = false;
+    std::vector<Unit> open;
+    {
+      AlpsKnowledgeBrokerSerial sub_broker(1, argv, *sub);
+      sub_broker.search(sub);
+      // share the last solutions of the subtree
+      exchangeIncumbent(&sub_broker, sub);
+      num_nodes = sub_broker.getNumNodesProcessed();
+      AlpsExitStatus status = sub_broker.getSolStatus();
+      failed = status!=AlpsExitStatusOptimal and
+        status!=AlpsExitStatusInfeasible and
+        status!=AlpsExitStatusNodeLimit and
+        status!=AlpsExitStatusTimeLimit;
+      if (status==AlpsExitStatusNodeLimit or
+          status==AlpsExitStatusTimeLimit) {
+        // stopped at a limit, open nodes go back to the pool
+        std::vector<AlpsTreeNode*> nodes;
+        sub->getPoolNodes(nodes);
+        for (long unsigned int i=0; i<nodes.size(); ++i) {
+          if (dynamic_cast<DcoTreeNode*>(nodes[i])->donated()) {
+            continue;
+          }
+          open.push_back(Unit());
+          nodeToUnit(nodes[i], unit, open.back());
+        }
+      }
+    }
+
+    pthread_mutex_lock(&mutex_);
+    active_.erase(sub);
+    delete sub->solver();
+    delete sub;
+    numNodes_ += num_nodes;
+    nodesLeft_ += std::max(0, node_budget-num_nodes);
+    numBusy_--;
+    if (failed) {
+      numIncomplete_++;
+      openBound_ = std::min(openBound_, unit.bound);
+    }
+    if (!open.empty()) {
+      units_.insert(units_.end(), open.begin(), open.end());
+      std::sort(units_.begin(), units_.end(), boundGreater);
+    }
+    pthread_cond_broadcast(&poolChanged_);
+  }
+  pthread_mutex_unlock(&mutex_);
+}
+
+void DcoThreadSearch::exchangeIncumbent(AlpsKnowledgeBroker * broker,
+                                        DcoModel * model) {
+  double value = broker->getIncumbentValue();
+  pthread_mutex_lock(&mutex_);
+  if (value < incumbentValue_) {
+    // worker has a better solution
+    DcoSolution * sol = dynamic_cast<DcoSolution*>
+      (broker->getBestKnowledge(AlpsKnowledgeTypeSolution).first);
+    if (sol) {
+      incumbentValue_ = value;
+      incumbentQuality_ = sol->getQuality();
+      incumbent_.assign(sol->getValues(),
+                        sol->getValues()+model->getNumCoreVariables());
+    }
+    pthread_mutex_unlock(&mutex_);
+    return;
+  }
+  if (incumbentValue_ < value and !incumbent_.empty()) {
+    // an other thread has a better solution
+    DcoSolution * sol = new DcoSolution(model->getNumCoreVariables(),
+                                        &incumbent_[0], incumbentQuality_);
+    value = incumbentValue_;
+    pthread_mutex_unlock(&mutex_);
+    sol->setBroker(broker);
+    broker->addKnowledge(AlpsKnowledgeTypeSolution, sol, value);
+    model->solver()->setDblParam(OsiDualObjectiveLimit,
+                                 model->objSense()*value);
+    return;
+  }
+  pthread_mutex_unlock(&mutex_);
+}
+
+void DcoThreadSearch::shareNodes(DcoModel * model) {
+  pthread_mutex_lock(&mutex_);
+  int num_wanted = units_.empty() ? numIdle_ : 0;
+  Unit const * unit = NULL;
+  if (num_wanted>0 and active_.count(model)) {
+    unit = active_[model];
+  }
+  pthread_mutex_unlock(&mutex_);
+  if (unit==NULL) {
+    return;
+  }
+  // best open nodes that are not branched yet
+  std::vector<AlpsTreeNode*> nodes;
+  std::vector<AlpsTreeNode*> candidates;
+  model->getPoolNodes(nodes);
+  for (long unsigned int i=0; i<nodes.size(); ++i) {
+    if (nodes[i]->getStatus()==AlpsNodeStatusPregnant or
+        dynamic_cast<DcoTreeNode*>(nodes[i])->donated()) {
+      continue;
+    }
+    candidates.push_back(nodes[i]);
+  }
+  std::vector<std::pair<double, int> > order;
+  for (long unsigned int i=0; i<candidates.size(); ++i) {
+    order.push_back(std::make_pair(candidates[i]->getQuality(),
+                                   static_cast<int>(i)));
+  }
+  std::sort(order.begin(), order.end());
+  int num_donate = std::min(num_wanted, static_cast<int>(order.size()));
+  if (num_donate==0) {
+    return;
+  }
+  // unit is the subtree this thread searches, it does not change while the
+  // search runs.
+  std::vector<Unit> donated(num_donate);
+  for (int k=0; k<num_donate; ++k) {
+    DcoTreeNode * node = dynamic_cast<DcoTreeNode*>
+      (candidates[order[k].second]);
+    nodeToUnit(node, *unit, donated[k]);
+    node->setDonated();
+  }
+  pthread_mutex_lock(&mutex_);
+  units_.insert(units_.end(), donated.begin(), donated.end());
+  std::sort(units_.begin(), units_.end(), boundGreater);
+  numDonated_ += num_donate;
+  pthread_cond_broadcast(&poolChanged_);
+  pthread_mutex_unlock(&mutex_);
+}
+
+void DcoThreadSearch::search() {
+  startTime_ = CoinWallclockTime();
+  // start solution is read once, by the master
+  for (long unsigned int i=0; i<model_->numHeuristics(); ++i) {
+    DcoHeurStartSolution * start =
+      dynamic_cast<DcoHeurStartSolution*>(model_->heuristics(i));
+    if (start==NULL) {
+      continue;
+    }
+    DcoSolution * sol = start->searchSolution();
+    if (sol and model_->objSense()*sol->getQuality() < incumbentValue_) {
+      incumbentQuality_ = sol->getQuality();
+      incumbentValue_ = model_->objSense()*incumbentQuality_;
+      incumbent_.assign(sol->getValues(),
+                        sol->getValues()+model_->getNumCoreVariables());
+    }
+    delete sol;
+  }
+  createUnits();
+  model_->dcoMessageHandler_->message(DISCO_THREAD_RAMPUP,
+                                      *model_->dcoMessages_)
+    << numThreads_
+    << numUnits_
+    << numRampUpLps_
+    << CoinMessageEol;
+
+  std::vector<pthread_t> threads(numThreads_);
+  int num_started = 0;
+  for (int i=0; i<numThreads_; ++i) {
+    if (pthread_create(&threads[num_started], NULL, &DcoThreadSearch::run,
+                       this)==0) {
+      num_started++;
+    }
+  }
+  if (num_started==0) {
+    // search in this thread
+    work();
+  }
+  for (int i=0; i<num_started; ++i) {
+    pthread_join(threads[i], NULL);
+  }
+
+  // install incumbent to the master broker
+  if (!incumbent_.empty()) {
+    DcoSolution * sol = new DcoSolution(model_->getNumCoreVariables(),
+                                        &incumbent_[0], incumbentQuality_);
+    sol->setBroker(model_->broker_);
+    model_->broker()->addKnowledge(AlpsKnowledgeTypeSolution, sol,
+                                   incumbentValue_);
+  }
+  model_->dcoMessageHandler_->message(DISCO_THREAD_STATS,
+                                      *model_->dcoMessages_)
+    << num_started
+    << numSearched_
+    << numPruned_
+    << numIncomplete_
+    << numNodes_
+    << CoinWallclockTime()-startTime_
+    << CoinMessageEol;
+  if (numIncomplete_ > 0) {
+    // search is not complete, report the limit and the best open bound
+    model_->broker()->setSolStatus(timeLimitReached_ ?
+                                   AlpsExitStatusTimeLimit :
+                                   AlpsExitStatusNodeLimit);
+    model_->dcoMessageHandler_->message(DISCO_THREAD_INCOMPLETE,
+                                        *model_->dcoMessages_)
+      << (timeLimitReached_ ? "time" : "node")
+      << numIncomplete_
+      << model_->objSense()*std::min(openBound_, incumbentValue_)
+      << CoinMessageEol;
+  }
+  else if (incumbent_.empty()) {
+    model_->broker()->setSolStatus(AlpsExitStatusInfeasible);
+  }
+  else {
+    model_->broker()->setSolStatus(AlpsExitStatusOptimal);
+  }
+}
@@ -0,0 +1,159 @@
+#ifndef DcoThreadSearch_hpp_
+#define DcoThreadSearch_hpp_
+
+#include <map>
+#include <vector>
+#include <pthread.h>
+
+class AlpsKnowledgeBroker;
+class AlpsTreeNode;
+class DcoModel;
+class DcoLinearConstraint;
+
+/*!
+  Shared memory tree search with DcoParams::numThreads threads, serial
+  builds only.
+
+  The root is split into subtrees before the threads start. Boxes of column
+  bounds are split breadth first on the most fractional integer column of
+  their relaxation until there are DISCO_THREAD_UNITS_PER_THREAD boxes per
+  thread, boxes with infeasible relaxations are dropped. The boxes form the
+  shared node pool, ordered by the bound of their relaxation. A subtree is a
+  box and the rows created by branching on the path to it.
+
+  Each thread repeatedly takes the best subtree from the pool and searches
+  it with its own DcoModel and AlpsKnowledgeBrokerSerial, created by
+  DcoModel::createSubModel(). The model data is copied once per subtree, the
+  worker owns a cloned solver, its own random numbers and its own node
+  scratch state (column bounds installed by
+  DcoTreeNode::installSubProblem()), so nothing is encoded or decoded per
+  node. Output of worker models is off. Subtrees whose bound is not better
+  than the incumbent are pruned.
+
+  # Load balancing
+
+  Threads that find the pool empty wait. Workers call shareNodes() at every
+  node, when there are waiting threads the worker moves its best open nodes
+  to the pool as subtrees (see DcoTreeNode::collectPath()). The moved nodes
+  stay in the pool of the worker marked as donated and are fathomed when the
+  worker selects them.
+
+  # Limits
+
+  AlpsParams::nodeLimit is the total number of nodes of all threads. A
+  subtree is searched with a share of the nodes left, the nodes it does not
+  use are returned. When a subtree stops at its share, its open nodes go
+  back to the pool. AlpsParams::timeLimit is wall clock time of the whole
+  search, subtrees get the time left. Subtrees left when a limit is reached
+  are counted as not completed, the search then reports the limit and the
+  best bound of these subtrees and sets the status of the master broker.
+
+  # Incumbent
+
+  The incumbent is shared. Workers call exchangeIncumbent() at every node,
+  the better of the worker incumbent and the shared incumbent is copied to
+  the other one, so a solution found by any thread prunes nodes of all
+  threads. DisCO keeps cuts in node descriptions, they are local to the
+  subtree of the thread that generated them.
+*/
+
+class DcoThreadSearch {
+  /// A subtree, column bounds, rows created by branching and the bound of
+  /// its relaxation (Alps priority).
+  struct Unit {
+    std::vector<double> lb;
+    std::vector<double> ub;
+    /// Rows in row ordered format, row k has entries rowStart[k] to
+    /// rowStart[k+1]-1.
+    std::vector<int> rowStart;
+    std::vector<int> rowIndices;
+    std::vector<double> rowValues;
+    std::vector<double> rowLb;
+    std::vector<double> rowUb;
+    double bound;
+  };
+  /// Master model, read only while threads run.
+  DcoModel * model_;
+  /// Number of threads.
+  int numThreads_;
+  /// Subtrees not searched yet, best bound last.
+  std::vector<Unit> units_;
+  /// Subtrees being searched, keyed by the model of the worker.
+  std::map<DcoModel const *, Unit const *> active_;
+  /// Number of subtrees created.
+  int numUnits_;
+  /// Number of relaxations solved to create subtrees.
+  int numRampUpLps_;
+  /// Number of subtrees pruned by bound.
+  int numPruned_;
+  /// Number of subtrees not searched to completion (node or time limit).
+  int numIncomplete_;
+  /// Best bound of the subtrees not searched to completion.
+  double openBound_;
+  /// True if a subtree is not searched because of the time limit.
+  bool timeLimitReached_;
+  /// Total number of nodes processed by threads.
+  int numNodes_;
+  /// Number of nodes threads may still process.
+  int nodesLeft_;
+  /// Number of subtrees searched.
+  int numSearched_;
+  /// Number of subtrees given to waiting threads by shareNodes().
+  int numDonated_;
+  /// Number of threads searching a subtree and number of threads waiting
+  /// for one.
+  int numBusy_;
+  int numIdle_;
+  /// Shared incumbent value (Alps priority), values and quality.
+  double incumbentValue_;
+  std::vector<double> incumbent_;
+  double incumbentQuality_;
+  /// Wall clock time the search started.
+  double startTime_;
+  /// Protects all members above while threads run.
+  pthread_mutex_t mutex_;
+  /// Signals waiting threads that the pool changed or a thread finished.
+  pthread_cond_t poolChanged_;
+  /// Split the root into subtrees.
+  void createUnits();
+  /// Create a subtree from an open node of a worker, unit is the subtree
+  /// the worker searches.
+  void nodeToUnit(AlpsTreeNode const * node, Unit const & unit,
+                  Unit & result) const;
+  /// Order of units_, a before b if its bound is larger.
+  static bool boundGreater(Unit const & a, Unit const & b) {
+    return a.bound > b.bound;
+  }
+  /// Thread entry point, arg is this object.
+  static void * run(void * arg);
+  /// Search subtrees until the pool is empty and no thread is busy.
+  void work();
+public:
+  ///@name Constructors and Destructor.
+  //@{
+  /// Useful constructor. model should be set up by the broker.
+  DcoThreadSearch(DcoModel * model, int num_threads);
+  /// Destructor.
+  virtual ~DcoThreadSearch();
+  //@}
+
+  /// Search the tree with the threads, the incumbent and the status are set
+  /// in the broker of the master model at the end.
+  void search();
+  /// Exchange incumbent with a worker broker. Called by workers at every
+  /// node.
+  void exchangeIncumbent(AlpsKnowledgeBroker * broker, DcoModel * model);
+  /// Move open nodes of a worker to the pool if threads are waiting. Called
+  /// by workers at every node.
+  void shareNodes(DcoModel * model);
+
+private:
+  /// Disable default constructor.
+  DcoThreadSearch();
+  /// Disable copy constructor.
+  DcoThreadSearch(const DcoThreadSearch & other);
+  /// Disable copy assignment operator
+  DcoThreadSearch & operator=(const DcoThreadSearch & rhs);
+};
+
+#endif
@@ -1,5 +1,6 @@
 // CoinUtils headers
 #include "CoinUtility.hpp"
+#include "CoinTime.hpp"
 
 // Osi headers
 #include <OsiRowCut.hpp>
@@ -15,8 +16,17 @@
 #include "DcoConGenerator.hpp"
 #include "DcoSolution.hpp"
 #include "DcoBranchObject.hpp"
+#include "DcoSosBranchObject.hpp"
+#include "DcoDisjunctionBranchObject.hpp"
 #include "DcoHeuristic.hpp"
 #include "DcoHeurRounding.hpp"
+#include "DcoHeurScheduler.hpp"
+#include "DcoHeurWorker.hpp"
+#include "DcoSolutionPool.hpp"
+#include "DcoThreadSearch.hpp"
+#include "DcoProcessStats.hpp"
+#include "DcoCheckpoint.hpp"
+#include "DcoNodeSpill.hpp"
 
 // STL headers
 #include <vector>
@@ -46,6 +56,8 @@ DcoTreeNode::DcoTreeNode() {
   bcpStats_.lastImp_ = 0.0;
   bcpStats_.lastObjVal_ = 0.0;
   bcpStats_.startObjVal_ = 0.0;
+  donated_ = false;
+  numInstalledRows_ = 0;
 }
 
 DcoTreeNode::DcoTreeNode(AlpsNodeDesc *& desc) {
@@ -60,6 +72,8 @@ DcoTreeNode::DcoTreeNode(AlpsNodeDesc *& desc) {
   bcpStats_.lastImp_ = 0.0;
   bcpStats_.lastObjVal_ = 0.0;
   bcpStats_.startObjVal_ = 0.0;
+  donated_ = false;
+  numInstalledRows_ = 0;
 }
 
 DcoTreeNode::~DcoTreeNode() {
@@ -78,7 +92,8 @@ AlpsTreeNode * DcoTreeNode::createNewTreeNode(AlpsNodeDesc *& desc) const {
   double frac = (dist_to_floor>dist_to_ceil) ? dist_to_ceil : dist_to_floor;
   double tol = model->dcoPar()->entry(DcoParams::integerTol);
 
-  if (frac < tol) {
+  // branched_index is -1 when branched on a SOS or disjunction.
+  if (branched_index>=0 && frac < tol) {
     model->dcoMessageHandler_->message(DISCO_NODE_BRANCHONINT,
                                        *(model->dcoMessages_))
       << broker()->getProcRank()
@@ -86,8 +101,11 @@ AlpsTreeNode * DcoTreeNode::createNewTreeNode(AlpsNodeDesc *& desc) const {
   }
 
   // Create a new tree node
+  double sol_estimate = dco_node->getSolEstimate();
   DcoTreeNode * node = new DcoTreeNode(desc);
   node->setBroker(broker_);
+  // set solution estimate computed by the parent while branching
+  node->setSolEstimate(sol_estimate);
   desc = NULL;
   return node;
 }
@@ -101,6 +119,7 @@ void DcoTreeNode::convertToExplicit() {
   if (explicit_) {
     return;
   }
+  model->nodeSpill()->restore(node_desc);
   // debug stuff
   std::stringstream debug_msg;
   debug_msg << "["
@@ -165,6 +184,8 @@ void DcoTreeNode::convertToExplicit() {
   // Travel back from this node to the explicit node to
   // collect full description.
   //------------------------------------------------------
+  // branching rows of the ancestors, root first.
+  std::vector<DcoLinearConstraint*> ancestor_cons;
   for(int i=static_cast<int> (leafToRootPath.size()-1); i>-1; --i) {
     DcoNodeDesc * curr = dynamic_cast<DcoNodeDesc*>((leafToRootPath.at(i))->
                                            getDesc());
@@ -202,9 +223,16 @@ void DcoTreeNode::convertToExplicit() {
       soft_bound.upper.val[index] = value;
     }
 
-
-
+    //--------------------------------------
+    // Branching rows of ancestors, the node has its own already.
+    //--------------------------------------
+    if (i>0) {
+      for (int k=0; k<curr->numBranchCons(); ++k) {
+        ancestor_cons.push_back(new DcoLinearConstraint(*curr->branchCon(k)));
+      }
+    }
   } // EOF for (path)
+  node_desc->addAncestorBranchCons(ancestor_cons);
 
   //------------------------------------------
   // Record hard variable bounds. FULL set.
@@ -408,16 +436,136 @@ int DcoTreeNode::generateVariables(BcpsVariablePool * varPool) {
 }
 
 int DcoTreeNode::chooseBranchingObject() {
-  DcoModel * disco_model = dynamic_cast<DcoModel*>(broker_->getModel());
-  CoinMessageHandler * message_handler = disco_model->dcoMessageHandler_;
-  CoinMessages * messages = disco_model->dcoMessages_;
-  message_handler->message(DISCO_NOT_IMPLEMENTED, *messages)
-    << broker()->getProcRank()
-    << __FILE__ << __LINE__ << CoinMessageEol;
-  throw std::exception();
+  DcoModel * model = dynamic_cast<DcoModel*>(broker_->getModel());
+  // SOS sets are not handled by branch strategies, branch on them first.
+  if (chooseSosBranchObject()) {
+    return 0;
+  }
+  if (model->dcoPar()->entry(DcoParams::branchDisjunction) and
+      chooseDisjunctionBranchObject()) {
+    return 0;
+  }
+  model->branchStrategy()->createCandBranchObjects(this);
   return 0;
 }
 
+bool DcoTreeNode::chooseSosBranchObject() {
+  DcoModel * model = dynamic_cast<DcoModel*>(broker_->getModel());
+  int num_sos = model->numSos();
+  if (num_sos==0) {
+    return false;
+  }
+  double const * sol = model->solver()->getColSolution();
+  int const * sos_start = model->sosStart();
+  int const * members = model->sosMembers();
+  double const * weights = model->sosWeights();
+  int best_set = -1;
+  int best_separator = -1;
+  double best_score = 0.0;
+  for (int i=0; i<num_sos; ++i) {
+    int first;
+    int last;
+    if (model->sosFeasible(i, sol, first, last)) {
+      continue;
+    }
+    // score is the total value of members except the largest one.
+    // separator is the last position with weight not larger than weighted
+    // average of the nonzero members.
+    double sum = 0.0;
+    double max = 0.0;
+    double weighted_sum = 0.0;
+    for (int k=first; k<=last; ++k) {
+      double value = fabs(sol[members[sos_start[i]+k]]);
+      sum += value;
+      weighted_sum += value*weights[sos_start[i]+k];
+      max = std::max(max, value);
+    }
+    double average = weighted_sum/sum;
+    // both branches should cut off the current solution, separator is in
+    // [first, last-1] for SOS1 and in [first+1, last-1] for SOS2.
+    int lower = (model->sosType()[i]==1) ? first : first+1;
+    int separator = lower;
+    for (int k=lower; k<last; ++k) {
+      if (weights[sos_start[i]+k]<=average) {
+        separator = k;
+      }
+    }
+    double score = sum - max;
+    if (best_set==-1 or score>best_score) {
+      best_set = i;
+      best_separator = separator;
+      best_score = score;
+    }
+  }
+  if (best_set==-1) {
+    return false;
+  }
+  DcoSosBranchObject * bo =
+    new DcoSosBranchObject(best_set, best_separator, best_score,
+                           weights[sos_start[best_set]+best_separator]);
+  bo->setBroker(broker_);
+  setBranchObject(bo);
+  return true;
+}
+
+bool DcoTreeNode::chooseDisjunctionBranchObject() {
+#if defined(__COLA__)
+  // Cola keeps the rows added to the solver between nodes, rows local to a
+  // subtree can not be removed.
+  return false;
+#else
+  DcoModel * model = dynamic_cast<DcoModel*>(broker_->getModel());
+  double const * sol = model->solver()->getColSolution();
+  double tol = model->dcoPar()->entry(DcoParams::integerTol);
+  std::vector<BcpsConstraint*> & rows = model->getConstraints();
+  int num_rows = model->getNumCoreLinearConstraints();
+  int best_row = -1;
+  double best_frac = tol;
+  double best_activity = 0.0;
+  for (int i=0; i<num_rows; ++i) {
+    DcoLinearConstraint * row = dynamic_cast<DcoLinearConstraint*>(rows[i]);
+    int size = row->getSize();
+    // single member rows are covered by variable branching
+    if (size<2) {
+      continue;
+    }
+    int const * ind = row->getIndices();
+    double const * val = row->getValues();
+    bool integral = true;
+    double activity = 0.0;
+    for (int k=0; k<size; ++k) {
+      if (model->getVariables()[ind[k]]->getIntType()!='I' or
+          val[k]!=floor(val[k])) {
+        integral = false;
+        break;
+      }
+      activity += val[k]*sol[ind[k]];
+    }
+    if (!integral) {
+      continue;
+    }
+    double frac = std::min(activity-floor(activity), ceil(activity)-activity);
+    if (frac>best_frac) {
+      best_row = i;
+      best_frac = frac;
+      best_activity = activity;
+    }
+  }
+  if (best_row==-1) {
+    return false;
+  }
+  DcoLinearConstraint * row =
+    dynamic_cast<DcoLinearConstraint*>(rows[best_row]);
+  DcoDisjunctionBranchObject * bo =
+    new DcoDisjunctionBranchObject(best_row, row->getSize(),
+                                   row->getIndices(), row->getValues(),
+                                   best_frac, best_activity);
+  bo->setBroker(broker_);
+  setBranchObject(bo);
+  return true;
+#endif
+}
+
 int DcoTreeNode::process(bool isRoot, bool rampUp) {
   AlpsNodeStatus status = getStatus();
   DcoModel * model = dynamic_cast<DcoModel*>(broker()->getModel());
@@ -443,6 +591,15 @@ int DcoTreeNode::process(bool isRoot, bool rampUp) {
   // std::cout << "Broker reports quality " << broker()->getIncumbentValue()
   //           << std::endl;
 
+  // node is searched by another thread
+  if (donated_) {
+    setStatus(AlpsNodeStatusFathomed);
+    return AlpsReturnStatusOk;
+  }
+
+  // this node is out of the node pool, read back its spilled description
+  model->nodeSpill()->restore(getDesc());
+
   // check if this can be fathomed
   double rel_gap_limit = model->dcoPar()->entry(DcoParams::optimalRelGap);
   double abs_gap_limit = model->dcoPar()->entry(DcoParams::optimalAbsGap);
@@ -479,7 +636,13 @@ int DcoTreeNode::process(bool isRoot, bool rampUp) {
 
   if (status==AlpsNodeStatusCandidate or
       status==AlpsNodeStatusEvaluated) {
+    // this node is not in the node pool, checkpoint keeps it as open
+    model->checkpoint()->periodicWrite(this);
+    model->nodeSpill()->checkMemory();
+    double start_time = CoinWallclockTime();
     boundingLoop(isRoot, rampUp);
+    model->processStats()->addNodeTime(CoinWallclockTime()-start_time);
+    model->processStats()->periodicLog();
   }
   else if (status==AlpsNodeStatusBranched or
            status==AlpsNodeStatusFathomed or
@@ -493,6 +656,19 @@ int DcoTreeNode::process(bool isRoot, bool rampUp) {
   return AlpsReturnStatusOk;
 }
 
+// Branch strategies may not keep candidate branch objects, infeasibility is
+// computed from the solver solution. Grumpy messages are debug messages,
+// CoinMessageHandler prints them if their bit is set in the log level.
+void DcoTreeNode::grumpyInfeasibility(double & sum_inf, int & num_inf) const {
+  DcoModel * model = dynamic_cast<DcoModel*>(broker_->getModel());
+  sum_inf = 0.0;
+  num_inf = 0;
+  int log_level = model->dcoMessageHandler_->logLevel();
+  if (log_level>0 and (log_level & DISCO_DLOG_GRUMPY)) {
+    num_inf = model->solverFractionality(sum_inf);
+  }
+}
+
 int DcoTreeNode::boundingLoop(bool isRoot, bool rampUp) {
   DcoModel * model = dynamic_cast<DcoModel*>(broker_->getModel());
   CoinMessageHandler * message_handler = model->dcoMessageHandler_;
@@ -505,6 +681,15 @@ int DcoTreeNode::boundingLoop(bool isRoot, bool rampUp) {
   BcpsVariablePool * variablePool = new BcpsVariablePool();
   double cutoff = model->dcoPar()->entry(DcoParams::cutoff);
   installSubProblem();
+  if (model->threadSearch()) {
+    // share incumbent with the other threads
+    model->threadSearch()->exchangeIncumbent(broker(), model);
+    // give open nodes to waiting threads
+    model->threadSearch()->shareNodes(model);
+  }
+  if (isRoot and bcpStats_.numBoundIter_==0) {
+    callHeuristicsBeforeRoot();
+  }
 
   while (keepBounding) {
     keepBounding = false;
@@ -536,18 +721,9 @@ int DcoTreeNode::boundingLoop(bool isRoot, bool rampUp) {
     if ((subproblem_status==BcpsSubproblemStatusOptimal) &&
         (getStatus()==AlpsNodeStatusCandidate or
          getStatus()==AlpsNodeStatusEvaluated)) {
-      double sum_inf = 0.0;
-      int num_inf = 0;
-      int const * relaxedCols = model->relaxedCols();
-      for (int i=0; i<model->numRelaxedCols(); ++i) {
-        int dir;
-        double infeas = dynamic_cast<DcoVariable*>
-          (model->getVariables()[relaxedCols[i]])->infeasibility(model, dir);
-        if (infeas!=0.0) {
-          num_inf++;
-        }
-        sum_inf += infeas;
-      }
+      double sum_inf;
+      int num_inf;
+      grumpyInfeasibility(sum_inf, num_inf);
       message_handler->message(DISCO_GRUMPY_MESSAGE_LONG, *messages)
         << broker()->getProcRank()
         << broker()->timer().getTime()
@@ -637,8 +813,7 @@ int DcoTreeNode::boundingLoop(bool isRoot, bool rampUp) {
     }
     else if (keepBounding==false and do_branch) {
       // branch
-      BcpsBranchStrategy * branchStrategy = model->branchStrategy();
-      branchStrategy->createCandBranchObjects(this);
+      chooseBranchingObject();
       // prepare this node for branching, bookkeeping for differencing.
       // call pregnant setting routine
       processSetPregnant();
@@ -660,16 +835,43 @@ void DcoTreeNode::callHeuristics() {
   DcoModel * model = dynamic_cast<DcoModel*>(broker()->getModel());
   CoinMessageHandler * message_handler = model->dcoMessageHandler_;
   CoinMessages * messages = model->dcoMessages_;
+  DcoHeurScheduler * scheduler = model->heurScheduler();
+  // relative gap of this node, larger than 1 if there is no incumbent
+  double gap = 2.0;
+  double incumbent = broker()->getIncumbentValue();
+  if (incumbent < ALPS_INC_MAX) {
+    gap = (incumbent-quality_)/(fabs(incumbent)+1e-10);
+  }
+  if (model->dcoPar()->entry(DcoParams::heurThread)) {
+    exchangeHeurWorker();
+  }
   long unsigned int num_heur = model->numHeuristics();
   DcoSolution * sol;
   for (long unsigned int i=0; i<num_heur; ++i) {
     DcoHeuristic * curr = model->heuristics(i);
+    // before root heuristics are called in callHeuristicsBeforeRoot()
+    if (!scheduler->select(i, depth_, gap)) {
+      continue;
+    }
+    int num_calls = curr->stats().numCalls();
+    double start_time = CoinCpuTime();
     sol = curr->searchSolution();
+    // heuristics do not resolve SOS sets, they are left to branching.
+    if (sol && !model->sosFeasible(sol->getValues())) {
+      delete sol;
+      sol = NULL;
+    }
+    if (curr->stats().numCalls() > num_calls) {
+      // heuristic did search, it may return early otherwise
+      scheduler->update(i, CoinCpuTime()-start_time, sol!=NULL);
+    }
     if (sol) {
       // set depth
       setDepth(depth_);
       // set index
       setIndex(index_);
+      // keep a copy in the solution pool, broker may delete sol
+      model->solutionPool()->add(sol, broker()->getNumNodesProcessed());
       // Store in Alps pool
       broker()->addKnowledge(AlpsKnowledgeTypeSolution,
                              sol,
@@ -692,6 +894,100 @@ void DcoTreeNode::callHeuristics() {
   }
 }
 
+void DcoTreeNode::exchangeHeurWorker() {
+  DcoModel * model = dynamic_cast<DcoModel*>(broker()->getModel());
+  CoinMessageHandler * message_handler = model->dcoMessageHandler_;
+  CoinMessages * messages = model->dcoMessages_;
+  if (!model->solver()->isProvenOptimal()) {
+    return;
+  }
+  if (model->heurWorker()==NULL) {
+    // the worker copies the solver, start it once the root is solved.
+    model->startHeurWorker();
+  }
+  DcoHeurWorker * worker = model->heurWorker();
+  // store solutions found by the worker, they may be worse than the
+  // incumbent found in the mean time.
+  std::vector<DcoSolution*> sols;
+  worker->takeSolutions(sols);
+  for (std::vector<DcoSolution*>::iterator it=sols.begin();
+       it!=sols.end(); ++it) {
+    DcoSolution * sol = *it;
+    // incumbent value is an Alps priority, quality is the objective value.
+    if (model->objSense()*sol->getQuality() >=
+        broker()->getIncumbentValue()) {
+      delete sol;
+      continue;
+    }
+    // keep a copy in the solution pool, broker may delete sol
+    model->solutionPool()->add(sol, broker()->getNumNodesProcessed());
+    broker()->addKnowledge(AlpsKnowledgeTypeSolution,
+                           sol,
+                           model->objSense() * sol->getQuality());
+    double incum_value = broker()->getIncumbentValue();
+    model->solver()->setDblParam(OsiDualObjectiveLimit,
+                                 model->objSense()*incum_value);
+    message_handler->message(DISCO_HEUR_SOL_FOUND, *messages)
+      << broker()->getProcRank()
+      << "thread"
+      << sol->getQuality()
+      << CoinMessageEol;
+  }
+  // post node solution, dropped if the worker is busy.
+  double const * incumbent = NULL;
+  if (broker()->getIncumbentValue() < ALPS_INC_MAX) {
+    // the incumbent may be stored in an other process
+    DcoSolution * inc = dynamic_cast<DcoSolution*>
+      (broker()->getBestKnowledge(AlpsKnowledgeTypeSolution).first);
+    if (inc) {
+      incumbent = inc->getValues();
+    }
+  }
+  worker->post(model->solver()->getColLower(),
+               model->solver()->getColUpper(),
+               model->solver()->getColSolution(),
+               broker()->getIncumbentValue(),
+               incumbent);
+}
+
+void DcoTreeNode::callHeuristicsBeforeRoot() {
+  DcoModel * model = dynamic_cast<DcoModel*>(broker()->getModel());
+  CoinMessageHandler * message_handler = model->dcoMessageHandler_;
+  CoinMessages * messages = model->dcoMessages_;
+  long unsigned int num_heur = model->numHeuristics();
+  for (long unsigned int i=0; i<num_heur; ++i) {
+    DcoHeuristic * curr = model->heuristics(i);
+    if (curr->strategy()!=DcoHeurStrategyBeforeRoot) {
+      continue;
+    }
+    DcoSolution * sol = curr->searchSolution();
+    if (sol && !model->sosFeasible(sol->getValues())) {
+      delete sol;
+      sol = NULL;
+    }
+    if (sol==NULL) {
+      message_handler->message(DISCO_HEUR_NOSOL_FOUND, *messages)
+        << broker()->getProcRank()
+        << curr->name()
+        << CoinMessageEol;
+      continue;
+    }
+    double quality = sol->getQuality();
+    // keep a copy in the solution pool, broker may delete sol
+    model->solutionPool()->add(sol, broker()->getNumNodesProcessed());
+    // Store in Alps pool
+    broker()->addKnowledge(AlpsKnowledgeTypeSolution, sol,
+                           model->objSense() * quality);
+    double incum_value = broker()->getIncumbentValue();
+    model->solver()->setDblParam(OsiDualObjectiveLimit,
+                                 model->objSense()*incum_value);
+    message_handler->message(DISCO_HEUR_BEFORE_ROOT, *messages)
+      << curr->name()
+      << quality
+      << CoinMessageEol;
+  }
+}
+
 /// Bounding procedure to estimate quality of this node.
 BcpsSubproblemStatus DcoTreeNode::bound() {
   BcpsSubproblemStatus subproblem_status;
@@ -707,7 +1003,10 @@ BcpsSubproblemStatus DcoTreeNode::bound() {
       << static_cast<int>(node_status) << CoinMessageEol;
   }
   // solve problem loaded to the solver
+  double start_time = CoinWallclockTime();
   model->solver()->resolve();
+  model->processStats()->addRelaxTime(CoinWallclockTime()-start_time);
+  model->addNumRelaxIterations(model->solver()->getIterationCount());
   if (model->solver()->isAbandoned()) {
     subproblem_status = BcpsSubproblemStatusAbandoned;
   }
@@ -730,14 +1029,17 @@ BcpsSubproblemStatus DcoTreeNode::bound() {
       // when a node is created. The objValuexobjSense here might be larger
       // than the quality_ since not all conic cuts present in parent node is
       // present here.
+      // quality_ of a child might be an estimate given by the parent (see
+      // branch()), use the parent's quality_ as the bound instead.
       if (parent_==NULL) {
         // this is root node, update quality
         quality_ = new_quality;
       }
-      else if (new_quality>quality_) {
-        quality_ = new_quality;
-        solEstimate_ = new_quality;
+      else {
+        quality_ = std::max(new_quality, parent_->getQuality());
       }
+      // solution estimate is updated once branching candidates are scored.
+      solEstimate_ = quality_;
     }
   }
   else if (model->solver()->isProvenPrimalInfeasible()) {
@@ -862,6 +1164,8 @@ int DcoTreeNode::installSubProblem() {
   //------------------------------------------------------
   int numOldRows = 0;
   std::vector<DcoConstraint*> old_cons;
+  // rows created by branching on disjunctions, valid for the subtree.
+  std::vector<DcoLinearConstraint const *> branch_cons;
   for(int i = static_cast<int> (leafToRootPath.size() - 1); i > -1; --i) {
     //--------------------------------------------------
     // NOTE: As away from explicit node, bounds become
@@ -908,6 +1212,12 @@ int DcoTreeNode::installSubProblem() {
       colUB[index] = CoinMin(colUB[index], value);
     }
     //--------------------------------------------------
+    // Collect branching constraints.
+    //--------------------------------------------------
+    for (int k=0; k<currDesc->numBranchCons(); ++k) {
+      branch_cons.push_back(currDesc->branchCon(k));
+    }
+    //--------------------------------------------------
     // TODO: Modify hard/soft row lb/ub.
     //--------------------------------------------------
     //--------------------------------------------------
@@ -995,6 +1305,21 @@ int DcoTreeNode::installSubProblem() {
     oldOsiCuts = NULL;
   }
   old_cons.clear();
+  // Add branching constraints of this node and its ancestors.
+  int numBranchRows = static_cast<int>(branch_cons.size());
+  if (numBranchRows > 0) {
+    const OsiRowCut ** branchOsiCuts = new const OsiRowCut * [numBranchRows];
+    for (int k=0; k<numBranchRows; ++k) {
+      branchOsiCuts[k] = branch_cons[k]->createOsiRowCut(model);
+    }
+    model->solver()->applyRowCuts(numBranchRows, branchOsiCuts);
+    for (int k=0; k<numBranchRows; ++k) {
+      delete branchOsiCuts[k];
+    }
+    delete [] branchOsiCuts;
+    branchOsiCuts = NULL;
+  }
+  branch_cons.clear();
   //  End of 5
 
 
@@ -1007,9 +1332,20 @@ int DcoTreeNode::installSubProblem() {
   //--------------------------------------------------------
   // Set basis
   //--------------------------------------------------------
+  numInstalledRows_ = model->solver()->getNumRows();
   CoinWarmStartBasis *pws = desc->getBasis();
   if (pws != NULL) {
-    model->solver()->setWarmStart(pws);
+    // basis of the parent covers core rows, old cuts and the branching rows
+    // of the ancestors, in the order they are added above (see
+    // processSetPregnant()). The branching rows of this node come last, mark
+    // them basic.
+    CoinWarmStartBasis ws(*pws);
+    int num_basis_rows = ws.getNumArtificial();
+    ws.resize(numInstalledRows_, model->solver()->getNumCols());
+    for (int k=num_basis_rows; k<numInstalledRows_; ++k) {
+      ws.setArtifStatus(k, CoinWarmStartBasis::basic);
+    }
+    model->solver()->setWarmStart(&ws);
   }
   return status;
   //  End of 7
@@ -1034,6 +1370,9 @@ DcoTreeNode::branch() {
         << static_cast<int>(getStatus()) << CoinMessageEol;
   }
 
+  // children start from the basis of this node, read it back if spilled
+  model->nodeSpill()->restore(getDesc());
+
   // create return value and push the down and up nodes.
   std::vector< CoinTriple<AlpsNodeDesc*, AlpsNodeStatus, double> > res;
 
@@ -1055,6 +1394,13 @@ DcoTreeNode::branch() {
     setStatus(AlpsNodeStatusFathomed);
     return res;
   }
+
+  // restart, open nodes of the checkpoint are the children of the root
+  if (getParent()==NULL and model->checkpoint()->numRestartNodes()>0) {
+    model->checkpoint()->restartNodes(res, quality_);
+    setStatus(AlpsNodeStatusBranched);
+    return res;
+  }
   //todo(aykut) update scores
   //BcpsBranchStrategy * branchStrategy = model->branchStrategy();
 
@@ -1062,22 +1408,12 @@ DcoTreeNode::branch() {
   AlpsPhase phase = broker()->getPhase();
 
   // get branch object
-  DcoBranchObject const * branch_object =
-    dynamic_cast<DcoBranchObject const *>(branchObject());
-
-  assert(branch_object);
-  // get index and value of branch variable.
-  //int branch_var = model->relaxedCols()[branch_object->getObjectIndex()];
-  int branch_var = branch_object->index();
-  double branch_value = branch_object->value();
-
-  message_handler->message(DISCO_NODE_BRANCH, *messages)
-    << broker()->getProcRank()
-    << index_
-    << branch_var
-    << branch_value
-    << branch_object->score()
-    << CoinMessageEol;
+  BcpsBranchObject const * bobject = branchObject();
+  assert(bobject);
+  int bobject_type = bobject->getType();
+  // value of the branching object, for variables it is the value of the
+  // variable.
+  double branch_value = bobject->value();
 
   // compute child nodes' warm start basis
   CoinWarmStartBasis * child_ws;
@@ -1091,57 +1427,142 @@ DcoTreeNode::branch() {
   up_node->setBroker(broker_);
   if (phase == AlpsPhaseRampup) {
     // Store a full description in the child nodes
-
-    // Down Node
-    // == copy description of this node to the down node
+    // == copy description of this node to the down and up nodes
     copyFullNode(down_node);
-    // == update the branching variable hard bounds for the down node
-    // todo(aykut) do we need lower bound for the down node?
-    // down_node->vars_->lbHard.entries[branch_var] =
-    //   model->getColLower()[branch_var];
-    down_node->vars()->ubHard.entries[branch_var] =
-      branch_object->ubDownBranch();
-
-    // Up Node
-    // == copy description of this node to up node
     copyFullNode(up_node);
-    // == update the branching variable hard bounds for the up node
-    // todo(aykut) do we need upper bound for the up node?
-    up_node->vars()->lbHard.entries[branch_var] =
-      branch_object->lbUpBranch();
-    // up_node->vars_->ubHard.entries[branch_var] =
-    //   model->getColUpper()[branch_var];
+  }
+
+  // estimated objective changes of children, variable branch objects only.
+  double down_change = 0.0;
+  double up_change = 0.0;
+  // index of the branching variable, -1 for other branch objects.
+  int branch_var = -1;
+
+  if (bobject_type==DcoBranchingObjectTypeSos) {
+    DcoSosBranchObject const * sos_object =
+      dynamic_cast<DcoSosBranchObject const *>(bobject);
+    message_handler->message(DISCO_NODE_BRANCH_SOS, *messages)
+      << broker()->getProcRank()
+      << index_
+      << sos_object->index()
+      << sos_object->separator()
+      << CoinMessageEol;
+    // fix members to 0 in both branches
+    int const * members = model->sosMembers() +
+      model->sosStart()[sos_object->index()];
+    int first[2];
+    int last[2];
+    sos_object->downFixed(model, first[0], last[0]);
+    sos_object->upFixed(model, first[1], last[1]);
+    DcoNodeDesc * children[2] = {down_node, up_node};
+    for (int c=0; c<2; ++c) {
+      int num_fixed = last[c]-first[c];
+      int * ind = new int[num_fixed];
+      double * lb = new double[num_fixed];
+      double * ub = new double[num_fixed];
+      for (int k=0; k<num_fixed; ++k) {
+        int col = members[first[c]+k];
+        ind[k] = col;
+        if (phase == AlpsPhaseRampup) {
+          // full description, entries are indexed by columns
+          lb[k] = std::max(children[c]->vars()->lbHard.entries[col], 0.0);
+          ub[k] = std::min(children[c]->vars()->ubHard.entries[col], 0.0);
+          children[c]->vars()->lbHard.entries[col] = lb[k];
+          children[c]->vars()->ubHard.entries[col] = ub[k];
+        }
+        else {
+          lb[k] = std::max(model->getVariables()[col]->getLbHard(), 0.0);
+          ub[k] = std::min(model->getVariables()[col]->getUbHard(), 0.0);
+        }
+      }
+      if (phase != AlpsPhaseRampup) {
+        children[c]->setVarHardBound(num_fixed, ind, lb,
+                                     num_fixed, ind, ub);
+      }
+      delete[] ind;
+      delete[] lb;
+      delete[] ub;
+    }
+  }
+  else if (bobject_type==DcoBranchingObjectTypeDisjunction) {
+    DcoDisjunctionBranchObject const * dis_object =
+      dynamic_cast<DcoDisjunctionBranchObject const *>(bobject);
+    message_handler->message(DISCO_NODE_BRANCH_DISJUNCTION, *messages)
+      << broker()->getProcRank()
+      << index_
+      << dis_object->index()
+      << branch_value
+      << CoinMessageEol;
+    // add rows of the disjunction to children
+    down_node->addBranchCon(dis_object->createDownRow());
+    up_node->addBranchCon(dis_object->createUpRow());
   }
   else {
-    // Store node description relative to the parent.
-    // We need to add a hard bound for the branching variable.
-
-    double ub_down_branch = branch_object->ubDownBranch();
-    double lb_up_branch = branch_object->lbUpBranch();
-    // todo(aykut) where does colLB and colUB get updated?
-    // I think they should stay as they created.
-    //double lb = model->colLB()[branch_var];
-    //double ub = model->colUB()[branch_var];
-    double lb = model->getVariables()[branch_var]->getLbHard();
-    double ub = model->getVariables()[branch_var]->getUbHard();
-    down_node->setVarHardBound(1,
-                             &branch_var,
-                             &lb,
-                             1,
-                             &branch_var,
-                             &ub_down_branch);
-    up_node->setVarHardBound(1,
-                             &branch_var,
-                             &lb_up_branch,
-                             1,
-                             &branch_var,
-                             &ub);
+    DcoBranchObject const * branch_object =
+      dynamic_cast<DcoBranchObject const *>(bobject);
+    assert(branch_object);
+    // get index and value of branch variable.
+    //int branch_var = model->relaxedCols()[branch_object->getObjectIndex()];
+    branch_var = branch_object->index();
+    down_change = branch_object->downEstimate();
+    up_change = branch_object->upEstimate();
+
+    message_handler->message(DISCO_NODE_BRANCH, *messages)
+      << broker()->getProcRank()
+      << index_
+      << branch_var
+      << branch_value
+      << branch_object->score()
+      << CoinMessageEol;
+
+    if (phase == AlpsPhaseRampup) {
+      // Down Node
+      // == update the branching variable hard bounds for the down node
+      // todo(aykut) do we need lower bound for the down node?
+      // down_node->vars_->lbHard.entries[branch_var] =
+      //   model->getColLower()[branch_var];
+      down_node->vars()->ubHard.entries[branch_var] =
+        branch_object->ubDownBranch();
+
+      // Up Node
+      // == update the branching variable hard bounds for the up node
+      // todo(aykut) do we need upper bound for the up node?
+      up_node->vars()->lbHard.entries[branch_var] =
+        branch_object->lbUpBranch();
+      // up_node->vars_->ubHard.entries[branch_var] =
+      //   model->getColUpper()[branch_var];
+    }
+    else {
+      // Store node description relative to the parent.
+      // We need to add a hard bound for the branching variable.
+
+      double ub_down_branch = branch_object->ubDownBranch();
+      double lb_up_branch = branch_object->lbUpBranch();
+      // todo(aykut) where does colLB and colUB get updated?
+      // I think they should stay as they created.
+      //double lb = model->colLB()[branch_var];
+      //double ub = model->colUB()[branch_var];
+      double lb = model->getVariables()[branch_var]->getLbHard();
+      double ub = model->getVariables()[branch_var]->getUbHard();
+      down_node->setVarHardBound(1,
+                                 &branch_var,
+                                 &lb,
+                                 1,
+                                 &branch_var,
+                                 &ub_down_branch);
+      up_node->setVarHardBound(1,
+                               &branch_var,
+                               &lb_up_branch,
+                               1,
+                               &branch_var,
+                               &ub);
+    }
   }
 
   // Down Node
   // == set other relevant fields of down node
   down_node->setBranchedDir(DcoNodeBranchDirectionDown);
-  down_node->setBranchedInd(branch_object->index());
+  down_node->setBranchedInd(branch_var);
   down_node->setBranchedVal(branch_value);
   // == set warm start basis for the down node.
 #if defined(__OA__) || defined(__COLA__)
@@ -1150,7 +1571,7 @@ DcoTreeNode::branch() {
   // Up Node
   // == set other relevant fields of up node
   up_node->setBranchedDir(DcoNodeBranchDirectionUp);
-  up_node->setBranchedInd(branch_object->index());
+  up_node->setBranchedInd(branch_var);
   up_node->setBranchedVal(branch_value);
   // == set warm start basis for the up node.
 #if defined(__OA__) || defined(__COLA__)
@@ -1159,6 +1580,20 @@ DcoTreeNode::branch() {
   // Alps does this. We do not need to change the status here
   //status_ = AlpsNodeStatusBranched;
 
+  // Estimate solution values of children. Branching strategies that keep
+  // branching history store estimated objective changes in the branch
+  // object, they are 0.0 otherwise. An estimate is not a valid bound, Alps
+  // uses quality for pruning and for the global bound. Children get the
+  // bound of this node as quality, estimates go to their solEstimate.
+  // solEstimate_ includes the smaller change of the branching variable,
+  // replace it with the change in the corresponding direction.
+  double rest_estimate = std::max(solEstimate_, quality_)
+    - std::min(down_change, up_change);
+  down_node->setSolEstimate(std::max(quality_ + down_change,
+                                     rest_estimate + down_change));
+  up_node->setSolEstimate(std::max(quality_ + up_change,
+                                   rest_estimate + up_change));
+
   // push the down and up nodes.
   res.push_back(CoinMakeTriple(static_cast<AlpsNodeDesc*>(down_node),
                                AlpsNodeStatusCandidate,
@@ -1167,30 +1602,9 @@ DcoTreeNode::branch() {
                                AlpsNodeStatusCandidate,
                                quality_));
   // grumpy message
-  int num_inf = 0;
-  double sum_inf = 0.0;
-  for (int i=0; i<model->branchStrategy()->numBranchObjects(); ++i) {
-    double value = model->branchStrategy()->branchObjects()[i]->value();
-    // get integer tolerance parameter
-    double tolerance = model->dcoPar()->entry(DcoParams::integerTol);
-    double dist_to_upper = ceil(value) - value;
-    double dist_to_lower = value - floor(value);
-    // return the minimum of distance to upper or lower
-    double infeas;
-    if (dist_to_upper>dist_to_lower) {
-      infeas = dist_to_lower;
-    }
-    else {
-      infeas = dist_to_upper;
-    }
-    if (infeas<tolerance) {
-      infeas = 0.0;
-    }
-    else {
-      num_inf++;
-    }
-    sum_inf += infeas;
-  }
+  int num_inf;
+  double sum_inf;
+  grumpyInfeasibility(sum_inf, num_inf);
   message_handler->message(DISCO_GRUMPY_MESSAGE_LONG, *messages)
     << broker()->getProcRank()
     << broker()->timer().getTime()
@@ -1205,10 +1619,6 @@ DcoTreeNode::branch() {
   // end of grumpy message
 
   setStatus(AlpsNodeStatusBranched);
-
-  // todo(aykut) are these should be in alps level?
-  //up_node->setSolEstimate(quality_);
-  //down_node->setSolEstimate(quality_);
   return res;
 }
 
@@ -1292,6 +1702,12 @@ void DcoTreeNode::copyFullNode(DcoNodeDesc * child_node) const {
                                  su_num_modify,
                                  bound.upper.ind,
                                  bound.upper.val);
+
+  // Branching constraints.
+  for (int k=0; k<node_desc->numBranchCons(); ++k) {
+    child_node->addBranchCon(new DcoLinearConstraint(
+                               *node_desc->branchCon(k)));
+  }
 }
 
 
@@ -1299,6 +1715,106 @@ DcoNodeDesc * DcoTreeNode::getDesc() const {
   return dynamic_cast<DcoNodeDesc*>(AlpsTreeNode::getDesc());
 }
 
+DcoNodeDesc * DcoTreeNode::createCheckpointDesc() const {
+  DcoModel * model = dynamic_cast<DcoModel*>(broker_->getModel());
+  std::vector<BcpsVariable*> & cols = model->getVariables();
+  int num_cols = model->getNumCoreVariables();
+  std::vector<double> col_lb(num_cols, -ALPS_DBL_MAX);
+  std::vector<double> col_ub(num_cols, ALPS_DBL_MAX);
+  DcoNodeDesc * desc = new DcoNodeDesc(model);
+  desc->setBroker(broker_);
+  std::vector<DcoLinearConstraint*> rows;
+  std::vector<BcpsObject*> cuts;
+  collectPath(col_lb, col_ub, rows, &cuts);
+  for (long unsigned int k=0; k<rows.size(); ++k) {
+    desc->addBranchCon(rows[k]);
+  }
+  // keep bounds tighter than the root bounds.
+  std::vector<int> lb_ind;
+  std::vector<double> lb_val;
+  std::vector<int> ub_ind;
+  std::vector<double> ub_val;
+  for (int i=0; i<num_cols; ++i) {
+    if (col_lb[i] > cols[i]->getLbHard()) {
+      lb_ind.push_back(i);
+      lb_val.push_back(col_lb[i]);
+    }
+    if (col_ub[i] < cols[i]->getUbHard()) {
+      ub_ind.push_back(i);
+      ub_val.push_back(col_ub[i]);
+    }
+  }
+  desc->setVarHardBound(static_cast<int>(lb_ind.size()),
+                        lb_ind.empty() ? NULL : &lb_ind[0],
+                        lb_val.empty() ? NULL : &lb_val[0],
+                        static_cast<int>(ub_ind.size()),
+                        ub_ind.empty() ? NULL : &ub_ind[0],
+                        ub_val.empty() ? NULL : &ub_val[0]);
+  int num_cuts = static_cast<int>(cuts.size());
+  BcpsObject ** cut_objects = new BcpsObject*[num_cuts];
+  std::copy(cuts.begin(), cuts.end(), cut_objects);
+  int * no_pos = NULL;
+  double * no_values = NULL;
+  desc->assignCons(0, no_pos,
+                   num_cuts, cut_objects,
+                   true, 0, no_pos, no_values,
+                   true, 0, no_pos, no_values,
+                   true, 0, no_pos, no_values,
+                   true, 0, no_pos, no_values);
+  desc->setSolEstimate(getSolEstimate());
+  return desc;
+}
+
+void DcoTreeNode::collectPath(std::vector<double> & col_lb,
+                              std::vector<double> & col_ub,
+                              std::vector<DcoLinearConstraint*> & rows,
+                              std::vector<BcpsObject*> * cuts) const {
+  DcoModel * model = dynamic_cast<DcoModel*>(broker_->getModel());
+  // travel back to the explicit node, as installSubProblem() does.
+  AlpsTreeNode const * node = this;
+  while (node) {
+    DcoNodeDesc * curr = dynamic_cast<DcoNodeDesc*>(node->getDesc());
+    // description of a spilled node is on disk.
+    DcoNodeDesc * spilled = NULL;
+    if (curr->spillPos()>=0) {
+      spilled = model->nodeSpill()->read(curr);
+    }
+    DcoNodeDesc const * desc = spilled ? spilled : curr;
+    BcpsFieldListMod<double> const * lower[2] = {&desc->getVars()->lbHard,
+                                                 &desc->getVars()->lbSoft};
+    BcpsFieldListMod<double> const * upper[2] = {&desc->getVars()->ubHard,
+                                                 &desc->getVars()->ubSoft};
+    for (int m=0; m<2; ++m) {
+      for (int k=0; k<lower[m]->numModify; ++k) {
+        int index = lower[m]->posModify[k];
+        col_lb[index] = CoinMax(col_lb[index], lower[m]->entries[k]);
+      }
+      for (int k=0; k<upper[m]->numModify; ++k) {
+        int index = upper[m]->posModify[k];
+        col_ub[index] = CoinMin(col_ub[index], upper[m]->entries[k]);
+      }
+    }
+    for (int k=0; k<desc->numBranchCons(); ++k) {
+      rows.push_back(new DcoLinearConstraint(*desc->branchCon(k)));
+    }
+    // root cuts are generated again when the root is processed.
+    if (cuts and node->getParent()) {
+      for (int k=0; k<desc->getCons()->numAdd; ++k) {
+        DcoLinearConstraint const * cut = dynamic_cast<DcoLinearConstraint*>
+          (desc->getCons()->objects[k]);
+        if (cut) {
+          cuts->push_back(new DcoLinearConstraint(*cut));
+        }
+      }
+    }
+    delete spilled;
+    if (node->getExplicit()) {
+      break;
+    }
+    node = node->getParent();
+  }
+}
+
 void DcoTreeNode::processSetPregnant() {
   // get warm start basis from solver
   // todo(aykut) This does not help much if the underlying solver is an IPM
@@ -1308,36 +1824,21 @@ void DcoTreeNode::processSetPregnant() {
   if (model->solver()->getWarmStart()!=NULL) {
     ws = dynamic_cast<CoinWarmStartBasis*>(model->solver()->getWarmStart());
   }
+  // children do not inherit the cuts generated at this node, drop their
+  // rows so that the basis matches the rows installSubProblem() adds before
+  // the branching rows of the children.
+  if (ws && ws->getNumArtificial() > numInstalledRows_) {
+    ws->resize(numInstalledRows_, model->solver()->getNumCols());
+  }
   // store basis in the node desciption.
   getDesc()->setBasis(ws);
   // set status pregnant
   setStatus(AlpsNodeStatusPregnant);
 
   // grumpy message
-  double sum_inf = 0.0;
-  int num_inf = 0;
-  for (int i=0; i<model->branchStrategy()->numBranchObjects(); ++i) {
-    double value = model->branchStrategy()->branchObjects()[i]->value();
-    // get integer tolerance parameter
-    double tolerance = model->dcoPar()->entry(DcoParams::integerTol);
-    double dist_to_upper = ceil(value) - value;
-    double dist_to_lower = value - floor(value);
-    // return the minimum of distance to upper or lower
-    double infeas;
-    if (dist_to_upper>dist_to_lower) {
-      infeas = dist_to_lower;
-    }
-    else {
-      infeas = dist_to_upper;
-    }
-    if (infeas<tolerance) {
-      infeas = 0.0;
-    }
-    else {
-      num_inf++;
-    }
-    sum_inf += infeas;
-  }
+  double sum_inf;
+  int num_inf;
+  grumpyInfeasibility(sum_inf, num_inf);
   model->dcoMessageHandler_->message(DISCO_GRUMPY_MESSAGE_LONG, *model->dcoMessages_)
     << broker()->getProcRank()
     << broker()->timer().getTime()
@@ -1523,6 +2024,8 @@ void DcoTreeNode::branchConstrainOrPrice(BcpsSubproblemStatus subproblem_status,
     //in Alps level.
     sol->setIndex(broker()->getNumKnowledges(AlpsKnowledgeTypeSolution));
 
+    // keep a copy in the solution pool, broker may delete sol
+    model->solutionPool()->add(sol, broker()->getNumNodesProcessed());
     // Store in Alps pool
     broker()->addKnowledge(AlpsKnowledgeTypeSolution,
                            sol,
@@ -1753,10 +2256,25 @@ AlpsReturnStatus DcoTreeNode::encode(AlpsEncoded * encoded) const {
 
   // return value
   AlpsReturnStatus status;
+  int start_size = encoded->size();
+  // nodes sent to other processes take their spilled parts with them
+  model->nodeSpill()->restore(getDesc());
   status = AlpsTreeNode::encode(encoded);
   assert(status==AlpsReturnStatusOk);
-  status = BcpsTreeNode::encode(encoded);
-  assert(status==AlpsReturnStatusOk);
+  // The only field of the Bcps part is the branch object and it does not
+  // keep its type, BcpsTreeNode::encode() is not called. Write the type
+  // and the branch object of a pregnant node instead. The receiving process
+  // branches the node without solving it again. LP bound of the node is
+  // quality_.
+  int bobject_type = DcoBranchingObjectTypeNone;
+  if (isPregnant() and branchObject()) {
+    bobject_type = branchObject()->getType();
+  }
+  encoded->writeRep(bobject_type);
+  if (bobject_type!=DcoBranchingObjectTypeNone) {
+    branchObject()->encode(encoded);
+  }
+  model->addEncodedNode(getExplicit()!=0, encoded->size()-start_size);
 
   message_handler->message(DISCO_NODE_ENCODED, *messages)
     << broker()->getProcRank()
@@ -1773,7 +2291,9 @@ AlpsKnowledge * DcoTreeNode::decode(AlpsEncoded & encoded) const {
   // todo(aykut) we are decoing, how do we know the model to assign the new
   // node is same as the model_ of this? Is this due to fact that they are in
   // the same processor?
-  AlpsNodeDesc * new_node_desc = new DcoNodeDesc();
+  // descriptions need the model for root bounds when decoded.
+  DcoModel * model = dynamic_cast<DcoModel*>(broker_->getModel());
+  AlpsNodeDesc * new_node_desc = new DcoNodeDesc(model);
   DcoTreeNode * new_node = new DcoTreeNode(new_node_desc);
   new_node->setBroker(broker_);
   new_node_desc = NULL;
@@ -1794,19 +2314,46 @@ AlpsReturnStatus DcoTreeNode::decodeToSelf(AlpsEncoded & encoded) {
   AlpsReturnStatus status;
   status = AlpsTreeNode::decodeToSelf(encoded);
   assert(status==AlpsReturnStatusOk);
-  status = BcpsTreeNode::decodeToSelf(encoded);
-  assert(status==AlpsReturnStatusOk);
 
   message_handler->message(DISCO_NODE_DECODED, *messages)
     << broker()->getProcRank()
     << getIndex()
     << CoinMessageEol;
 
+  // Bcps part is written by encode(), the branch object with its type.
+  int bobject_type;
+  encoded.readRep(bobject_type);
+  AlpsKnowledge * bobject = NULL;
+  switch (bobject_type) {
+  case DcoBranchingObjectTypeNone:
+    break;
+  case DcoBranchingObjectTypeInt:
+    bobject = DcoBranchObject(-1, 0.0, 0.0).decode(encoded);
+    break;
+  case DcoBranchingObjectTypeSos:
+    bobject = DcoSosBranchObject(-1, -1, 0.0, 0.0).decode(encoded);
+    break;
+  case DcoBranchingObjectTypeDisjunction:
+    bobject = DcoDisjunctionBranchObject(-1, 0, NULL, NULL, 0.0, 0.0)
+      .decode(encoded);
+    break;
+  default:
+    message_handler->message(DISCO_UNEXPECTED_DECODE_STATUS, *messages)
+      << __FILE__ << __LINE__ << CoinMessageEol;
+    status = AlpsReturnStatusErr;
+    break;
+  }
   if (isPregnant()) {
-    // delete branch object stored, we will re-create it. Ideally it should not
-    // be sent in the first place.
     clearBranchObject();
-    setStatus(AlpsNodeStatusEvaluated);
+    if (bobject) {
+      // branch right away, no need to solve the node again.
+      setBranchObject(dynamic_cast<BcpsBranchObject*>(bobject));
+      bobject = NULL;
+    }
+    else {
+      setStatus(AlpsNodeStatusEvaluated);
+    }
   }
+  delete bobject;
   return status;
 }
@@ -221,6 +221,13 @@ class DcoTreeNode: public BcpsTreeNode {
     double startObjVal_;
   };
   BcpStats bcpStats_;
+  /// Node is given to another thread of the threaded search (see
+  /// DcoThreadSearch), it is fathomed when it is taken from the pool.
+  bool donated_;
+  /// Number of solver rows after installSubProblem(), i.e. core rows, old
+  /// cuts and branching rows. Rows after them are cuts generated at this
+  /// node.
+  int numInstalledRows_;
   /// Decide whether the given cut generator should be used, based on the cut
   /// strategy.
   void decide_using_cg(bool & do_use, DcoConGenerator const * cg) const;
@@ -235,6 +242,15 @@ class DcoTreeNode: public BcpsTreeNode {
   int boundingLoop(bool isRoot, bool rampUp);
   /// find number of infeasible integer variables.
   void checkRelaxedCols(int & numInf);
+  /// Sum and number of fractional integer columns of the solver solution
+  /// for grumpy messages. Both are 0 if grumpy messages are not logged.
+  void grumpyInfeasibility(double & sum_inf, int & num_inf) const;
+  /// Create a branch object for the most infeasible SOS set. Returns false if
+  /// all sets are feasible.
+  bool chooseSosBranchObject();
+  /// Create a branch object for the split disjunction of the most fractional
+  /// integral row. Returns false if there is no such row.
+  bool chooseDisjunctionBranchObject();
 public:
   ///@name Constructors and Destructors
   //@{
@@ -272,7 +288,8 @@ public:
   /// Generate variables (lift the problem) and store them in the given
   /// variable pool.
   virtual int generateVariables(BcpsVariablePool * varPool);
-  /// Choose a branching object.
+  /// Choose a branching object. Infeasible SOS sets are branched first, then
+  /// split disjunctions if enabled, then variables using the branch strategy.
   virtual int chooseBranchingObject();
   /// Install subproblem corresponding to this node to the solver.
   virtual int installSubProblem();
@@ -287,6 +304,12 @@ public:
   virtual BcpsSubproblemStatus bound();
   /// Call heuristics to search for solutions.
   virtual void callHeuristics();
+  /// Call heuristics with DcoHeurStrategyBeforeRoot strategy. These are
+  /// called once, before the root relaxation is solved.
+  void callHeuristicsBeforeRoot();
+  /// Store solutions found by the heuristic thread and post the node
+  /// solution to it. Does not wait for the thread, see DcoHeurWorker.
+  void exchangeHeurWorker();
   /// Apply given constraints
   virtual void applyConstraints(BcpsConstraintPool const * conPool);
   //@}
@@ -295,15 +318,35 @@ public:
   //@{
   /// Get node description. Overwrites the one inherited from AlpsTreeNode.
   DcoNodeDesc * getDesc() const;
+  /// Create a description of this node relative to the root, used by
+  /// checkpoints (see DcoCheckpoint). Column bounds of the path to the root
+  /// are collected to hard bounds, cuts of the path (except the root cuts)
+  /// and rows created by branching are copied. Caller owns the description.
+  DcoNodeDesc * createCheckpointDesc() const;
+  /// Collect column bounds and rows of the path to the explicit ancestor, as
+  /// installSubProblem() does. Bounds of the path are intersected with
+  /// col_lb and col_ub. Copies of rows created by branching are added to
+  /// rows and copies of cuts (except the root cuts) to cuts if it is not
+  /// NULL. Caller owns the copies.
+  void collectPath(std::vector<double> & col_lb,
+                   std::vector<double> & col_ub,
+                   std::vector<DcoLinearConstraint*> & rows,
+                   std::vector<BcpsObject*> * cuts) const;
+  /// Mark this as given to another thread, see DcoThreadSearch.
+  void setDonated() { donated_ = true; }
+  /// True if this is given to another thread.
+  bool donated() const { return donated_; }
   //@}
 
   ///@name Encode and Decode functions for parallel execution
   //@{
   /// Get encode from #AlpsKnowledge
   using AlpsKnowledge::encode;
-  /// Pack this into an encoded object.
+  /// Pack this into an encoded object. Pregnant nodes keep their branch
+  /// object.
   virtual AlpsReturnStatus encode(AlpsEncoded * encoded) const;
-  /// Unpack into this from an encoded object.
+  /// Unpack into this from an encoded object. Pregnant nodes are branched
+  /// without solving them again.
   virtual AlpsReturnStatus decodeToSelf(AlpsEncoded & encoded);
   /// Unpack into a new DcoTreeNode object and return a
   /// pointer to it.
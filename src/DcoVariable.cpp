@@ -1,6 +1,7 @@
 #include "DcoVariable.hpp"
 #include "DcoModel.hpp"
 #include "DcoBranchObject.hpp"
+#include "DcoEncoding.hpp"
 
 #include <cmath>
 
@@ -97,33 +98,27 @@ BcpsBranchObject * DcoVariable::createBranchObject(BcpsModel * bcps_model,
 
 /// Encode this to an AlpsEncoded object.
 AlpsReturnStatus DcoVariable::encode(AlpsEncoded * encoded) const {
-  std::cerr << "Not implemented, "
-            << "file: " <<  __FILE__
-            << "line: " << __LINE__
-            << std::endl;
-  throw std::exception();
-  return AlpsReturnStatusOk;
+  DcoEncodeTag(encoded, DcoEncodedTagVariable);
+  // column data is kept in DcoModel, bounds and index are in Bcps part.
+  return encodeBcpsObject(encoded);
 }
 
 /// Decode a given AlpsEncoded object to a new DcoVariable object and return
 /// a pointer to it.
 AlpsKnowledge * DcoVariable::decode(AlpsEncoded & encoded) const {
-  std::cerr << "Not implemented, "
-            << "file: " <<  __FILE__
-            << "line: " << __LINE__
-            << std::endl;
-  throw std::exception();
   DcoVariable * new_var = new DcoVariable();
+  AlpsReturnStatus status = new_var->decodeToSelf(encoded);
+  if (status!=AlpsReturnStatusOk) {
+    delete new_var;
+    return NULL;
+  }
   return new_var;
 }
 
 /// Decode a given AlpsEncoded object into self.
 AlpsReturnStatus DcoVariable::decodeToSelf(AlpsEncoded & encoded) {
-  AlpsReturnStatus status = AlpsReturnStatusOk;
-  std::cerr << "Not implemented, "
-            << "file: " <<  __FILE__
-            << "line: " << __LINE__
-            << std::endl;
-  throw std::exception();
-  return status;
+  if (!DcoDecodeTag(encoded, DcoEncodedTagVariable)) {
+    return AlpsReturnStatusErr;
+  }
+  return decodeBcpsObject(encoded);
 }
@@ -0,0 +1,149 @@
+/*
+  Round trip test of the compact encoding of DisCO objects (see
+  DcoEncoding.hpp). Each object type is encoded, decoded into a new object
+  and every field of the two objects is compared. Returns the number of
+  failed checks.
+*/
+
+#include <AlpsEncoded.h>
+
+#include "DcoVariable.hpp"
+#include "DcoLinearConstraint.hpp"
+#include "DcoConicConstraint.hpp"
+
+#include <iostream>
+#include <algorithm>
+#include <vector>
+
+static int num_failed = 0;
+
+static void check(bool passed, char const * object, char const * field) {
+  if (!passed) {
+    std::cerr << object << ": " << field << " differs after decoding."
+              << std::endl;
+    num_failed++;
+  }
+}
+
+// Compare fields written by encodeBcpsObject().
+static void checkBcpsObject(BcpsObject const & a, BcpsObject const & b,
+                            char const * object) {
+  check(a.getObjectIndex()==b.getObjectIndex(), object, "index");
+  check(a.getRepType()==b.getRepType(), object, "representation type");
+  check(a.getIntType()==b.getIntType(), object, "integrality type");
+  check(a.getValidRegion()==b.getValidRegion(), object, "valid region");
+  check(a.getStatus()==b.getStatus(), object, "status");
+  check(a.getLbHard()==b.getLbHard(), object, "hard lower bound");
+  check(a.getUbHard()==b.getUbHard(), object, "hard upper bound");
+  check(a.getLbSoft()==b.getLbSoft(), object, "soft lower bound");
+  check(a.getUbSoft()==b.getUbSoft(), object, "soft upper bound");
+}
+
+static void testVariable() {
+  DcoVariable var(17, -2.0, 40.0, -1.5, 39.5);
+  var.setIntType('I');
+  AlpsEncoded encoded(AlpsKnowledgeTypeNode);
+  var.encode(&encoded);
+  DcoVariable decoded;
+  check(decoded.decodeToSelf(encoded)==AlpsReturnStatusOk, "DcoVariable",
+        "decode status");
+  checkBcpsObject(var, decoded, "DcoVariable");
+}
+
+static void testLinearConstraint() {
+  // indices are unsorted and far apart, encode() sorts coefficients by
+  // index and delta codes indices.
+  int const size = 6;
+  int indices[size] = {1000000, 3, 0, 127, 128, 16384};
+  double values[size] = {1.5, -2.0, 1e-12, 3e+20, -0.25, 7.0};
+  DcoLinearConstraint con(size, indices, values, -1.0, 12.5);
+  con.setObjectIndex(42);
+  AlpsEncoded encoded(AlpsKnowledgeTypeNode);
+  con.encode(&encoded);
+  DcoLinearConstraint decoded;
+  check(decoded.decodeToSelf(encoded)==AlpsReturnStatusOk,
+        "DcoLinearConstraint", "decode status");
+  checkBcpsObject(con, decoded, "DcoLinearConstraint");
+  check(decoded.getSize()==size, "DcoLinearConstraint", "size");
+  if (decoded.getSize()!=size) {
+    return;
+  }
+  std::vector<std::pair<int, double> > expected(size);
+  std::vector<std::pair<int, double> > result(size);
+  for (int i=0; i<size; ++i) {
+    expected[i] = std::make_pair(indices[i], values[i]);
+    result[i] = std::make_pair(decoded.getIndices()[i],
+                               decoded.getValues()[i]);
+  }
+  std::sort(expected.begin(), expected.end());
+  check(expected==result, "DcoLinearConstraint", "coefficients");
+}
+
+static void testConicConstraint() {
+  // leading members are not the smallest, members are zigzag coded.
+  int const size = 5;
+  int members[size] = {90, 91, 4, 200000, 7};
+  DcoLorentzConeType types[2] = {DcoLorentzCone, DcoRotatedLorentzCone};
+  for (int t=0; t<2; ++t) {
+    DcoConicConstraint con(types[t], size, members);
+    con.setObjectIndex(3);
+    AlpsEncoded encoded(AlpsKnowledgeTypeNode);
+    con.encode(&encoded);
+    DcoConicConstraint decoded;
+    check(decoded.decodeToSelf(encoded)==AlpsReturnStatusOk,
+          "DcoConicConstraint", "decode status");
+    checkBcpsObject(con, decoded, "DcoConicConstraint");
+    check(decoded.coneType()==con.coneType(), "DcoConicConstraint",
+          "cone type");
+    check(decoded.coneSize()==size, "DcoConicConstraint", "size");
+    if (decoded.coneSize()==size) {
+      check(std::equal(members, members+size, decoded.coneMembers()),
+            "DcoConicConstraint", "members");
+    }
+    check(decoded.getNumSupports()==con.getNumSupports(),
+          "DcoConicConstraint", "number of supports");
+  }
+}
+
+static void testSequence() {
+  // objects written one after another are read back in order.
+  DcoVariable var(0, 0.0, 1.0, 0.0, 1.0);
+  int indices[2] = {5, 2};
+  double values[2] = {1.0, 1.0};
+  DcoLinearConstraint row(2, indices, values, 1.0, 1.0);
+  AlpsEncoded encoded(AlpsKnowledgeTypeNode);
+  var.encode(&encoded);
+  row.encode(&encoded);
+  var.encode(&encoded);
+  DcoVariable var1;
+  DcoLinearConstraint row1;
+  DcoVariable var2;
+  check(var1.decodeToSelf(encoded)==AlpsReturnStatusOk, "sequence",
+        "first variable");
+  check(row1.decodeToSelf(encoded)==AlpsReturnStatusOk, "sequence",
+        "row");
+  check(var2.decodeToSelf(encoded)==AlpsReturnStatusOk, "sequence",
+        "second variable");
+  checkBcpsObject(var, var2, "sequence");
+  check(row1.getSize()==2, "sequence", "row size");
+  // a tag of another type is rejected.
+  AlpsEncoded wrong(AlpsKnowledgeTypeNode);
+  var.encode(&wrong);
+  DcoLinearConstraint row2;
+  check(row2.decodeToSelf(wrong)!=AlpsReturnStatusOk, "sequence",
+        "tag check");
+}
+
+int main() {
+  testVariable();
+  testLinearConstraint();
+  testConicConstraint();
+  testSequence();
+  if (num_failed) {
+    std::cerr << num_failed << " checks failed." << std::endl;
+  }
+  else {
+    std::cout << "All encoding checks passed." << std::endl;
+  }
+  return num_failed;
+}